@@ -0,0 +1,126 @@
+#include "controllers/ignores/IgnoreEngine.hpp"
+#include "controllers/ignores/IgnorePhrase.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+using namespace chatterino;
+
+namespace {
+
+std::shared_ptr<const std::vector<IgnorePhrase>> makePhrases(bool block)
+{
+    auto phrases = std::make_shared<std::vector<IgnorePhrase>>();
+
+    for (int i = 0; i < 100; i++)
+    {
+        auto n = QString::number(i);
+        phrases->emplace_back("word" + n, false, block, "***", true);
+        phrases->emplace_back("Phrase " + n, false, block, "***", false);
+        phrases->emplace_back("\\bregex" + n + "\\w*", true, block, "***",
+                              false);
+    }
+    // Keeps its own expression because of the capture group
+    phrases->emplace_back("(cap)tured", true, block, "\\1", true);
+
+    return phrases;
+}
+
+const QStringList messages{
+    "this message doesn't contain anything that gets replaced, but it's "
+    "long enough to be searched for a while",
+    "word42 something phrase 7 and REGEX99foo in the middle of a message",
+    "captured captured captured word1 word2 word3 word4 word5",
+};
+
+// How messages were handled before the engine, one phrase at a time
+QString replaceNaive(const std::vector<IgnorePhrase> &phrases,
+                     QString message)
+{
+    for (const auto &phrase : phrases)
+    {
+        if (phrase.isRegex())
+        {
+            message.replace(phrase.getRegex(), phrase.getReplace());
+        }
+        else
+        {
+            message.replace(phrase.getPattern(), phrase.getReplace(),
+                            phrase.caseSensitivity());
+        }
+    }
+    return message;
+}
+
+}  // namespace
+
+static void BM_IgnoreEngineReplace(benchmark::State &state)
+{
+    IgnoreEngine engine(makePhrases(false));
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            auto result = engine.replace(message);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK(BM_IgnoreEngineReplace);
+
+static void BM_IgnoreNaiveReplace(benchmark::State &state)
+{
+    auto phrases = makePhrases(false);
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            auto result = replaceNaive(*phrases, message);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK(BM_IgnoreNaiveReplace);
+
+static void BM_IgnoreEngineFindBlock(benchmark::State &state)
+{
+    IgnoreEngine engine(makePhrases(true));
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            benchmark::DoNotOptimize(engine.findBlock(message));
+        }
+    }
+}
+
+BENCHMARK(BM_IgnoreEngineFindBlock);
+
+static void BM_IgnoreNaiveFindBlock(benchmark::State &state)
+{
+    auto phrases = makePhrases(true);
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            bool blocked = false;
+            for (const auto &phrase : *phrases)
+            {
+                if (phrase.isMatch(message))
+                {
+                    blocked = true;
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(blocked);
+        }
+    }
+}
+
+BENCHMARK(BM_IgnoreNaiveFindBlock);
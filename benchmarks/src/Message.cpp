@@ -0,0 +1,140 @@
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageElement.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <unordered_set>
+
+using namespace chatterino;
+
+namespace {
+
+// The replaced operator new is used by every benchmark of this binary, so
+// allocations are only counted while BM_MessageMemory builds messages
+std::atomic<bool> countAllocations{false};
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> allocatedBytes{0};
+
+}  // namespace
+
+void *operator new(size_t size)
+{
+    if (countAllocations.load(std::memory_order_relaxed))
+    {
+        allocations++;
+        allocatedBytes += size;
+    }
+
+    if (void *pointer = std::malloc(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+static MessagePtr buildMessage(int i)
+{
+    // Like messages parsed from IRC, every message gets its own copy of the
+    // names
+    auto login = QString("user%1").arg(i % 50);
+
+    MessageBuilder builder;
+    builder->loginName = login;
+    builder->displayName = login;
+    builder->channelName = QString("pajlada");
+    builder->badgeInfos.emplace_back(QString("subscriber"),
+                                     QString::number(i % 24));
+
+    builder.emplace<TextElement>(login + ":", MessageElementFlag::Username);
+    for (const auto &word : {"this", "is", "a", "pretty", "average", "chat",
+                             "message", "Kappa", "with", "some", "words"})
+    {
+        builder.emplace<TextElement>(word, MessageElementFlag::Text);
+    }
+
+    return builder.release();
+}
+
+// QString data is allocated with malloc, so operator new doesn't see it.
+// Returns the bytes of the distinct string buffers the names of `messages`
+// use, names that share a buffer are only counted once.
+static size_t nameBytes(const std::vector<MessagePtr> &messages)
+{
+    std::unordered_set<const QChar *> buffers;
+    size_t bytes = 0;
+
+    auto add = [&](const QString &string) {
+        if (!string.isEmpty() && buffers.insert(string.constData()).second)
+        {
+            bytes += size_t(string.capacity() + 1) * sizeof(QChar);
+        }
+    };
+
+    for (const auto &message : messages)
+    {
+        add(message->loginName);
+        add(message->displayName);
+        add(message->channelName);
+        for (const auto &[key, value] : message->badgeInfos)
+        {
+            add(key);
+            add(value);
+        }
+    }
+
+    return bytes;
+}
+
+// Builds a full channel buffer of messages and reports how many allocations
+// and bytes each message costs, and how many bytes its names take up
+static void BM_MessageMemory(benchmark::State &state)
+{
+    constexpr int MESSAGE_COUNT = 1000;
+
+    size_t allocationsPerBuffer = 0;
+    size_t bytesPerBuffer = 0;
+    size_t nameBytesPerBuffer = 0;
+
+    for (auto _ : state)
+    {
+        std::vector<MessagePtr> messages;
+        messages.reserve(MESSAGE_COUNT);
+
+        auto allocationsBefore = allocations.load();
+        auto bytesBefore = allocatedBytes.load();
+        countAllocations = true;
+
+        for (int i = 0; i < MESSAGE_COUNT; ++i)
+        {
+            messages.push_back(buildMessage(i));
+        }
+
+        countAllocations = false;
+        allocationsPerBuffer = allocations.load() - allocationsBefore;
+        bytesPerBuffer = allocatedBytes.load() - bytesBefore;
+
+        state.PauseTiming();
+        nameBytesPerBuffer = nameBytes(messages);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(messages);
+    }
+
+    state.counters["allocations/message"] =
+        double(allocationsPerBuffer) / MESSAGE_COUNT;
+    state.counters["bytes/message"] = double(bytesPerBuffer) / MESSAGE_COUNT;
+    state.counters["name bytes/message"] =
+        double(nameBytesPerBuffer) / MESSAGE_COUNT;
+}
+
+BENCHMARK(BM_MessageMemory);
@@ -0,0 +1,90 @@
+#include "providers/twitch/PubsubHelpers.hpp"
+
+#include <benchmark/benchmark.h>
+#include <rapidjson/document.h>
+#include <QString>
+
+#include <string>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+// Frames recorded from PubSub, one for each topic we listen to
+const std::vector<std::string> FRAMES{
+    R"({"type":"MESSAGE","data":{"topic":"chat_moderator_actions.11148817.11148817","message":"{\"type\":\"moderation_action\",\"data\":{\"type\":\"chat_login_moderation\",\"moderation_action\":\"timeout\",\"args\":[\"forsen\",\"600\",\"\"],\"created_by\":\"pajlada\",\"created_by_user_id\":\"11148817\",\"msg_id\":\"\",\"target_user_id\":\"22484632\",\"target_user_login\":\"\",\"from_automod\":false}}"}})",
+    R"({"type":"MESSAGE","data":{"topic":"automod-queue.11148817.11148817","message":"{\"type\":\"automod_caught_message\",\"data\":{\"content_classification\":{\"category\":\"aggression\",\"level\":4},\"message\":{\"content\":{\"text\":\"this is a caught message\",\"fragments\":[{\"text\":\"this is a caught message\",\"automod\":{\"topics\":{\"aggression\":5}}}]},\"id\":\"4bf4d8a8-1f43-4b87-b1c3-7f6c6a4e1a3e\",\"sender\":{\"user_id\":\"117166826\",\"login\":\"testaccount_420\",\"display_name\":\"TestAccount_420\",\"chat_color\":\"#FF0000\"},\"sent_at\":\"2021-05-21T12:05:48.437126463Z\"},\"reason_code\":\"\",\"resolver_id\":\"\",\"resolver_login\":\"\",\"status\":\"PENDING\"}}"}})",
+    R"({"type":"MESSAGE","data":{"topic":"community-points-channel-v1.11148817","message":"{\"type\":\"reward-redeemed\",\"data\":{\"timestamp\":\"2021-05-21T12:06:01.537Z\",\"redemption\":{\"id\":\"a3a2b2b0-5b2e-4d0f-9c1c-5b5b5b5b5b5b\",\"user\":{\"id\":\"117166826\",\"login\":\"testaccount_420\",\"display_name\":\"TestAccount_420\"},\"channel_id\":\"11148817\",\"redeemed_at\":\"2021-05-21T12:06:01.537Z\",\"reward\":{\"id\":\"e4ce0b8a-2b63-4ba5-b5a6-4e8ec5d8d0ad\",\"channel_id\":\"11148817\",\"title\":\"Hydrate\",\"prompt\":\"Drink some water\",\"cost\":500,\"is_user_input_required\":false,\"is_sub_only\":false,\"image\":null,\"default_image\":{\"url_1x\":\"https://static-cdn.jtvnw.net/custom-reward-images/default-1.png\",\"url_2x\":\"https://static-cdn.jtvnw.net/custom-reward-images/default-2.png\",\"url_4x\":\"https://static-cdn.jtvnw.net/custom-reward-images/default-4.png\"},\"background_color\":\"#00C7AC\",\"is_enabled\":true,\"is_paused\":false,\"is_in_stock\":true,\"max_per_stream\":{\"is_enabled\":false,\"max_per_stream\":0},\"should_redemptions_skip_request_queue\":false},\"status\":\"UNFULFILLED\"}}}"}})",
+    R"({"type":"MESSAGE","data":{"topic":"whispers.11148817","message":"{\"type\":\"whisper_received\",\"data\":\"{}\",\"thread_id\":\"11148817_117166826\",\"body\":\"hello there\",\"sent_ts\":1621598761,\"from_id\":117166826,\"tags\":{\"login\":\"testaccount_420\",\"display_name\":\"TestAccount_420\",\"color\":\"#FF0000\",\"emotes\":[],\"badges\":[]},\"recipient\":{\"id\":11148817,\"username\":\"pajlada\",\"display_name\":\"pajlada\",\"color\":\"#CC44FF\"},\"nonce\":\"6GVBTfBXNj7d71BULYKjpiKapegDI1\"}"}})",
+};
+
+}  // namespace
+
+// How frames are decoded now: both the frame and the nested message are
+// parsed in place, and the topic is looked up by its hash
+static void BM_PubSubFrameDecoding(benchmark::State &state)
+{
+    // Stands in for the websocket buffer, which we're allowed to modify
+    std::string buffer;
+    buffer.reserve(4096);
+
+    for (auto _ : state)
+    {
+        for (const auto &frame : FRAMES)
+        {
+            buffer.assign(frame);
+
+            InsituDocument outer;
+            outer.parse(&buffer[0]);
+
+            const auto &data = outer.get()["data"];
+            const auto &topic = data["topic"];
+
+            auto type = getTopicType(
+                {topic.GetString(), topic.GetStringLength()});
+            benchmark::DoNotOptimize(type);
+
+            InsituDocument inner;
+            inner.parse(const_cast<char *>(data["message"].GetString()));
+            benchmark::DoNotOptimize(inner.get()["type"].GetString());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * FRAMES.size());
+}
+
+// How frames were decoded before: converted to a QString and back, the
+// nested message parsed into a second document, and the topic matched by
+// prefix
+static void BM_PubSubFrameDecodingCopying(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        for (const auto &frame : FRAMES)
+        {
+            auto payload = QString::fromStdString(frame);
+
+            rapidjson::Document outer;
+            outer.Parse(payload.toUtf8());
+
+            const auto &data = outer["data"];
+            QString topic;
+            rj::getSafe(data, "topic", topic);
+            QString message;
+            rj::getSafe(data, "message", message);
+
+            auto isAutomod = topic.startsWith("automod-queue.");
+            benchmark::DoNotOptimize(isAutomod);
+
+            rapidjson::Document inner;
+            inner.Parse(message.toUtf8());
+            benchmark::DoNotOptimize(inner["type"].GetString());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * FRAMES.size());
+}
+
+BENCHMARK(BM_PubSubFrameDecoding);
+BENCHMARK(BM_PubSubFrameDecodingCopying);
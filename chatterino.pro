@@ -140,7 +140,10 @@ SOURCES += \
     src/common/NetworkPrivate.cpp \
     src/common/NetworkRequest.cpp \
     src/common/NetworkResult.cpp \
+    src/common/NetworkScheduler.cpp \
     src/common/QLogging.cpp \
+    src/common/SnapshotStore.cpp \
+    src/common/SymbolTable.cpp \
     src/common/Version.cpp \
     src/common/WindowDescriptors.cpp \
     src/controllers/accounts/Account.cpp \
@@ -164,6 +167,7 @@ SOURCES += \
     src/controllers/hotkeys/HotkeyHelpers.cpp \
     src/controllers/hotkeys/HotkeyModel.cpp \
     src/controllers/ignores/IgnoreController.cpp \
+    src/controllers/ignores/IgnoreEngine.cpp \
     src/controllers/ignores/IgnoreModel.cpp \
     src/controllers/moderationactions/ModerationAction.cpp \
     src/controllers/moderationactions/ModerationActionModel.cpp \
@@ -177,14 +181,18 @@ SOURCES += \
     src/messages/Image.cpp \
     src/messages/ImageSet.cpp \
     src/messages/layouts/MessageLayout.cpp \
+    src/messages/layouts/MessageLayoutCache.cpp \
     src/messages/layouts/MessageLayoutContainer.cpp \
     src/messages/layouts/MessageLayoutElement.cpp \
     src/messages/Link.cpp \
     src/messages/Message.cpp \
+    src/messages/MessageArena.cpp \
+    src/messages/MessageAuthorIndex.cpp \
     src/messages/MessageBuilder.cpp \
     src/messages/MessageColor.cpp \
     src/messages/MessageContainer.cpp \
     src/messages/MessageElement.cpp \
+    src/messages/MessageSpillStore.cpp \
     src/messages/search/AuthorPredicate.cpp \
     src/messages/search/ChannelPredicate.cpp \
     src/messages/search/LinkPredicate.cpp \
@@ -192,6 +200,8 @@ SOURCES += \
     src/messages/search/RegexPredicate.cpp \
     src/messages/search/SubstringPredicate.cpp \
     src/messages/SharedMessageBuilder.cpp \
+    src/messages/TimestampFormatter.cpp \
+    src/providers/BadgeRegistry.cpp \
     src/providers/bttv/BttvEmotes.cpp \
     src/providers/bttv/LoadBttvChannelEmote.cpp \
     src/providers/chatterino/ChatterinoBadges.cpp \
@@ -240,6 +250,7 @@ SOURCES += \
     src/singletons/Logging.cpp \
     src/singletons/NativeMessaging.cpp \
     src/singletons/Paths.cpp \
+    src/singletons/RenderSettings.cpp \
     src/singletons/Resources.cpp \
     src/singletons/Settings.cpp \
     src/singletons/Theme.cpp \
@@ -249,7 +260,6 @@ SOURCES += \
     src/singletons/WindowManager.cpp \
     src/util/AttachToConsole.cpp \
     src/util/Clipboard.cpp \
-    src/util/DebugCount.cpp \
     src/util/DisplayBadge.cpp \
     src/util/FormatTime.cpp \
     src/util/FunctionEventFilter.cpp \
@@ -258,6 +268,8 @@ SOURCES += \
     src/util/IncognitoBrowser.cpp \
     src/util/InitUpdateButton.cpp \
     src/util/LayoutHelper.cpp \
+    src/util/Metrics.cpp \
+    src/util/MetricsExporter.cpp \
     src/util/NuulsUploader.cpp \
     src/util/RapidjsonHelpers.cpp \
     src/util/RatelimitBucket.cpp \
@@ -303,15 +315,18 @@ SOURCES += \
     src/widgets/helper/DebugPopup.cpp \
     src/widgets/helper/EditableModelView.cpp \
     src/widgets/helper/EffectLabel.cpp \
+    src/widgets/helper/MessageHeightTree.cpp \
     src/widgets/helper/NotebookButton.cpp \
     src/widgets/helper/NotebookTab.cpp \
     src/widgets/helper/QColorPicker.cpp \
     src/widgets/helper/ResizingTextEdit.cpp \
     src/widgets/helper/ScrollbarHighlight.cpp \
+    src/widgets/helper/ScrollbarMinimap.cpp \
     src/widgets/helper/SearchPopup.cpp \
     src/widgets/helper/SettingsDialogTab.cpp \
     src/widgets/helper/SignalLabel.cpp \
     src/widgets/helper/TitlebarButton.cpp \
+    src/widgets/helper/ViewSuspension.cpp \
     src/widgets/Label.cpp \
     src/widgets/listview/GenericItemDelegate.cpp \
     src/widgets/listview/GenericListItem.cpp \
@@ -374,6 +389,7 @@ HEADERS += \
     src/common/NetworkPrivate.hpp \
     src/common/NetworkRequest.hpp \
     src/common/NetworkResult.hpp \
+    src/common/NetworkScheduler.hpp \
     src/common/NullablePtr.hpp \
     src/common/Outcome.hpp \
     src/common/ProviderId.hpp \
@@ -381,8 +397,11 @@ HEADERS += \
     src/common/SignalVector.hpp \
     src/common/SignalVectorModel.hpp \
     src/common/Singleton.hpp \
+    src/common/SnapshotStore.hpp \
+    src/common/SymbolTable.hpp \
     src/common/UniqueAccess.hpp \
     src/common/Version.hpp \
+    src/common/WeakRegistry.hpp \
     src/common/WindowDescriptors.hpp \
     src/controllers/accounts/Account.hpp \
     src/controllers/accounts/AccountController.hpp \
@@ -410,6 +429,7 @@ HEADERS += \
     src/controllers/hotkeys/HotkeyHelpers.hpp \
     src/controllers/hotkeys/HotkeyModel.hpp \
     src/controllers/ignores/IgnoreController.hpp \
+    src/controllers/ignores/IgnoreEngine.hpp \
     src/controllers/ignores/IgnoreModel.hpp \
     src/controllers/ignores/IgnorePhrase.hpp \
     src/controllers/moderationactions/ModerationAction.hpp \
@@ -426,17 +446,21 @@ HEADERS += \
     src/messages/Image.hpp \
     src/messages/ImageSet.hpp \
     src/messages/layouts/MessageLayout.hpp \
+    src/messages/layouts/MessageLayoutCache.hpp \
     src/messages/layouts/MessageLayoutContainer.hpp \
     src/messages/layouts/MessageLayoutElement.hpp \
     src/messages/LimitedQueue.hpp \
     src/messages/LimitedQueueSnapshot.hpp \
     src/messages/Link.hpp \
     src/messages/Message.hpp \
+    src/messages/MessageArena.hpp \
+    src/messages/MessageAuthorIndex.hpp \
     src/messages/MessageBuilder.hpp \
     src/messages/MessageColor.hpp \
     src/messages/MessageContainer.hpp \
     src/messages/MessageElement.hpp \
     src/messages/MessageParseArgs.hpp \
+    src/messages/MessageSpillStore.hpp \
     src/messages/search/AuthorPredicate.hpp \
     src/messages/search/ChannelPredicate.hpp \
     src/messages/search/LinkPredicate.hpp \
@@ -445,7 +469,9 @@ HEADERS += \
     src/messages/search/SubstringPredicate.hpp \
     src/messages/Selection.hpp \
     src/messages/SharedMessageBuilder.hpp \
+    src/messages/TimestampFormatter.hpp \
     src/PrecompiledHeader.hpp \
+    src/providers/BadgeRegistry.hpp \
     src/providers/bttv/BttvEmotes.hpp \
     src/providers/bttv/LoadBttvChannelEmote.hpp \
     src/providers/chatterino/ChatterinoBadges.hpp \
@@ -469,6 +495,7 @@ HEADERS += \
     src/providers/seventv/SeventvEmotes.hpp \
     src/providers/seventv/SeventvWebSocket.hpp \
     src/providers/twitch/api/Helix.hpp \
+    src/providers/twitch/api/HelixCache.hpp \
     src/providers/twitch/api/Kraken.hpp \
     src/providers/twitch/ChannelPointReward.hpp \
     src/providers/twitch/ChatterinoWebSocketppLogger.hpp \
@@ -497,6 +524,7 @@ HEADERS += \
     src/singletons/Logging.hpp \
     src/singletons/NativeMessaging.hpp \
     src/singletons/Paths.hpp \
+    src/singletons/RenderSettings.hpp \
     src/singletons/Resources.hpp \
     src/singletons/Settings.hpp \
     src/singletons/Theme.hpp \
@@ -509,7 +537,6 @@ HEADERS += \
     src/util/Clipboard.hpp \
     src/util/CombinePath.hpp \
     src/util/ConcurrentMap.hpp \
-    src/util/DebugCount.hpp \
     src/util/DisplayBadge.hpp \
     src/util/DistanceBetweenPoints.hpp \
     src/util/ExponentialBackoff.hpp \
@@ -523,6 +550,8 @@ HEADERS += \
     src/util/IsBigEndian.hpp \
     src/util/LayoutCreator.hpp \
     src/util/LayoutHelper.hpp \
+    src/util/Metrics.hpp \
+    src/util/MetricsExporter.hpp \
     src/util/NuulsUploader.hpp \
     src/util/Overloaded.hpp \
     src/util/PersistSignalVector.hpp \
@@ -583,15 +612,18 @@ HEADERS += \
     src/widgets/helper/EditableModelView.hpp \
     src/widgets/helper/EffectLabel.hpp \
     src/widgets/helper/Line.hpp \
+    src/widgets/helper/MessageHeightTree.hpp \
     src/widgets/helper/NotebookButton.hpp \
     src/widgets/helper/NotebookTab.hpp \
     src/widgets/helper/QColorPicker.hpp \
     src/widgets/helper/ResizingTextEdit.hpp \
     src/widgets/helper/ScrollbarHighlight.hpp \
+    src/widgets/helper/ScrollbarMinimap.hpp \
     src/widgets/helper/SearchPopup.hpp \
     src/widgets/helper/SettingsDialogTab.hpp \
     src/widgets/helper/SignalLabel.hpp \
     src/widgets/helper/TitlebarButton.hpp \
+    src/widgets/helper/ViewSuspension.hpp \
     src/widgets/Label.hpp \
     src/widgets/listview/GenericItemDelegate.hpp \
     src/widgets/listview/GenericListItem.hpp \
@@ -3,7 +3,9 @@
 #include <atomic>
 
 #include "common/Args.hpp"
+#include "common/Env.hpp"
 #include "common/QLogging.hpp"
+#include "common/SnapshotStore.hpp"
 #include "common/Version.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/commands/CommandController.hpp"
@@ -12,6 +14,7 @@
 #include "controllers/notifications/NotificationController.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "messages/TimestampFormatter.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/chatterino/ChatterinoBadges.hpp"
 #include "providers/ffz/FfzBadges.hpp"
@@ -36,12 +39,14 @@
 #include "singletons/Updates.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/IsBigEndian.hpp"
+#include "util/MetricsExporter.hpp"
 #include "util/PostToThread.hpp"
 #include "util/RapidjsonHelpers.hpp"
 #include "widgets/Notebook.hpp"
 #include "widgets/Window.hpp"
 #include "widgets/splits/Split.hpp"
 
+#include <QApplication>
 #include <QDesktopServices>
 
 namespace chatterino {
@@ -75,6 +80,7 @@ Application::Application(Settings &_settings, Paths &_paths)
     this->instance = this;
 
     this->fonts->fontChanged.connect([this]() {
+        TimestampFormatter::instance().clear();
         this->windows->layoutChannelViews();
     });
 
@@ -117,6 +123,13 @@ void Application::initialize(Settings &settings, Paths &paths)
         singleton->initialize(settings, paths);
     }
 
+    // The window layout is loaded now, so its channels are the open ones
+    QStringList openChannels;
+    this->twitch2->forEachChannel([&openChannels](ChannelPtr channel) {
+        openChannels.append(channel->getName());
+    });
+    SnapshotStore::pruneChannels(openChannels);
+
     // add crash message
     if (!getArgs().isFramelessEmbed && getArgs().crashRecovery)
     {
@@ -146,6 +159,7 @@ void Application::initialize(Settings &settings, Paths &paths)
         this->initNm(paths);
     }
     this->initPubsub();
+    this->initMetrics();
 }
 
 int Application::run(QApplication &qtApp)
@@ -202,6 +216,19 @@ void Application::initNm(Paths &paths)
 #endif
 }
 
+void Application::initMetrics()
+{
+    const auto &env = Env::get();
+    if (env.metricsDumpPath.isEmpty() && env.metricsPort == 0)
+    {
+        return;
+    }
+
+    // Lives until the application quits
+    new MetricsExporter(env.metricsDumpPath, env.metricsPort,
+                        std::chrono::seconds(10), qApp);
+}
+
 void Application::initPubsub()
 {
     this->twitch.pubsub->signals_.moderation.chatCleared.connect(
@@ -304,16 +331,11 @@ void Application::initPubsub()
 
             postToThread([chan, msg = msg.release()] {
                 auto replaced = false;
-                LimitedQueueSnapshot<MessagePtr> snapshot =
-                    chan->getMessageSnapshot();
-                int snapshotLength = snapshot.size();
-
-                // without parens it doesn't build on windows
-                int end = (std::max)(0, snapshotLength - 200);
+                auto recent = chan->findMessagesByUser(msg->timeoutUser, 200);
 
-                for (int i = snapshotLength - 1; i >= end; --i)
+                for (auto it = recent.rbegin(); it != recent.rend(); ++it)
                 {
-                    auto &s = snapshot[i];
+                    auto &s = *it;
                     if (!s->flags.has(MessageFlag::PubSub) &&
                         s->timeoutUser == msg->timeoutUser)
                     {
@@ -78,6 +78,7 @@ private:
     void addSingleton(Singleton *singleton);
     void initPubsub();
     void initNm(Paths &paths);
+    void initMetrics();
 
     template <typename T,
               typename = std::enable_if_t<std::is_base_of<Singleton, T>::value>>
@@ -3,6 +3,7 @@
 #include "Application.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "messages/MessageSpillStore.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Logging.hpp"
@@ -26,6 +27,7 @@ Channel::Channel(const QString &name, Type type)
     : completionModel(*this)
     , lastDate_(QDate::currentDate())
     , name_(name)
+    , messages_(MESSAGE_LIMIT, MAX_MESSAGE_LIMIT)
     , type_(type)
 {
 }
@@ -79,7 +81,6 @@ void Channel::addMessage(MessagePtr message,
                          boost::optional<MessageFlags> overridingFlags)
 {
     auto app = getApp();
-    MessagePtr deleted;
 
     // FOURTF: change this when adding more providers
     if (this->isTwitchChannel() &&
@@ -88,7 +89,13 @@ void Channel::addMessage(MessagePtr message,
         app->logging->addMessage(this->name_, message);
     }
 
-    if (this->messages_.pushBack(message, deleted))
+    std::vector<MessagePtr> evicted;
+    {
+        std::lock_guard<std::mutex> lock(this->historyMutex_);
+        this->pushMessage(message, evicted);
+    }
+
+    for (auto &deleted : evicted)
     {
         this->messageRemovedFromStart.invoke(deleted);
     }
@@ -98,10 +105,8 @@ void Channel::addMessage(MessagePtr message,
 
 void Channel::addOrReplaceTimeout(MessagePtr message)
 {
-    LimitedQueueSnapshot<MessagePtr> snapshot = this->getMessageSnapshot();
-    int snapshotLength = snapshot.size();
-
-    int end = std::max(0, snapshotLength - 20);
+    // Only stack on top of what happened to the user in the last messages
+    auto recent = this->findMessagesByUser(message->timeoutUser, 20);
 
     bool addMessage = true;
 
@@ -110,9 +115,9 @@ void Channel::addOrReplaceTimeout(MessagePtr message)
     auto timeoutStackStyle = static_cast<TimeoutStackStyle>(
         getSettings()->timeoutStackStyle.getValue());
 
-    for (int i = snapshotLength - 1; i >= end; --i)
+    for (auto it = recent.rbegin(); it != recent.rend(); ++it)
     {
-        auto &s = snapshot[i];
+        auto &s = *it;
 
         if (s->parseTime < minimumTime)
         {
@@ -169,9 +174,8 @@ void Channel::addOrReplaceTimeout(MessagePtr message)
     }
 
     // disable the messages from the user
-    for (int i = 0; i < snapshotLength; i++)
+    for (auto &&s : this->findMessagesByUser(message->timeoutUser))
     {
-        auto &s = snapshot[i];
         if (s->loginName == message->timeoutUser &&
             s->flags.hasNone({MessageFlag::Timeout, MessageFlag::Untimeout,
                               MessageFlag::Whisper}))
@@ -212,7 +216,7 @@ void Channel::disableAllMessages()
 void Channel::addMessagesAtStart(std::vector<MessagePtr> &_messages)
 {
     std::vector<MessagePtr> addedMessages =
-        this->messages_.pushFront(_messages);
+        this->pushMessagesAtStart(_messages);
 
     if (addedMessages.size() != 0)
     {
@@ -220,20 +224,66 @@ void Channel::addMessagesAtStart(std::vector<MessagePtr> &_messages)
     }
 }
 
+std::vector<MessagePtr> Channel::pushMessagesAtStart(
+    std::vector<MessagePtr> &messages)
+{
+    if (this->type_ != Type::None && spillLimit() > 0)
+    {
+        this->messages_.grow(messages.size());
+    }
+
+    std::vector<MessagePtr> addedMessages = this->messages_.pushFront(messages);
+    this->authorIndex_.prepend(addedMessages);
+
+    return addedMessages;
+}
+
+void Channel::addMessagesAtEnd(std::vector<MessagePtr> &messages)
+{
+    if (messages.empty())
+    {
+        return;
+    }
+
+    std::vector<MessagePtr> evicted;
+    {
+        std::lock_guard<std::mutex> lock(this->historyMutex_);
+        for (const auto &message : messages)
+        {
+            this->pushMessage(message, evicted);
+        }
+    }
+
+    for (auto &deleted : evicted)
+    {
+        this->messageRemovedFromStart.invoke(deleted);
+    }
+
+    this->messagesAddedAtEnd.invoke(messages);
+}
+
 void Channel::replaceMessage(MessagePtr message, MessagePtr replacement)
 {
     int index = this->messages_.replaceItem(message, replacement);
 
     if (index >= 0)
     {
+        this->authorIndex_.replace(message, replacement);
         this->messageReplaced.invoke((size_t)index, replacement);
     }
 }
 
 void Channel::replaceMessage(size_t index, MessagePtr replacement)
 {
+    auto snapshot = this->getMessageSnapshot();
+    if (index >= snapshot.size())
+    {
+        return;
+    }
+
     if (this->messages_.replaceItem(index, replacement))
     {
+        this->authorIndex_.replace(snapshot[index], replacement);
         this->messageReplaced.invoke(index, replacement);
     }
 }
@@ -265,6 +315,170 @@ MessagePtr Channel::findMessage(QString messageID)
     return nullptr;
 }
 
+std::vector<MessagePtr> Channel::findMessagesByUser(const QString &login,
+                                                    size_t withinLast)
+{
+    return this->authorIndex_.find(login, withinLast);
+}
+
+Channel::History Channel::getHistorySnapshot()
+{
+    std::lock_guard<std::mutex> lock(this->historyMutex_);
+
+    History history{this->messages_.getSnapshot(), this->spillStore_};
+    if (this->spillStore_)
+    {
+        history.spilledBegin = this->spillStore_->begin();
+        history.spilledEnd = this->spillStore_->end();
+    }
+
+    return history;
+}
+
+bool Channel::hasSpilledMessages() const
+{
+    std::lock_guard<std::mutex> lock(this->historyMutex_);
+
+    return this->spillStore_ && this->spillStore_->size() > 0;
+}
+
+size_t Channel::loadSpilledMessages(size_t count)
+{
+    std::vector<MessagePtr> messages;
+    std::vector<MessagePtr> addedMessages;
+    {
+        // The messages are moved back into memory at once
+        std::lock_guard<std::mutex> lock(this->historyMutex_);
+
+        if (!this->spillStore_)
+        {
+            return 0;
+        }
+
+        // Messages that don't fit anymore stay on disk, they can still be
+        // found by searching
+        count = std::min(count, this->messages_.spaceToGrow());
+
+        for (const auto &spilled : this->spillStore_->takeBack(count))
+        {
+            if (auto message = this->rebuildMessage(spilled))
+            {
+                messages.push_back(std::move(message));
+            }
+        }
+
+        if (!messages.empty())
+        {
+            addedMessages = this->pushMessagesAtStart(messages);
+        }
+    }
+
+    if (!addedMessages.empty())
+    {
+        this->messagesAddedAtStart.invoke(addedMessages);
+    }
+
+    return messages.size();
+}
+
+size_t Channel::spillLimit()
+{
+    auto scrollbackLimit =
+        size_t(std::max(0, getSettings()->scrollbackLimit.getValue()));
+
+    return scrollbackLimit > MESSAGE_LIMIT ? scrollbackLimit - MESSAGE_LIMIT
+                                           : 0;
+}
+
+MessagePtr Channel::rebuildMessage(const SpilledMessage &message)
+{
+    // Without the IRC message, only the text is left
+    MessageBuilder builder;
+    builder.emplace<TimestampElement>(message.parseTime);
+
+    if (message.flags.has(MessageFlag::System))
+    {
+        builder.emplace<TextElement>(message.messageText,
+                                     MessageElementFlag::Text,
+                                     MessageColor::System);
+    }
+    else
+    {
+        if (!message.displayName.isEmpty())
+        {
+            builder.emplace<TextElement>(
+                message.displayName + ":", MessageElementFlag::Username,
+                message.usernameColor, FontStyle::ChatMediumBold);
+        }
+        builder.emplace<TextElement>(message.messageText,
+                                     MessageElementFlag::Text,
+                                     MessageColor::Text);
+    }
+
+    message.applyTo(builder.message());
+
+    return builder.release();
+}
+
+void Channel::pushMessage(const MessagePtr &message,
+                          std::vector<MessagePtr> &evicted)
+{
+    MessagePtr deleted;
+    bool removed = this->messages_.pushBack(message, deleted);
+
+    this->authorIndex_.append(message);
+    if (removed)
+    {
+        this->messageEvicted(deleted);
+        evicted.push_back(deleted);
+    }
+    if (this->messages_.shrink(deleted))
+    {
+        this->messageEvicted(deleted);
+        evicted.push_back(deleted);
+    }
+}
+
+void Channel::messageEvicted(const MessagePtr &message)
+{
+    this->authorIndex_.removeOldest(message);
+
+    // Channels without a type only show messages of other channels
+    if (this->type_ != Type::None)
+    {
+        auto spillLimit = Channel::spillLimit();
+
+        if (spillLimit > 0 && !this->spillStore_)
+        {
+            this->spillStore_ = std::make_shared<MessageSpillStore>();
+        }
+
+        if (this->spillStore_)
+        {
+            this->spillStore_->setLimit(spillLimit);
+            this->spillStore_->append(SpilledMessage::fromMessage(*message));
+        }
+    }
+}
+
+bool Channel::isActivated() const
+{
+    return this->activated_;
+}
+
+void Channel::activate()
+{
+    if (this->activated_)
+    {
+        return;
+    }
+
+    this->activated_ = true;
+
+    this->onActivated();
+    this->activated.invoke();
+}
+
 bool Channel::canSendMessage() const
 {
     return false;
@@ -325,6 +539,10 @@ void Channel::onConnected()
 {
 }
 
+void Channel::onActivated()
+{
+}
+
 //
 // Indirect channel
 //
@@ -3,6 +3,7 @@
 #include "common/CompletionModel.hpp"
 #include "common/FlagsEnum.hpp"
 #include "messages/LimitedQueue.hpp"
+#include "messages/MessageAuthorIndex.hpp"
 
 #include <QDate>
 #include <QString>
@@ -11,10 +12,14 @@
 #include <pajlada/signals/signal.hpp>
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace chatterino {
 
 struct Message;
+class MessageSpillStore;
+struct SpilledMessage;
 using MessagePtr = std::shared_ptr<const Message>;
 enum class MessageFlag : uint32_t;
 using MessageFlags = FlagsEnum<MessageFlag>;
@@ -43,6 +48,12 @@ public:
         Misc
     };
 
+    // Number of messages kept in memory
+    static constexpr size_t MESSAGE_LIMIT = 1000;
+    // Number of messages kept in memory while scrolled back into the
+    // spilled messages
+    static constexpr size_t MAX_MESSAGE_LIMIT = 5000;
+
     explicit Channel(const QString &name, Type type);
     virtual ~Channel();
 
@@ -53,9 +64,11 @@ public:
     pajlada::Signals::Signal<MessagePtr &, boost::optional<MessageFlags>>
         messageAppended;
     pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtStart;
+    pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtEnd;
     pajlada::Signals::Signal<size_t, MessagePtr &> messageReplaced;
     pajlada::Signals::NoArgSignal destroyed;
     pajlada::Signals::NoArgSignal displayNameChanged;
+    pajlada::Signals::NoArgSignal activated;
 
     Type getType() const;
     const QString &getName() const;
@@ -72,16 +85,61 @@ public:
     void addMessage(
         MessagePtr message,
         boost::optional<MessageFlags> overridingFlags = boost::none);
+    // While messages are spilled, this raises the number of messages kept in
+    // memory up to MAX_MESSAGE_LIMIT to fit the messages. It goes back down by
+    // one for every message that's added at the end. Otherwise only as many
+    // messages as there's space for are added.
     void addMessagesAtStart(std::vector<MessagePtr> &messages_);
+    // Appends a batch of messages at once. Unlike addMessage, the messages
+    // are not logged and don't trigger notifications
+    void addMessagesAtEnd(std::vector<MessagePtr> &messages);
     void addOrReplaceTimeout(MessagePtr message);
     void disableAllMessages();
     void replaceMessage(MessagePtr message, MessagePtr replacement);
     void replaceMessage(size_t index, MessagePtr replacement);
     void deleteMessage(QString messageID);
     MessagePtr findMessage(QString messageID);
+    // Returns the messages sent by, or moderation actions and subscription
+    // notices about, the given user in channel order. Only the last
+    // `withinLast` messages of the channel are searched.
+    std::vector<MessagePtr> findMessagesByUser(
+        const QString &login,
+        size_t withinLast = MessageAuthorIndex::ALL_MESSAGES);
 
     bool hasMessages() const;
 
+    // SCROLLBACK
+    // Messages evicted from memory are spilled to disk if the scrollback
+    // limit is larger than MESSAGE_LIMIT
+    struct History {
+        LimitedQueueSnapshot<MessagePtr> messages;
+        // Not set if no message was spilled yet
+        std::shared_ptr<MessageSpillStore> spillStore;
+        // Records of spillStore that were spilled before `messages`
+        size_t spilledBegin = 0;
+        size_t spilledEnd = 0;
+    };
+    // Takes the snapshot and the spilled range at once, so every message is
+    // in exactly one of them
+    History getHistorySnapshot();
+    // Number of evicted messages kept on disk, 0 if spilling is disabled
+    static size_t spillLimit();
+    bool hasSpilledMessages() const;
+    // Rebuilds up to `count` of the newest spilled messages and adds them at
+    // the start. Returns the number of messages that were added.
+    size_t loadSpilledMessages(size_t count);
+    // Builds a message from its spilled record, returns nullptr if it
+    // shouldn't be shown anymore. Must be called on the GUI thread and must
+    // not add messages to the channel.
+    virtual MessagePtr rebuildMessage(const SpilledMessage &message);
+
+    // ACTIVATION
+    // Channels restored into hidden tabs are registered without being
+    // activated. They only join and start fetching their data once activate()
+    // is called, either by a view showing them or by the background warm-up.
+    bool isActivated() const;
+    void activate();
+
     // CHANNEL INFO
     virtual bool canSendMessage() const;
     virtual void sendMessage(const QString &message);
@@ -101,11 +159,29 @@ public:
 
 protected:
     virtual void onConnected();
+    virtual void onActivated();
 
 private:
+    // Adds as many of the messages at the start as there's space for and
+    // returns them
+    std::vector<MessagePtr> pushMessagesAtStart(
+        std::vector<MessagePtr> &messages);
+    // Appends the message, the messages evicted for it are added to
+    // `evicted`. historyMutex_ has to be held.
+    void pushMessage(const MessagePtr &message,
+                     std::vector<MessagePtr> &evicted);
+    // Called for every message that's removed from the start of messages_,
+    // historyMutex_ has to be held
+    void messageEvicted(const MessagePtr &message);
+
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    MessageAuthorIndex authorIndex_;
+    std::shared_ptr<MessageSpillStore> spillStore_;
+    // Held while messages move between messages_ and spillStore_
+    mutable std::mutex historyMutex_;
     Type type_;
+    bool activated_ = false;
     QTimer clearCompletionModelTimer_;
 };
 
@@ -61,6 +61,11 @@ Env::Env()
           readStringEnv("CHATTERINO2_TWITCH_SERVER_HOST", "irc.chat.twitch.tv"))
     , twitchServerPort(readPortEnv("CHATTERINO2_TWITCH_SERVER_PORT", 443))
     , twitchServerSecure(readBoolEnv("CHATTERINO2_TWITCH_SERVER_SECURE", true))
+    , seventvEventApiUrl(
+          readStringEnv("CHATTERINO2_SEVENTV_EVENTAPI_URL",
+                        "wss://events.7tv.app/v1/channel-emotes"))
+    , metricsDumpPath(readStringEnv("CHATTERINO2_METRICS_DUMP", ""))
+    , metricsPort(readPortEnv("CHATTERINO2_METRICS_PORT", 0))
 {
 }
 
@@ -17,6 +17,10 @@ public:
     const QString twitchServerHost;
     const uint16_t twitchServerPort;
     const bool twitchServerSecure;
+    const QString seventvEventApiUrl;
+    // Metrics are only exported if these are set, see MetricsExporter
+    const QString metricsDumpPath;
+    const uint16_t metricsPort;
 };
 
 }  // namespace chatterino
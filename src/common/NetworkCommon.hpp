@@ -32,6 +32,18 @@ const static std::vector<QString> networkRequestTypes{
     "PATCH",   //
 };
 
+// When there are more requests to a host than we allow to run at the same
+// time, queued requests are started in this order
+enum class NetworkRequestPriority {
+    // The user is waiting for the response, e.g. after sending a command or
+    // opening a usercard
+    Interactive,
+    // Images that are about to be painted
+    Image,
+    // Prefetching that nobody is waiting for yet
+    Background,
+};
+
 // parseHeaderList takes a list of headers in string form,
 // where each header pair is separated by semicolons (;) and the header name and value is divided by a colon (:)
 //
@@ -1,5 +1,7 @@
 #include "common/NetworkManager.hpp"
 
+#include "common/NetworkScheduler.hpp"
+
 #include <QNetworkAccessManager>
 
 namespace chatterino {
@@ -10,6 +12,7 @@ QNetworkAccessManager NetworkManager::accessManager;
 void NetworkManager::init()
 {
     NetworkManager::accessManager.moveToThread(&NetworkManager::workerThread);
+    NetworkScheduler::instance().moveToThread(&NetworkManager::workerThread);
     NetworkManager::workerThread.start();
 }
 
@@ -2,10 +2,11 @@
 
 #include "common/NetworkManager.hpp"
 #include "common/NetworkResult.hpp"
+#include "common/NetworkScheduler.hpp"
 #include "common/Outcome.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "singletons/Paths.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 #include "util/PostToThread.hpp"
 
 #include <QCryptographicHash>
@@ -19,14 +20,16 @@ namespace chatterino {
 NetworkData::NetworkData()
     : lifetimeManager_(new QObject)
 {
-    DebugCount::increase("NetworkData");
+    static auto &networkData = Metrics::gauge("NetworkData");
+    networkData.increase();
 }
 
 NetworkData::~NetworkData()
 {
     this->lifetimeManager_->deleteLater();
 
-    DebugCount::decrease("NetworkData");
+    static auto &networkData = Metrics::gauge("NetworkData");
+    networkData.decrease();
 }
 
 QString NetworkData::getHash()
@@ -72,249 +75,270 @@ void writeToCache(const std::shared_ptr<NetworkData> &data,
     }
 }
 
-void loadUncached(const std::shared_ptr<NetworkData> &data)
-{
-    DebugCount::increase("http request started");
-
-    NetworkRequester requester;
-    NetworkWorker *worker = new NetworkWorker;
-
-    worker->moveToThread(&NetworkManager::workerThread);
+namespace {
 
-    auto onUrlRequested = [data, worker]() mutable {
-        if (data->hasTimeout_)
+    // Delivers the reply of a finished request to the callbacks of `data`.
+    // Runs on the GUI thread unless the request is concurrent.
+    void handleReply(const std::shared_ptr<NetworkData> &data,
+                     QNetworkReply::NetworkError error,
+                     const NetworkResult &result)
+    {
+        if (data->hasCaller_ && !data->caller_.get())
         {
-            data->timer_ = new QTimer();
-            data->timer_->setSingleShot(true);
-            data->timer_->start(data->timeoutMS_);
+            return;
         }
 
-        auto reply = [&]() -> QNetworkReply * {
-            switch (data->requestType_)
+        if (error != QNetworkReply::NetworkError::NoError)
+        {
+            if (error == QNetworkReply::NetworkError::OperationCanceledError &&
+                result.status() != NetworkResult::timedoutStatus)
             {
-                case NetworkRequestType::Get:
-                    return NetworkManager::accessManager.get(data->request_);
-
-                case NetworkRequestType::Put:
-                    return NetworkManager::accessManager.put(data->request_,
-                                                             data->payload_);
-
-                case NetworkRequestType::Delete:
-                    return NetworkManager::accessManager.deleteResource(
-                        data->request_);
-
-                case NetworkRequestType::Post:
-                    if (data->multiPartPayload_)
-                    {
-                        assert(data->payload_.isNull());
-
-                        return NetworkManager::accessManager.post(
-                            data->request_, data->multiPartPayload_);
-                    }
-                    else
-                    {
-                        return NetworkManager::accessManager.post(
-                            data->request_, data->payload_);
-                    }
-                case NetworkRequestType::Patch:
-                    if (data->multiPartPayload_)
-                    {
-                        assert(data->payload_.isNull());
-
-                        return NetworkManager::accessManager.sendCustomRequest(
-                            data->request_, "PATCH", data->multiPartPayload_);
-                    }
-                    else
-                    {
-                        return NetworkManager::accessManager.sendCustomRequest(
-                            data->request_, "PATCH", data->payload_);
-                    }
+                // Operation cancelled by whoever created the reply
+                qCDebug(chatterinoHTTP)
+                    << QString("%1 [cancelled] %2")
+                           .arg(networkRequestTypes.at(int(data->requestType_)),
+                                data->request_.url().toString());
+                return;
             }
-            return nullptr;
-        }();
 
-        if (reply == nullptr)
-        {
-            qCDebug(chatterinoCommon) << "Unhandled request type";
-            return;
-        }
-
-        if (data->timer_ != nullptr && data->timer_->isActive())
-        {
-            QObject::connect(
-                data->timer_, &QTimer::timeout, worker, [reply, data]() {
-                    qCDebug(chatterinoCommon) << "Aborted!";
-                    reply->abort();
+            if (data->onError_)
+            {
+                if (data->requestType_ == NetworkRequestType::Get)
+                {
                     qCDebug(chatterinoHTTP)
-                        << QString("%1 [timed out] %2")
+                        << QString("%1 %2 %3")
                                .arg(networkRequestTypes.at(
                                         int(data->requestType_)),
+                                    QString::number(result.status()),
                                     data->request_.url().toString());
+                }
+                else
+                {
+                    qCDebug(chatterinoHTTP)
+                        << QString("%1 %2 %3 %4")
+                               .arg(networkRequestTypes.at(
+                                        int(data->requestType_)),
+                                    QString::number(result.status()),
+                                    data->request_.url().toString(),
+                                    QString(data->payload_));
+                }
+                // TODO: Should this always be run on the GUI thread?
+                postToThread([data, result] {
+                    data->onError_(result);
+                });
+            }
 
-                    if (data->onError_)
-                    {
-                        postToThread([data] {
-                            data->onError_(NetworkResult(
-                                {}, NetworkResult::timedoutStatus));
-                        });
-                    }
-
-                    if (data->finally_)
-                    {
-                        postToThread([data] {
-                            data->finally_();
-                        });
-                    }
+            if (data->finally_)
+            {
+                postToThread([data] {
+                    data->finally_();
                 });
+            }
+            return;
         }
 
-        if (data->onReplyCreated_)
+        static auto &httpRequestSuccess =
+            Metrics::counter("http request success");
+        httpRequestSuccess.increase();
+        // log("starting {}", data->request_.url().toString());
+        if (data->onSuccess_)
+        {
+            if (data->executeConcurrently_)
+                QtConcurrent::run(
+                    [onSuccess = std::move(data->onSuccess_), result] {
+                        onSuccess(result);
+                    });
+            else
+                data->onSuccess_(result);
+        }
+        // log("finished {}", data->request_.url().toString());
+
+        if (data->requestType_ == NetworkRequestType::Get)
+        {
+            qCDebug(chatterinoHTTP)
+                << QString("%1 %2 %3")
+                       .arg(networkRequestTypes.at(int(data->requestType_)),
+                            QString::number(result.status()),
+                            data->request_.url().toString());
+        }
+        else
+        {
+            qCDebug(chatterinoHTTP)
+                << QString("%1 %3 %2 %4")
+                       .arg(networkRequestTypes.at(int(data->requestType_)),
+                            data->request_.url().toString(),
+                            QString::number(result.status()),
+                            QString(data->payload_));
+        }
+        if (data->finally_)
         {
-            data->onReplyCreated_(reply);
+            if (data->executeConcurrently_)
+                QtConcurrent::run([finally = std::move(data->finally_)] {
+                    finally();
+                });
+            else
+                data->finally_();
         }
+    }
 
-        auto handleReply = [data, reply]() mutable {
-            if (data->hasCaller_ && !data->caller_.get())
+    void deliverReply(const std::vector<std::shared_ptr<NetworkData>> &requests,
+                      QNetworkReply::NetworkError error,
+                      const NetworkResult &result)
+    {
+        for (const auto &request : requests)
+        {
+            if (request->executeConcurrently_ || isGuiThread())
             {
-                return;
+                handleReply(request, error, result);
             }
-
-            // TODO(pajlada): A reply was received, kill the timeout timer
-            if (reply->error() != QNetworkReply::NetworkError::NoError)
+            else
             {
-                if (reply->error() ==
-                    QNetworkReply::NetworkError::OperationCanceledError)
-                {
-                    // Operation cancelled, most likely timed out
-                    qCDebug(chatterinoHTTP)
-                        << QString("%1 [cancelled] %2")
-                               .arg(networkRequestTypes.at(
-                                        int(data->requestType_)),
-                                    data->request_.url().toString());
-                    return;
-                }
+                postToThread([request, error, result] {
+                    handleReply(request, error, result);
+                });
+            }
+        }
+    }
 
-                if (data->onError_)
+}  // namespace
+
+bool startRequest(const std::shared_ptr<NetworkData> &data)
+{
+    if (data->hasTimeout_)
+    {
+        data->timer_ = new QTimer();
+        data->timer_->setSingleShot(true);
+        data->timer_->start(data->timeoutMS_);
+    }
+
+    auto reply = [&]() -> QNetworkReply * {
+        switch (data->requestType_)
+        {
+            case NetworkRequestType::Get:
+                return NetworkManager::accessManager.get(data->request_);
+
+            case NetworkRequestType::Put:
+                return NetworkManager::accessManager.put(data->request_,
+                                                         data->payload_);
+
+            case NetworkRequestType::Delete:
+                return NetworkManager::accessManager.deleteResource(
+                    data->request_);
+
+            case NetworkRequestType::Post:
+                if (data->multiPartPayload_)
                 {
-                    auto status = reply->attribute(
-                        QNetworkRequest::HttpStatusCodeAttribute);
-                    if (data->requestType_ == NetworkRequestType::Get)
-                    {
-                        qCDebug(chatterinoHTTP)
-                            << QString("%1 %2 %3")
-                                   .arg(networkRequestTypes.at(
-                                            int(data->requestType_)),
-                                        QString::number(status.toInt()),
-                                        data->request_.url().toString());
-                    }
-                    else
-                    {
-                        qCDebug(chatterinoHTTP)
-                            << QString("%1 %2 %3 %4")
-                                   .arg(networkRequestTypes.at(
-                                            int(data->requestType_)),
-                                        QString::number(status.toInt()),
-                                        data->request_.url().toString(),
-                                        QString(data->payload_));
-                    }
-                    // TODO: Should this always be run on the GUI thread?
-                    postToThread([reply, data, code = status.toInt()] {
-                        QByteArray bytes = reply->readAll();
+                    assert(data->payload_.isNull());
 
-                        data->onError_(NetworkResult(bytes, code));
-                    });
+                    return NetworkManager::accessManager.post(
+                        data->request_, data->multiPartPayload_);
+                }
+                else
+                {
+                    return NetworkManager::accessManager.post(data->request_,
+                                                              data->payload_);
                 }
+            case NetworkRequestType::Patch:
+                if (data->multiPartPayload_)
+                {
+                    assert(data->payload_.isNull());
 
-                if (data->finally_)
+                    return NetworkManager::accessManager.sendCustomRequest(
+                        data->request_, "PATCH", data->multiPartPayload_);
+                }
+                else
                 {
-                    postToThread([data] {
-                        data->finally_();
-                    });
+                    return NetworkManager::accessManager.sendCustomRequest(
+                        data->request_, "PATCH", data->payload_);
                 }
-                return;
-            }
+        }
+        return nullptr;
+    }();
+
+    if (reply == nullptr)
+    {
+        qCDebug(chatterinoCommon) << "Unhandled request type";
+        return false;
+    }
 
-            QByteArray bytes = reply->readAll();
-            writeToCache(data, bytes);
+    static auto &httpRequestStarted = Metrics::counter("http request started");
+    httpRequestStarted.increase();
 
+    NetworkWorker *worker = new NetworkWorker;
+
+    if (data->timer_ != nullptr && data->timer_->isActive())
+    {
+        QObject::connect(
+            data->timer_, &QTimer::timeout, worker, [reply, data]() {
+                qCDebug(chatterinoCommon) << "Aborted!";
+                qCDebug(chatterinoHTTP)
+                    << QString("%1 [timed out] %2")
+                           .arg(networkRequestTypes.at(int(data->requestType_)),
+                                data->request_.url().toString());
+
+                // The callbacks are run once the reply finishes
+                data->timedOut_ = true;
+                reply->abort();
+            });
+    }
+
+    if (data->onReplyCreated_)
+    {
+        data->onReplyCreated_(reply);
+    }
+
+    if (data->timer_ != nullptr)
+    {
+        QObject::connect(reply, &QNetworkReply::finished, data->timer_,
+                         &QObject::deleteLater);
+    }
+
+    QObject::connect(
+        reply, &QNetworkReply::finished, worker, [data, reply, worker]() {
+            auto error = reply->error();
             auto status =
                 reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
 
-            NetworkResult result(bytes, status.toInt());
-
-            DebugCount::increase("http request success");
-            // log("starting {}", data->request_.url().toString());
-            if (data->onSuccess_)
+            NetworkResult result(reply->readAll(), status.toInt());
+            if (data->timedOut_)
             {
-                if (data->executeConcurrently_)
-                    QtConcurrent::run([onSuccess = std::move(data->onSuccess_),
-                                       result = std::move(result)] {
-                        onSuccess(result);
-                    });
-                else
-                    data->onSuccess_(result);
+                result = NetworkResult({}, NetworkResult::timedoutStatus);
             }
-            // log("finished {}", data->request_.url().toString());
 
             reply->deleteLater();
+            worker->deleteLater();
 
-            if (data->requestType_ == NetworkRequestType::Get)
-            {
-                qCDebug(chatterinoHTTP)
-                    << QString("%1 %2 %3")
-                           .arg(networkRequestTypes.at(int(data->requestType_)),
-                                QString::number(status.toInt()),
-                                data->request_.url().toString());
-            }
-            else
-            {
-                qCDebug(chatterinoHTTP)
-                    << QString("%1 %3 %2 %4")
-                           .arg(networkRequestTypes.at(int(data->requestType_)),
-                                data->request_.url().toString(),
-                                QString::number(status.toInt()),
-                                QString(data->payload_));
-            }
-            if (data->finally_)
+            // Requests that were merged into this one get the same reply
+            auto requests = NetworkScheduler::instance().finish(data);
+            requests.insert(requests.begin(), data);
+
+            if (error == QNetworkReply::NetworkError::NoError)
             {
-                if (data->executeConcurrently_)
-                    QtConcurrent::run([finally = std::move(data->finally_)] {
-                        finally();
-                    });
-                else
-                    data->finally_();
+                for (const auto &request : requests)
+                {
+                    if (request->cache_)
+                    {
+                        writeToCache(request, result.getData());
+                        break;
+                    }
+                }
             }
-        };
 
-        if (data->timer_ != nullptr)
-        {
-            QObject::connect(reply, &QNetworkReply::finished, data->timer_,
-                             &QObject::deleteLater);
-        }
+            deliverReply(requests, error, result);
+        });
 
-        QObject::connect(
-            reply, &QNetworkReply::finished, worker,
-            [data, handleReply, worker]() mutable {
-                if (data->executeConcurrently_ || isGuiThread())
-                {
-                    handleReply();
-                    delete worker;
-                }
-                else
-                {
-                    postToThread(
-                        [worker, cb = std::move(handleReply)]() mutable {
-                            cb();
-                            delete worker;
-                        });
-                }
-            });
-    };
+    return true;
+}
 
-    QObject::connect(&requester, &NetworkRequester::requestUrl, worker,
-                     onUrlRequested);
+void failRequests(const std::vector<std::shared_ptr<NetworkData>> &requests)
+{
+    deliverReply(requests, QNetworkReply::NetworkError::UnknownNetworkError,
+                 NetworkResult({}, 0));
+}
 
-    emit requester.requestUrl();
+void loadUncached(const std::shared_ptr<NetworkData> &data)
+{
+    NetworkScheduler::instance().schedule(data);
 }
 
 // First tried to load cached, then uncached.
@@ -8,6 +8,7 @@
 #include <QTimer>
 #include <functional>
 #include <memory>
+#include <vector>
 
 class QNetworkReply;
 
@@ -15,14 +16,6 @@ namespace chatterino {
 
 class NetworkResult;
 
-class NetworkRequester : public QObject
-{
-    Q_OBJECT
-
-signals:
-    void requestUrl();
-};
-
 class NetworkWorker : public QObject
 {
     Q_OBJECT
@@ -40,6 +33,7 @@ struct NetworkData {
     QObjectRef<QObject> caller_;
     bool cache_{};
     bool executeConcurrently_{};
+    NetworkRequestPriority priority_ = NetworkRequestPriority::Interactive;
 
     NetworkReplyCreatedCallback onReplyCreated_;
     NetworkErrorCallback onError_;
@@ -59,8 +53,14 @@ struct NetworkData {
     bool hasTimeout_{};
     int timeoutMS_{};
     QTimer *timer_ = nullptr;
+    // Set on the worker thread when the timer above aborted the request
+    bool timedOut_{};
     QObject *lifetimeManager_;
 
+    // Set by NetworkScheduler, empty if the request can't be merged with
+    // identical ones
+    QString mergeKey_;
+
     QString getHash();
 
 private:
@@ -69,4 +69,12 @@ private:
 
 void load(const std::shared_ptr<NetworkData> &data);
 
+// Sends out the request. Must be called on the network worker thread.
+// Returns false if the request could not be started.
+bool startRequest(const std::shared_ptr<NetworkData> &data);
+
+// Runs the error callbacks of requests that could not be started. Must be
+// called on the network worker thread.
+void failRequests(const std::vector<std::shared_ptr<NetworkData>> &requests);
+
 }  // namespace chatterino
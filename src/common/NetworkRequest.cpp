@@ -6,7 +6,6 @@
 #include "debug/AssertInGuiThread.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
 #include "singletons/Paths.hpp"
-#include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
 
 #include <QDebug>
@@ -129,6 +128,12 @@ NetworkRequest NetworkRequest::concurrent() &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::priority(NetworkRequestPriority priority) &&
+{
+    this->data->priority_ = priority;
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::authorizeTwitchV5(const QString &clientID,
                                                  const QString &oauthToken) &&
 {
@@ -58,6 +58,8 @@ public:
         const std::vector<std::pair<QByteArray, QByteArray>> &headers) &&;
     NetworkRequest timeout(int ms) &&;
     NetworkRequest concurrent() &&;
+    /// Defaults to NetworkRequestPriority::Interactive
+    NetworkRequest priority(NetworkRequestPriority priority) &&;
     NetworkRequest authorizeTwitchV5(const QString &clientID,
                                      const QString &oauthToken = QString()) &&;
     NetworkRequest multiPart(QHttpMultiPart *payload) &&;
@@ -0,0 +1,269 @@
+#include "common/NetworkScheduler.hpp"
+
+#include "common/NetworkPrivate.hpp"
+#include "util/Metrics.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QCryptographicHash>
+
+#include <algorithm>
+#include <cassert>
+
+namespace chatterino {
+namespace {
+
+    // Same as the per-host connection limit of QNetworkAccessManager, so
+    // requests queue up with us (where they're prioritized) instead of in Qt
+    constexpr int MAX_REQUESTS_PER_HOST = 6;
+
+    // Returns the key identical requests share, or an empty string if the
+    // request can't be merged with others
+    QString mergeKey(const NetworkData &data)
+    {
+        if (data.requestType_ != NetworkRequestType::Get ||
+            data.multiPartPayload_ != nullptr || data.onReplyCreated_)
+        {
+            return {};
+        }
+
+        // Unlike NetworkData::getHash this includes the header values, so
+        // requests made with different credentials are never merged
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        hash.addData(data.request_.url().toString().toUtf8());
+        for (const auto &header : data.request_.rawHeaderList())
+        {
+            hash.addData(header + ':' + data.request_.rawHeader(header) +
+                         '\n');
+        }
+
+        // Merged requests share the timeout of the first one
+        return QString::fromLatin1(hash.result().toHex()) + ':' +
+               QString::number(data.hasTimeout_ ? data.timeoutMS_ : 0);
+    }
+
+}  // namespace
+
+NetworkScheduler &NetworkScheduler::instance()
+{
+    static auto *instance = new NetworkScheduler;
+
+    return *instance;
+}
+
+void NetworkScheduler::schedule(std::shared_ptr<NetworkData> data)
+{
+    postToThread(
+        [this, data = std::move(data)]() mutable {
+            this->enqueue(std::move(data));
+        },
+        this);
+}
+
+void NetworkScheduler::enqueue(std::shared_ptr<NetworkData> data)
+{
+    auto hostName = data->request_.url().host();
+
+    data->mergeKey_ = mergeKey(*data);
+    if (!data->mergeKey_.isEmpty())
+    {
+        auto it = this->merged_.find(data->mergeKey_);
+        if (it != this->merged_.end())
+        {
+            auto hostIt = this->hosts_.find(hostName);
+            if (hostIt != this->hosts_.end())
+            {
+                this->promote(hostIt->second, data->mergeKey_,
+                              data->priority_);
+            }
+
+            it->second.push_back(std::move(data));
+            static auto &httpRequestMerged =
+                Metrics::counter("http request merged");
+            httpRequestMerged.increase();
+            return;
+        }
+
+        this->merged_.try_emplace(data->mergeKey_);
+    }
+
+    this->hosts_[hostName].queued[size_t(data->priority_)].push_back(
+        std::move(data));
+    static auto &httpRequestQueued = Metrics::gauge("http request queued");
+    httpRequestQueued.increase();
+
+    this->startQueued(hostName);
+}
+
+std::vector<std::shared_ptr<NetworkData>> NetworkScheduler::finish(
+    const std::shared_ptr<NetworkData> &data)
+{
+    auto merged = this->takeMerged(*data);
+    this->release(data->request_.url().host());
+
+    return merged;
+}
+
+void NetworkScheduler::release(const QString &hostName)
+{
+    auto it = this->hosts_.find(hostName);
+    if (it == this->hosts_.end())
+    {
+        assert(false && "released request was never started");
+        return;
+    }
+
+    it->second.active--;
+    this->startQueued(hostName);
+}
+
+void NetworkScheduler::startQueued(const QString &hostName)
+{
+    auto it = this->hosts_.find(hostName);
+    if (it == this->hosts_.end())
+    {
+        return;
+    }
+
+    auto &host = it->second;
+    while (host.active < MAX_REQUESTS_PER_HOST)
+    {
+        auto data = this->takeNext(host);
+        if (!data)
+        {
+            break;
+        }
+
+        if (!data->hasCaller_)
+        {
+            if (this->start(data, false))
+            {
+                host.active++;
+            }
+            continue;
+        }
+
+        // Callers live on the GUI thread, so that's the only place we can
+        // tell whether they're still alive. The request keeps its slot while
+        // we wait for the answer.
+        host.active++;
+        postToThread([this, data] {
+            bool callerDead = !data->caller_.get();
+            postToThread(
+                [this, data, callerDead] {
+                    if (!this->start(data, callerDead))
+                    {
+                        this->release(data->request_.url().host());
+                    }
+                },
+                this);
+        });
+    }
+
+    if (host.active == 0)
+    {
+        // startQueued would have started something if anything was queued
+        this->hosts_.erase(it);
+    }
+}
+
+bool NetworkScheduler::start(const std::shared_ptr<NetworkData> &data,
+                             bool callerDead)
+{
+    if (callerDead)
+    {
+        auto it = this->merged_.find(data->mergeKey_);
+        // Requests merged into this one still need the response
+        if (it == this->merged_.end() || it->second.empty())
+        {
+            if (it != this->merged_.end())
+            {
+                this->merged_.erase(it);
+            }
+            static auto &httpRequestDropped =
+                Metrics::counter("http request dropped");
+            httpRequestDropped.increase();
+            return false;
+        }
+    }
+
+    if (startRequest(data))
+    {
+        return true;
+    }
+
+    // Nothing will ever finish this request, so let everyone waiting for it
+    // know
+    auto requests = this->takeMerged(*data);
+    requests.insert(requests.begin(), data);
+    failRequests(requests);
+
+    return false;
+}
+
+std::shared_ptr<NetworkData> NetworkScheduler::takeNext(Host &host)
+{
+    for (auto &queue : host.queued)
+    {
+        if (!queue.empty())
+        {
+            auto data = std::move(queue.front());
+            queue.pop_front();
+            static auto &httpRequestQueued =
+                Metrics::gauge("http request queued");
+            httpRequestQueued.decrease();
+
+            return data;
+        }
+    }
+
+    return nullptr;
+}
+
+void NetworkScheduler::promote(Host &host, const QString &key,
+                               NetworkRequestPriority priority)
+{
+    for (auto i = size_t(priority) + 1; i < PRIORITY_COUNT; i++)
+    {
+        auto &queue = host.queued[i];
+        auto it = std::find_if(queue.begin(), queue.end(),
+                               [&key](const auto &queued) {
+                                   return queued->mergeKey_ == key;
+                               });
+        if (it == queue.end())
+        {
+            continue;
+        }
+
+        auto data = std::move(*it);
+        queue.erase(it);
+        data->priority_ = priority;
+        host.queued[size_t(priority)].push_back(std::move(data));
+
+        static auto &httpRequestPromoted =
+            Metrics::counter("http request promoted");
+        httpRequestPromoted.increase();
+        return;
+    }
+}
+
+std::vector<std::shared_ptr<NetworkData>> NetworkScheduler::takeMerged(
+    const NetworkData &data)
+{
+    if (data.mergeKey_.isEmpty())
+    {
+        return {};
+    }
+
+    auto it = this->merged_.find(data.mergeKey_);
+    if (it == this->merged_.end())
+    {
+        return {};
+    }
+
+    auto merged = std::move(it->second);
+    this->merged_.erase(it);
+
+    return merged;
+}
+
+}  // namespace chatterino
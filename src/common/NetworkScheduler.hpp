@@ -0,0 +1,78 @@
+#pragma once
+
+#include "common/NetworkCommon.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QObject>
+#include <QString>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct NetworkData;
+
+// Decides when uncached requests are actually sent out.
+//
+// Every host only gets a limited amount of requests in flight at the same
+// time; everything above that is queued by priority. Queued requests whose
+// caller died are dropped before they start, and identical GET requests that
+// are queued or in flight are merged into a single request. A queued request
+// that a more urgent one was merged into takes over its priority.
+//
+// The scheduler lives on the network worker thread, all of its state is only
+// touched from there.
+class NetworkScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static NetworkScheduler &instance();
+
+    // Can be called from any thread
+    void schedule(std::shared_ptr<NetworkData> data);
+
+    // Must be called on the worker thread once the request for `data` has
+    // finished. Returns the requests that were merged into it, they should
+    // receive the same reply.
+    std::vector<std::shared_ptr<NetworkData>> finish(
+        const std::shared_ptr<NetworkData> &data);
+
+private:
+    NetworkScheduler() = default;
+
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    struct Host {
+        int active = 0;
+        // Indexed by NetworkRequestPriority
+        std::array<std::deque<std::shared_ptr<NetworkData>>, PRIORITY_COUNT>
+            queued;
+    };
+
+    void enqueue(std::shared_ptr<NetworkData> data);
+    // Frees the slot of a request of `hostName` that was started or dropped
+    void release(const QString &hostName);
+    void startQueued(const QString &hostName);
+    // Returns false if the request didn't start and doesn't occupy a slot
+    bool start(const std::shared_ptr<NetworkData> &data, bool callerDead);
+    std::shared_ptr<NetworkData> takeNext(Host &host);
+    // Moves the queued request with `key` up to `priority` if it's below that
+    void promote(Host &host, const QString &key,
+                 NetworkRequestPriority priority);
+    std::vector<std::shared_ptr<NetworkData>> takeMerged(
+        const NetworkData &data);
+
+    std::unordered_map<QString, Host> hosts_;
+    // Requests merged into an identical request that is queued or in flight.
+    // Having an entry here (even an empty one) means that such a request
+    // exists.
+    std::unordered_map<QString, std::vector<std::shared_ptr<NetworkData>>>
+        merged_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,145 @@
+#include "common/SnapshotStore.hpp"
+
+#include "common/QLogging.hpp"
+#include "singletons/Paths.hpp"
+#include "util/CombinePath.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QCborValue>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent>
+#include <boost/optional.hpp>
+
+namespace chatterino {
+namespace {
+
+    // Channel snapshots are kept in a directory per channel
+    const QString CHANNELS_DIRECTORY("channels");
+
+    QString snapshotPath(const QString &name)
+    {
+        return combinePath(getPaths()->snapshotDirectory, name + ".cbor");
+    }
+
+    boost::optional<QJsonValue> decode(const QString &path, const QString &name)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+        {
+            return boost::none;
+        }
+
+        // Map the file instead of reading it, the decoded value copies what it
+        // needs anyway
+        auto *data = file.map(0, file.size());
+        if (data == nullptr)
+        {
+            return boost::none;
+        }
+
+        QCborParserError error;
+        auto value = QCborValue::fromCbor(
+            QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                    int(file.size())),
+            &error);
+        auto json = value.toJsonValue();
+
+        file.unmap(data);
+
+        if (error.error != QCborError::NoError)
+        {
+            qCWarning(chatterinoCache) << "Discarding invalid snapshot" << name
+                                       << error.errorString();
+            file.remove();
+            return boost::none;
+        }
+
+        return json;
+    }
+
+}  // namespace
+
+SnapshotStore::Fresh SnapshotStore::makeFresh()
+{
+    return std::make_shared<std::atomic<bool>>(false);
+}
+
+void SnapshotStore::load(const QString &name, Fresh fresh,
+                         std::function<void(const QJsonValue &)> callback)
+{
+    QtConcurrent::run([path = snapshotPath(name), name,
+                       fresh = std::move(fresh),
+                       callback = std::move(callback)]() mutable {
+        auto snapshot = decode(path, name);
+        if (!snapshot || *fresh)
+        {
+            return;
+        }
+
+        postToThread([snapshot = std::move(*snapshot), fresh = std::move(fresh),
+                      callback = std::move(callback)] {
+            // The network response may have arrived while decoding
+            if (!*fresh)
+            {
+                callback(snapshot);
+            }
+        });
+    });
+}
+
+void SnapshotStore::save(const QString &name, const QJsonValue &payload)
+{
+    QtConcurrent::run([path = snapshotPath(name), name, payload] {
+        QDir().mkpath(QFileInfo(path).path());
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            qCWarning(chatterinoCache)
+                << "Failed to open snapshot" << name << file.errorString();
+            return;
+        }
+
+        file.write(QCborValue::fromJsonValue(payload).toCbor());
+
+        if (!file.commit())
+        {
+            qCWarning(chatterinoCache)
+                << "Failed to save snapshot" << name << file.errorString();
+        }
+    });
+}
+
+QString SnapshotStore::channelSnapshot(const QString &channelName,
+                                       const QString &name)
+{
+    return CHANNELS_DIRECTORY + "/" + channelName + "/" + name;
+}
+
+void SnapshotStore::pruneChannels(const QStringList &openChannels)
+{
+    QtConcurrent::run([directory = combinePath(getPaths()->snapshotDirectory,
+                                               CHANNELS_DIRECTORY),
+                       open = QSet<QString>(openChannels.begin(),
+                                            openChannels.end())] {
+        QDir channels(directory);
+        for (const auto &channelName :
+             channels.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+        {
+            if (open.contains(channelName))
+            {
+                continue;
+            }
+
+            qCDebug(chatterinoCache)
+                << "Removing snapshots of closed channel" << channelName;
+            QDir(channels.filePath(channelName)).removeRecursively();
+        }
+    });
+}
+
+}  // namespace chatterino
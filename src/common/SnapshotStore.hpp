@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace chatterino {
+
+// Binary snapshots of the payloads emote and badge providers loaded last.
+//
+// Providers apply their snapshot as soon as they start loading, so the first
+// messages already show emotes and badges, and replace it with the network
+// response once that arrives. Snapshots are stored as CBOR in
+// Paths::snapshotDirectory.
+class SnapshotStore
+{
+public:
+    // Set by the provider once it applied the network response
+    using Fresh = std::shared_ptr<std::atomic<bool>>;
+
+    static Fresh makeFresh();
+
+    // Decodes the payload last saved under `name` in the background and
+    // passes it to `callback` on the GUI thread. `callback` isn't called if
+    // there's no valid snapshot, or if `fresh` was set in the meantime.
+    static void load(const QString &name, Fresh fresh,
+                     std::function<void(const QJsonValue &)> callback);
+
+    // Saves `payload` under `name` in the background
+    static void save(const QString &name, const QJsonValue &payload);
+
+    // Name of the snapshot `name` of the channel `channelName`. These are
+    // deleted by pruneChannels once the channel isn't open anymore.
+    static QString channelSnapshot(const QString &channelName,
+                                   const QString &name);
+
+    // Deletes the snapshots of all channels that aren't in `openChannels` in
+    // the background
+    static void pruneChannels(const QStringList &openChannels);
+};
+
+}  // namespace chatterino
@@ -0,0 +1,80 @@
+#include "common/SymbolTable.hpp"
+
+#include "util/Metrics.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+namespace {
+
+    constexpr size_t MIN_PRUNE_SIZE = 16 * 1024;
+
+}  // namespace
+
+SymbolTable &SymbolTable::instance()
+{
+    static auto *instance = new SymbolTable;
+
+    return *instance;
+}
+
+QString SymbolTable::intern(const QString &string)
+{
+    if (string.isEmpty())
+    {
+        return string;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto it = this->strings_.find(string);
+    if (it != this->strings_.end())
+    {
+        return *it;
+    }
+
+    this->strings_.insert(string);
+    static auto &symbolTableStrings = Metrics::gauge("symbol table strings");
+    symbolTableStrings.increase();
+
+    if (this->strings_.size() >= std::max(this->pruneAt_, MIN_PRUNE_SIZE))
+    {
+        this->prune();
+    }
+
+    return string;
+}
+
+size_t SymbolTable::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->strings_.size();
+}
+
+void SymbolTable::prune()
+{
+    auto sizeBefore = this->strings_.size();
+
+    for (auto it = this->strings_.begin(); it != this->strings_.end();)
+    {
+        // Only our copy is left
+        if (it->isDetached())
+        {
+            it = this->strings_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    static auto &symbolTableStrings = Metrics::gauge("symbol table strings");
+    symbolTableStrings.decrease(sizeBefore - this->strings_.size());
+
+    // Wait until the table doubled before pruning again, so interning stays
+    // cheap when most strings are still in use
+    this->pruneAt_ = this->strings_.size() * 2;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace chatterino {
+
+// Global table of interned strings.
+//
+// QString is implicitly shared, so handing out the table's copy of a string
+// makes every equal string share a single buffer. This is used for the names
+// repeated across thousands of messages, like channel, user and badge names.
+//
+// Strings nobody else holds anymore are pruned once the table has grown
+// enough, so interning user names doesn't leak over long sessions.
+class SymbolTable
+{
+public:
+    static SymbolTable &instance();
+
+    // Can be called from any thread
+    QString intern(const QString &string);
+    size_t size() const;
+
+private:
+    SymbolTable() = default;
+
+    void prune();
+
+    mutable std::mutex mutex_;
+    std::unordered_set<QString> strings_;
+    size_t pruneAt_ = 0;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "util/Metrics.hpp"
+
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+// Interns values by key without keeping them alive, e.g. so every message
+// showing the same emote shares one Image.
+//
+// Keys are spread over shards with their own lock, so lookups from different
+// threads rarely wait for each other. Entries whose value is gone are swept
+// out of a shard once it has doubled in size since its last sweep, which keeps
+// the dead entries proportional to the live ones at an amortized constant
+// cost per insert.
+//
+// The number of entries and swept entries are reported as the metrics
+// "<name> entries" and "<name> swept".
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>>
+class WeakRegistry : boost::noncopyable
+{
+public:
+    explicit WeakRegistry(const QString &name)
+        : entries_(Metrics::gauge(name + " entries"))
+        , swept_(Metrics::counter(name + " swept"))
+    {
+    }
+
+    ~WeakRegistry()
+    {
+        this->entries_.decrease(int64_t(this->size()));
+    }
+
+    // Returns the value registered for `key` if it's still alive. Otherwise
+    // registers and returns the value returned by `make`.
+    template <typename TMake>
+    std::shared_ptr<TValue> getOrCreate(const TKey &key, TMake &&make)
+    {
+        return this->getOrCreate(key, std::forward<TMake>(make),
+                                 [](const TValue &) {
+                                     return true;
+                                 });
+    }
+
+    // Same as above, but a live value is only returned if `reuse` returns
+    // true for it. Otherwise it's replaced by the value from `make`.
+    //
+    // Both are called with the shard locked and must not use this registry.
+    template <typename TMake, typename TReuse>
+    std::shared_ptr<TValue> getOrCreate(const TKey &key, TMake &&make,
+                                        TReuse &&reuse)
+    {
+        auto &shard = this->shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto [it, inserted] = shard.map.try_emplace(key);
+        if (inserted)
+        {
+            this->entries_.increase();
+        }
+        else
+        {
+            auto shared = it->second.lock();
+            if (shared && reuse(*shared))
+            {
+                return shared;
+            }
+        }
+
+        std::shared_ptr<TValue> shared = make();
+        it->second = shared;
+
+        if (inserted)
+        {
+            this->sweepIfNeeded(shard);
+        }
+
+        return shared;
+    }
+
+    // Returns the value registered for `key` if it's still alive
+    std::shared_ptr<TValue> get(const TKey &key)
+    {
+        auto &shard = this->shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.map.find(key);
+        if (it == shard.map.end())
+        {
+            return nullptr;
+        }
+
+        return it->second.lock();
+    }
+
+    // Removes all entries whose value is gone
+    void sweep()
+    {
+        for (auto &shard : this->shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            this->sweepShard(shard);
+        }
+    }
+
+    // Number of entries, including the ones that weren't swept yet
+    size_t size() const
+    {
+        size_t size = 0;
+        for (const auto &shard : this->shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            size += shard.map.size();
+        }
+
+        return size;
+    }
+
+private:
+    static constexpr size_t shardCount = 16;
+    static constexpr size_t minSweepSize = 64;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<TKey, std::weak_ptr<TValue>, THash> map;
+        size_t nextSweep = minSweepSize;
+    };
+
+    Shard &shardFor(const TKey &key)
+    {
+        // The map buckets use the low bits of the hash as well
+        auto hash = THash{}(key);
+        return this->shards_[(hash ^ (hash >> 16)) % shardCount];
+    }
+
+    void sweepIfNeeded(Shard &shard)
+    {
+        if (shard.map.size() >= shard.nextSweep)
+        {
+            this->sweepShard(shard);
+        }
+    }
+
+    void sweepShard(Shard &shard)
+    {
+        auto before = shard.map.size();
+
+        for (auto it = shard.map.begin(); it != shard.map.end();)
+        {
+            if (it->second.expired())
+            {
+                it = shard.map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        auto removed = before - shard.map.size();
+        this->entries_.decrease(int64_t(removed));
+        this->swept_.increase(int64_t(removed));
+
+        shard.nextSweep = std::max(minSweepSize, shard.map.size() * 2);
+    }
+
+    Metric &entries_;
+    Metric &swept_;
+    std::array<Shard, shardCount> shards_;
+};
+
+}  // namespace chatterino
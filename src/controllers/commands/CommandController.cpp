@@ -9,6 +9,7 @@
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
+#include "providers/twitch/PubsubClient.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "singletons/Emotes.hpp"
@@ -999,6 +1000,31 @@ void CommandController::initialize(Settings &, Paths &paths)
             return "";
         });
 
+    this->registerCommand(
+        "/debug-pubsub", [](const auto & /*words*/, auto channel) {
+            auto stats = getApp()->twitch2->pubsub->getConnectionStats();
+
+            QStringList connections;
+            for (size_t i = 0; i < stats.size(); i++)
+            {
+                auto latency =
+                    stats[i].latency
+                        ? QString("%1 ms").arg(stats[i].latency->count())
+                        : QString("no ping yet");
+                connections.append(QString("#%1: %2 topics, %3")
+                                       .arg(i + 1)
+                                       .arg(stats[i].topics)
+                                       .arg(latency));
+            }
+
+            channel->addMessage(makeSystemMessage(
+                QString("%1 PubSub connections. %2")
+                    .arg(stats.size())
+                    .arg(connections.join(", "))));
+
+            return "";
+        });
+
     this->registerCommand("/uptime", [](const auto & /*words*/, auto channel) {
         auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
         if (twitchChannel == nullptr)
@@ -59,9 +59,10 @@ ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
             continue;
         }
         subscribed = true;
-        if (m->badgeInfos.find(subBadge) != m->badgeInfos.end())
+        auto badgeInfo = m->getBadgeInfo(subBadge);
+        if (!badgeInfo.isEmpty())
         {
-            subLength = m->badgeInfos.at(subBadge).toInt();
+            subLength = badgeInfo.toInt();
         }
     }
     ContextMap vars = {
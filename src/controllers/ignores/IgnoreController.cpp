@@ -1,6 +1,7 @@
 #include "controllers/ignores/IgnoreController.hpp"
 
 #include "common/QLogging.hpp"
+#include "controllers/ignores/IgnoreEngine.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "singletons/Settings.hpp"
 
@@ -10,17 +11,13 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
 {
     if (!params.message.isEmpty())
     {
-        // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getCSettings().ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        auto engine = IgnoreEngine::current();
+        if (const auto *phrase = engine->findBlock(params.message))
         {
-            if (phrase.isBlock() && phrase.isMatch(params.message))
-            {
-                qCDebug(chatterinoMessage)
-                    << "Blocking message because it contains ignored phrase"
-                    << phrase.getPattern();
-                return true;
-            }
+            qCDebug(chatterinoMessage)
+                << "Blocking message because it contains ignored phrase"
+                << phrase->getPattern();
+            return true;
         }
     }
 
@@ -0,0 +1,324 @@
+#include "controllers/ignores/IgnoreEngine.hpp"
+
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "singletons/Settings.hpp"
+#include "util/Metrics.hpp"
+
+#include <cassert>
+#include <mutex>
+
+namespace chatterino {
+
+namespace {
+
+    QRegularExpression::PatternOptions patternOptions(bool caseSensitive)
+    {
+        if (caseSensitive)
+        {
+            return QRegularExpression::UseUnicodePropertiesOption;
+        }
+
+        return QRegularExpression::CaseInsensitiveOption |
+               QRegularExpression::UseUnicodePropertiesOption;
+    }
+
+    // Plain phrases are matched like regex phrases, with their pattern
+    // escaped
+    QString regexPattern(const IgnorePhrase &phrase)
+    {
+        if (phrase.isRegex())
+        {
+            return phrase.getPattern();
+        }
+
+        return QRegularExpression::escape(phrase.getPattern());
+    }
+
+    // Expands the \N references in the replacement of a regex phrase like
+    // QString::replace(QRegularExpression, QString) does. \0 is the whole
+    // match.
+    QString expandReplacement(const QString &replace,
+                              const QRegularExpressionMatch &match,
+                              int captureCount)
+    {
+        QString result;
+
+        for (int i = 0; i < replace.size(); i++)
+        {
+            auto group =
+                i + 1 < replace.size() ? replace[i + 1].digitValue() : -1;
+            if (replace[i] != '\\' || group < 0 || group > captureCount)
+            {
+                result += replace[i];
+                continue;
+            }
+            i++;
+
+            // Two digits are only used if there's a group with that number
+            if (i + 1 < replace.size())
+            {
+                auto second = replace[i + 1].digitValue();
+                if (second >= 0 && group * 10 + second <= captureCount)
+                {
+                    group = group * 10 + second;
+                    i++;
+                }
+            }
+
+            result += match.captured(group);
+        }
+
+        return result;
+    }
+
+}  // namespace
+
+IgnoreEngine::IgnoreEngine(
+    std::shared_ptr<const std::vector<IgnorePhrase>> phrases)
+    : phrases_(std::move(phrases))
+    , blockMatchers_(compile(*this->phrases_, true))
+    , replaceMatchers_(compile(*this->phrases_, false))
+{
+}
+
+std::shared_ptr<const IgnoreEngine> IgnoreEngine::current()
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const IgnoreEngine> engine;
+
+    // SignalVector replaces the vector every time it changes
+    auto phrases = getCSettings().ignoredMessages.readOnly();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!engine || engine->phrases_ != phrases)
+    {
+        engine = std::make_shared<IgnoreEngine>(std::move(phrases));
+
+        static auto &ignoreEngineCompiles =
+            Metrics::counter("ignore engine compiles");
+        ignoreEngineCompiles.increase();
+    }
+
+    return engine;
+}
+
+std::vector<IgnoreEngine::Matcher> IgnoreEngine::compile(
+    const std::vector<IgnorePhrase> &phrases, bool block)
+{
+    std::vector<Matcher> matchers;
+
+    QString combinedPattern;
+    std::vector<size_t> combinedPhrases;
+
+    for (size_t i = 0; i < phrases.size(); i++)
+    {
+        const auto &phrase = phrases[i];
+        if (phrase.isBlock() != block || phrase.getPattern().isEmpty())
+        {
+            continue;
+        }
+
+        if (phrase.isRegex())
+        {
+            if (!phrase.isRegexValid())
+            {
+                continue;
+            }
+
+            // Empty matches are skipped, but inside the combined pattern they
+            // would hide the phrases after them
+            if (phrase.getRegex().captureCount() > 0 ||
+                phrase.getRegex().match(QString()).hasMatch())
+            {
+                matchers.push_back({phrase.getRegex(), {i}, false});
+                continue;
+            }
+        }
+
+        if (!combinedPattern.isEmpty())
+        {
+            combinedPattern += '|';
+        }
+        // Inline options only apply until the end of the group
+        combinedPattern += phrase.isCaseSensitive() ? "(" : "((?i)";
+        combinedPattern += regexPattern(phrase);
+        combinedPattern += ')';
+
+        combinedPhrases.push_back(i);
+    }
+
+    if (combinedPhrases.empty())
+    {
+        return matchers;
+    }
+
+    QRegularExpression combined(combinedPattern, patternOptions(true));
+    if (combined.isValid())
+    {
+        combined.optimize();
+        matchers.push_back({combined, std::move(combinedPhrases), true});
+        return matchers;
+    }
+
+    // A pattern that's valid on its own can still break the combined one,
+    // e.g. by leaving a \Q open
+    for (auto i : combinedPhrases)
+    {
+        const auto &phrase = phrases[i];
+        matchers.push_back({QRegularExpression(
+                                regexPattern(phrase),
+                                patternOptions(phrase.isCaseSensitive())),
+                            {i},
+                            false});
+    }
+
+    return matchers;
+}
+
+size_t IgnoreEngine::phraseOf(const Matcher &matcher,
+                              const QRegularExpressionMatch &match)
+{
+    if (!matcher.combined)
+    {
+        return matcher.phrases.front();
+    }
+
+    // Only the group of the alternative that matched captured anything
+    auto group = match.lastCapturedIndex();
+    assert(group >= 1 && size_t(group) <= matcher.phrases.size());
+
+    return matcher.phrases[size_t(group) - 1];
+}
+
+const IgnorePhrase *IgnoreEngine::findBlock(const QString &text) const
+{
+    for (const auto &matcher : this->blockMatchers_)
+    {
+        auto match = matcher.regex.match(text);
+        if (match.hasMatch())
+        {
+            return &(*this->phrases_)[phraseOf(matcher, match)];
+        }
+    }
+
+    return nullptr;
+}
+
+IgnoreEngine::ReplaceResult IgnoreEngine::replace(const QString &text) const
+{
+    ReplaceResult result;
+
+    if (this->replaceMatchers_.empty())
+    {
+        result.text = text;
+        return result;
+    }
+
+    // The next match of every matcher at or after `position`
+    struct Cursor {
+        QRegularExpressionMatch match;
+        // -1 once the matcher is exhausted
+        int start = -1;
+        size_t phrase = 0;
+    };
+    std::vector<Cursor> cursors(this->replaceMatchers_.size());
+
+    auto advance = [&](size_t i, int from) {
+        const auto &matcher = this->replaceMatchers_[i];
+        auto &cursor = cursors[i];
+
+        while (from <= text.size())
+        {
+            cursor.match = matcher.regex.match(text, from);
+            if (!cursor.match.hasMatch())
+            {
+                break;
+            }
+
+            // Empty matches can't be replaced, look past them
+            if (cursor.match.capturedLength() == 0)
+            {
+                from = cursor.match.capturedStart() + 1;
+                continue;
+            }
+
+            cursor.start = cursor.match.capturedStart();
+            cursor.phrase = phraseOf(matcher, cursor.match);
+            return;
+        }
+
+        cursor.start = -1;
+    };
+
+    for (size_t i = 0; i < cursors.size(); i++)
+    {
+        advance(i, 0);
+    }
+
+    int position = 0;
+    while (true)
+    {
+        const Cursor *next = nullptr;
+        for (const auto &cursor : cursors)
+        {
+            if (cursor.start == -1)
+            {
+                continue;
+            }
+
+            if (next == nullptr || cursor.start < next->start ||
+                (cursor.start == next->start && cursor.phrase < next->phrase))
+            {
+                next = &cursor;
+            }
+        }
+
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        const auto &phrase = (*this->phrases_)[next->phrase];
+        auto from = next->start;
+        auto length = next->match.capturedLength();
+
+        QString replacement;
+        if (phrase.isRegex())
+        {
+            // Lets the replacement refer to the phrase's capture groups. The
+            // match was made against the whole text, so lookarounds and
+            // anchors behave like they do when the phrase is used on its own.
+            // Phrases in combined matchers don't have capture groups, the
+            // whole match is still group 0.
+            replacement = expandReplacement(phrase.getReplace(), next->match,
+                                            phrase.getRegex().captureCount());
+        }
+        else
+        {
+            replacement = phrase.getReplace();
+        }
+
+        result.text += text.midRef(position, from - position);
+        result.replacements.push_back({from, length, result.text.size(),
+                                       replacement.size(), &phrase});
+        result.text += replacement;
+
+        position = from + length;
+
+        // Matches that started inside the replaced text are gone
+        for (size_t i = 0; i < cursors.size(); i++)
+        {
+            if (cursors[i].start != -1 && cursors[i].start < position)
+            {
+                advance(i, position);
+            }
+        }
+    }
+
+    result.text += text.midRef(position);
+
+    return result;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class IgnorePhrase;
+
+// The ignored phrases compiled for matching many messages.
+//
+// Phrases are combined into as few regular expressions as possible, so a
+// message is searched once for all of them instead of once per phrase. Regex
+// phrases with capture groups keep their own expression, since combining them
+// would renumber their groups, as do ones that can match nothing.
+class IgnoreEngine
+{
+public:
+    struct Replacement {
+        // Match in the original text
+        int from;
+        int length;
+        // Replacement in the resulting text
+        int outputFrom;
+        int outputLength;
+
+        const IgnorePhrase *phrase;
+    };
+
+    struct ReplaceResult {
+        QString text;
+        // Ordered by position, never overlapping
+        std::vector<Replacement> replacements;
+    };
+
+    explicit IgnoreEngine(
+        std::shared_ptr<const std::vector<IgnorePhrase>> phrases);
+
+    // Returns the engine for the current ignored phrases. It's only compiled
+    // again after the phrases changed. Can be called from any thread.
+    static std::shared_ptr<const IgnoreEngine> current();
+
+    // Returns the first block phrase that matches `text`, or nullptr
+    const IgnorePhrase *findBlock(const QString &text) const;
+
+    // Runs all replace phrases over `text` in a single pass from left to
+    // right. Where matches overlap, the one that starts first wins, then the
+    // phrase that comes first. Replaced text isn't searched again.
+    ReplaceResult replace(const QString &text) const;
+
+private:
+    struct Matcher {
+        QRegularExpression regex;
+        // Indices into phrases_. For combined matchers, the phrase at i
+        // matched if capture group i + 1 did.
+        std::vector<size_t> phrases;
+        bool combined;
+    };
+
+    static std::vector<Matcher> compile(
+        const std::vector<IgnorePhrase> &phrases, bool block);
+
+    // Index of the phrase that produced `match`
+    static size_t phraseOf(const Matcher &matcher,
+                           const QRegularExpressionMatch &match);
+
+    std::shared_ptr<const std::vector<IgnorePhrase>> phrases_;
+    std::vector<Matcher> blockMatchers_;
+    std::vector<Matcher> replaceMatchers_;
+};
+
+}  // namespace chatterino
@@ -25,25 +25,18 @@ EmotePtr cachedOrMakeEmotePtr(Emote &&emote, const EmoteMap &cache)
     return std::make_shared<Emote>(std::move(emote));
 }
 
-EmotePtr cachedOrMakeEmotePtr(
-    Emote &&emote,
-    std::unordered_map<EmoteId, std::weak_ptr<const Emote>> &cache,
-    std::mutex &mutex, const EmoteId &id)
+EmotePtr cachedOrMakeEmotePtr(Emote &&emote, WeakEmoteIdRegistry &registry,
+                              const EmoteId &id)
 {
-    std::lock_guard<std::mutex> guard(mutex);
-
-    auto shared = cache[id].lock();
-    if (shared && *shared == emote)
-    {
-        // reuse old shared_ptr if nothing changed
-        return shared;
-    }
-    else
-    {
-        shared = std::make_shared<Emote>(std::move(emote));
-        cache[id] = shared;
-        return shared;
-    }
+    return registry.getOrCreate(
+        id,
+        [&] {
+            return std::make_shared<const Emote>(std::move(emote));
+        },
+        [&](const Emote &existing) {
+            // reuse old shared_ptr if nothing changed
+            return existing == emote;
+        });
 }
 
 }  // namespace chatterino
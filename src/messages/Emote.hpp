@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/WeakRegistry.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
 
@@ -33,12 +34,10 @@ class EmoteMap : public std::unordered_map<EmoteName, EmotePtr>
 };
 using EmoteIdMap = std::unordered_map<EmoteId, EmotePtr>;
 using WeakEmoteMap = std::unordered_map<EmoteName, std::weak_ptr<const Emote>>;
-using WeakEmoteIdMap = std::unordered_map<EmoteId, std::weak_ptr<const Emote>>;
+using WeakEmoteIdRegistry = WeakRegistry<EmoteId, const Emote>;
 
 EmotePtr cachedOrMakeEmotePtr(Emote &&emote, const EmoteMap &cache);
-EmotePtr cachedOrMakeEmotePtr(
-    Emote &&emote,
-    std::unordered_map<EmoteId, std::weak_ptr<const Emote>> &cache,
-    std::mutex &mutex, const EmoteId &id);
+EmotePtr cachedOrMakeEmotePtr(Emote &&emote, WeakEmoteIdRegistry &registry,
+                              const EmoteId &id);
 
 }  // namespace chatterino
@@ -13,16 +13,18 @@
 #include "common/Common.hpp"
 #include "common/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
+#include "common/WeakRegistry.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "debug/Benchmark.hpp"
+#include "messages/layouts/MessageLayout.hpp"
 #ifndef CHATTERINO_TEST
 #    include "singletons/Emotes.hpp"
 #endif
 #include "singletons/WindowManager.hpp"
-#include "singletons/helper/GifTimer.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 #include "util/PostToThread.hpp"
 
+#include <algorithm>
 #include <queue>
 
 namespace chatterino {
@@ -30,88 +32,66 @@ namespace detail {
     // Frames
     Frames::Frames()
     {
-        DebugCount::increase("images");
+        static auto &images = Metrics::gauge("images");
+        images.increase();
     }
 
     Frames::Frames(const QVector<Frame<QPixmap>> &frames)
         : items_(frames)
     {
         assertInGuiThread();
-        DebugCount::increase("images");
+        static auto &images = Metrics::gauge("images");
+        images.increase();
 
         if (this->animated())
         {
-            DebugCount::increase("animated images");
+            static auto &animatedImages = Metrics::gauge("animated images");
+            animatedImages.increase();
 
-#ifndef CHATTERINO_TEST
-            this->gifTimerConnection_ =
-                getApp()->emotes->gifTimer.signal.connect([this] {
-                    this->advance();
-                });
-#endif
-        }
-
-        auto totalLength =
-            std::accumulate(this->items_.begin(), this->items_.end(), 0UL,
-                            [](auto init, auto &&frame) {
-                                return init + frame.duration;
-                            });
-
-        if (totalLength == 0)
-        {
-            this->durationOffset_ = 0;
-        }
-        else
-        {
-#ifndef CHATTERINO_TEST
-            this->durationOffset_ = std::min<int>(
-                int(getApp()->emotes->gifTimer.position() % totalLength),
-                60000);
-#endif
+            int end = 0;
+            this->frameEnds_.reserve(this->items_.size());
+            for (const auto &frame : this->items_)
+            {
+                end += frame.duration;
+                this->frameEnds_.push_back(end);
+            }
         }
-        this->processOffset();
     }
 
     Frames::~Frames()
     {
         assertInGuiThread();
-        DebugCount::decrease("images");
+        static auto &images = Metrics::gauge("images");
+        images.decrease();
 
         if (this->animated())
         {
-            DebugCount::decrease("animated images");
+            static auto &animatedImages = Metrics::gauge("animated images");
+            animatedImages.decrease();
         }
-
-        this->gifTimerConnection_.disconnect();
     }
 
-    void Frames::advance()
+    int Frames::currentIndex() const
     {
-        this->durationOffset_ += gifFrameLength;
-        this->processOffset();
-    }
-
-    void Frames::processOffset()
-    {
-        if (this->items_.isEmpty())
+        if (this->frameEnds_.empty() || this->frameEnds_.back() <= 0)
         {
-            return;
+            return 0;
         }
 
-        while (true)
-        {
-            this->index_ %= this->items_.size();
-
-            if (this->durationOffset_ > this->items_[this->index_].duration)
-            {
-                this->durationOffset_ -= this->items_[this->index_].duration;
-                this->index_ = (this->index_ + 1) % this->items_.size();
-            }
-            else
-            {
-                break;
-            }
-        }
+#ifndef CHATTERINO_TEST
+        // All animations run off the same clock, so the same emote is in sync
+        // wherever it's shown
+        auto offset = int(getApp()->emotes->gifTimer.position() %
+                          this->frameEnds_.back());
+
+        auto it = std::upper_bound(this->frameEnds_.begin(),
+                                   this->frameEnds_.end(), offset);
+
+        return std::min(int(it - this->frameEnds_.begin()),
+                        int(this->items_.size()) - 1);
+#else
+        return 0;
+#endif
     }
 
     bool Frames::animated() const
@@ -123,7 +103,7 @@ namespace detail {
     {
         if (this->items_.size() == 0)
             return boost::none;
-        return this->items_[this->index_].image;
+        return this->items_[this->currentIndex()].image;
     }
 
     boost::optional<QPixmap> Frames::first() const
@@ -136,6 +116,9 @@ namespace detail {
     // functions
     QVector<Frame<QImage>> readFrames(QImageReader &reader, const Url &url)
     {
+        static auto &imageDecode = Metrics::histogram("image decode");
+        MetricTimer timer(imageDecode);
+
         QVector<Frame<QImage>> frames;
 
         if (reader.imageCount() == 0)
@@ -192,7 +175,8 @@ namespace detail {
         }
 
 #ifndef CHATTERINO_TEST
-        getApp()->windows->forceLayoutChannelViews();
+        // Only the layouts that were waiting for these images are redone
+        getApp()->windows->layoutChannelViews();
 #endif
         loadedEventQueued = false;
     }
@@ -254,19 +238,11 @@ Image::~Image()
 
 ImagePtr Image::fromUrl(const Url &url, qreal scale)
 {
-    static std::unordered_map<Url, std::weak_ptr<Image>> cache;
-    static std::mutex mutex;
+    static WeakRegistry<Url, Image> registry("image registry");
 
-    std::lock_guard<std::mutex> lock(mutex);
-
-    auto shared = cache[url].lock();
-
-    if (!shared)
-    {
-        cache[url] = shared = ImagePtr(new Image(url, scale));
-    }
-
-    return shared;
+    return registry.getOrCreate(url, [&] {
+        return ImagePtr(new Image(url, scale));
+    });
 }
 
 ImagePtr Image::fromPixmap(const QPixmap &pixmap, qreal scale)
@@ -306,8 +282,9 @@ Image::Image(qreal scale)
 void Image::setPixmap(const QPixmap &pixmap)
 {
     auto setFrames = [shared = this->shared_from_this(), pixmap]() {
-        shared->frames_ = std::make_unique<detail::Frames>(
-            QVector<detail::Frame<QPixmap>>{detail::Frame<QPixmap>{pixmap, 1}});
+        shared->setFrames(
+            std::make_unique<detail::Frames>(QVector<detail::Frame<QPixmap>>{
+                detail::Frame<QPixmap>{pixmap, 1}}));
     };
 
     if (isGuiThread())
@@ -320,6 +297,49 @@ void Image::setPixmap(const QPixmap &pixmap)
     }
 }
 
+void Image::setFrames(std::unique_ptr<detail::Frames> frames)
+{
+    assertInGuiThread();
+
+    this->frames_ = std::move(frames);
+
+    for (const auto &weak : this->pendingLayouts_)
+    {
+        if (auto layout = weak.lock())
+        {
+            layout->flags.set(MessageLayoutFlag::RequiresLayout);
+        }
+    }
+    this->pendingLayouts_.clear();
+    this->pendingLayoutsPruneSize_ = 16;
+}
+
+void Image::addPendingLayout(std::weak_ptr<MessageLayout> layout)
+{
+    assertInGuiThread();
+
+    if (layout.expired())
+    {
+        return;
+    }
+
+    // Layouts that are gone by now don't need to be updated anymore
+    if (this->pendingLayouts_.size() >= this->pendingLayoutsPruneSize_)
+    {
+        this->pendingLayouts_.erase(
+            std::remove_if(this->pendingLayouts_.begin(),
+                           this->pendingLayouts_.end(),
+                           [](const auto &weak) {
+                               return weak.expired();
+                           }),
+            this->pendingLayouts_.end());
+        this->pendingLayoutsPruneSize_ =
+            std::max<size_t>(16, this->pendingLayouts_.size() * 2);
+    }
+
+    this->pendingLayouts_.push_back(std::move(layout));
+}
+
 const Url &Image::url() const
 {
     return this->url_;
@@ -394,6 +414,7 @@ void Image::actuallyLoad()
     NetworkRequest(this->url().string)
         .concurrent()
         .cache()
+        .priority(NetworkRequestPriority::Image)
         .onSuccess([weak = weakOf(this)](auto result) -> Outcome {
             auto shared = weak.lock();
             if (!shared)
@@ -420,7 +441,8 @@ void Image::actuallyLoad()
 
             postToThread(makeConvertCallback(parsed, [weak](auto frames) {
                 if (auto shared = weak.lock())
-                    shared->frames_ = std::make_unique<detail::Frames>(frames);
+                    shared->setFrames(
+                        std::make_unique<detail::Frames>(frames));
             }));
 
             return Success;
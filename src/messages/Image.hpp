@@ -10,6 +10,7 @@
 #include <boost/variant.hpp>
 #include <memory>
 #include <mutex>
+#include <vector>
 #include <pajlada/signals/signal.hpp>
 
 #include "common/Aliases.hpp"
@@ -30,21 +31,22 @@ namespace detail {
         ~Frames();
 
         bool animated() const;
-        void advance();
         boost::optional<QPixmap> current() const;
         boost::optional<QPixmap> first() const;
 
     private:
-        void processOffset();
+        int currentIndex() const;
+
         QVector<Frame<QPixmap>> items_;
-        int index_{0};
-        int durationOffset_{0};
-        pajlada::Signals::Connection gifTimerConnection_;
+        // Time at which each frame ends, relative to the start of the
+        // animation
+        std::vector<int> frameEnds_;
     };
 }  // namespace detail
 
 class Image;
 using ImagePtr = std::shared_ptr<Image>;
+class MessageLayout;
 
 /// This class is thread safe.
 class Image : public std::enable_shared_from_this<Image>, boost::noncopyable
@@ -70,6 +72,10 @@ public:
     int height() const;
     bool animated() const;
 
+    // Makes the layout redo its layout once the image has been loaded, until
+    // then it only reserves placeholder space for the image
+    void addPendingLayout(std::weak_ptr<MessageLayout> layout);
+
     bool operator==(const Image &image) const;
     bool operator!=(const Image &image) const;
 
@@ -79,6 +85,7 @@ private:
     Image(qreal scale);
 
     void setPixmap(const QPixmap &pixmap);
+    void setFrames(std::unique_ptr<detail::Frames> frames);
     void actuallyLoad();
 
     const Url url_{};
@@ -88,5 +95,7 @@ private:
     // gui thread only
     bool shouldLoad_{false};
     std::unique_ptr<detail::Frames> frames_{};
+    std::vector<std::weak_ptr<MessageLayout>> pendingLayouts_;
+    size_t pendingLayoutsPruneSize_{16};
 };
 }  // namespace chatterino
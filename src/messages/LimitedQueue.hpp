@@ -4,6 +4,7 @@
 
 #include <QDebug>
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -22,6 +23,8 @@ namespace chatterino {
 //   trying to add messages to the start when it's full will not add them
 // - you are able to get a "Snapshot" which captures the state of this object
 // - adding items to this class does not change the "items" of the snapshot
+// - the limit can be raised up to 'maxLimit' to make space at the start with
+//   grow(), shrink() lowers it back to 'limit' one item at a time
 //
 
 template <typename T>
@@ -32,8 +35,10 @@ protected:
     using ChunkVector = std::vector<std::shared_ptr<Chunk>>;
 
 public:
-    LimitedQueue(size_t limit = 1000)
+    LimitedQueue(size_t limit = 1000, size_t maxLimit = 0)
         : limit_(limit)
+        , baseLimit_(limit)
+        , maxLimit_(std::max(limit, maxLimit))
     {
         this->clear();
     }
@@ -42,6 +47,7 @@ public:
     {
         std::lock_guard<std::mutex> lock(this->mutex_);
 
+        this->limit_ = this->baseLimit_;
         this->chunks_ = std::make_shared<ChunkVector>();
         auto chunk = std::make_shared<Chunk>();
         chunk->resize(this->chunkSize_);
@@ -135,6 +141,40 @@ public:
         return acceptedItems;
     }
 
+    // raises the limit so `count` more items fit, up to maxLimit
+    void grow(size_t count)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto size = this->limit_ - this->space();
+        this->limit_ = std::min(this->maxLimit_,
+                                std::max(this->limit_, size + count));
+    }
+
+    // returns the number of items that fit after growing as far as possible
+    size_t spaceToGrow() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        return this->maxLimit_ - (this->limit_ - this->space());
+    }
+
+    // lowers a raised limit by one, return true if an item was deleted
+    // deleted will be set if the item was deleted
+    bool shrink(T &deleted)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        if (this->limit_ <= this->baseLimit_)
+        {
+            return false;
+        }
+
+        this->limit_--;
+
+        return this->deleteFirstItem(deleted);
+    }
+
     // replace an single item, return index if successful, -1 if unsuccessful
     int replaceItem(const T &item, const T &replacement)
     {
@@ -285,11 +325,13 @@ private:
     }
 
     std::shared_ptr<ChunkVector> chunks_;
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
 
     size_t firstChunkOffset_;
     size_t lastChunkEnd_;
-    const size_t limit_;
+    size_t limit_;
+    const size_t baseLimit_;
+    const size_t maxLimit_;
 
     const size_t chunkSize_ = 100;
 };
@@ -4,22 +4,36 @@
 #include "MessageElement.hpp"
 #include "providers/twitch/PubsubActions.hpp"
 #include "singletons/Theme.hpp"
-#include "util/DebugCount.hpp"
 #include "util/IrcHelpers.hpp"
+#include "util/Metrics.hpp"
 
 using SBHighlight = chatterino::ScrollbarHighlight;
 
 namespace chatterino {
 
+void MessageElementDeleter::operator()(MessageElement *element) const
+{
+    if (this->inArena)
+    {
+        element->~MessageElement();
+    }
+    else
+    {
+        delete element;
+    }
+}
+
 Message::Message()
     : parseTime(QTime::currentTime())
 {
-    DebugCount::increase("messages");
+    static auto &messages = Metrics::gauge("messages");
+    messages.increase();
 }
 
 Message::~Message()
 {
-    DebugCount::decrease("messages");
+    static auto &messages = Metrics::gauge("messages");
+    messages.decrease();
 }
 
 SBHighlight Message::getScrollBarHighlight() const
@@ -51,6 +65,19 @@ SBHighlight Message::getScrollBarHighlight() const
     return SBHighlight();
 }
 
+QString Message::getBadgeInfo(const QString &badge) const
+{
+    for (const auto &[key, value] : this->badgeInfos)
+    {
+        if (key == badge)
+        {
+            return value;
+        }
+    }
+
+    return {};
+}
+
 // Static
 namespace {
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/FlagsEnum.hpp"
+#include "messages/MessageArena.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
 
@@ -42,6 +43,20 @@ enum class MessageFlag : uint32_t {
 };
 using MessageFlags = FlagsEnum<MessageFlag>;
 
+// Elements built by MessageBuilder live in the message's arena and must only
+// be destroyed, other elements are deleted normally
+struct MessageElementDeleter {
+    bool inArena = false;
+
+    void operator()(MessageElement *element) const;
+};
+using MessageElementPtr =
+    std::unique_ptr<MessageElement, MessageElementDeleter>;
+
+// Messages rarely have more than one or two badge infos, a flat vector is a
+// lot smaller than a map for that
+using BadgeInfos = std::vector<std::pair<QString, QString>>;
+
 struct Message : boost::noncopyable {
     Message();
     ~Message();
@@ -62,15 +77,22 @@ struct Message : boost::noncopyable {
     QString localizedName;
     QString timeoutUser;
     QString channelName;
+    // Raw PRIVMSG the message was built from, used to rebuild it once it was
+    // spilled to disk
+    QByteArray ircData;
     QColor usernameColor;
     bool isMod;
     std::vector<Badge> badges;
-    std::map<QString, QString> badgeInfos;
+    BadgeInfos badgeInfos;
     std::shared_ptr<QColor> highlightColor;
     uint32_t count = 1;
-    std::vector<std::unique_ptr<MessageElement>> elements;
+    // Has to be declared before the elements so it outlives them
+    MessageArena arena;
+    std::vector<MessageElementPtr> elements;
 
     ScrollbarHighlight getScrollBarHighlight() const;
+    // Returns an empty string if the message has no info for the badge
+    QString getBadgeInfo(const QString &badge) const;
 };
 
 using MessagePtr = std::shared_ptr<const Message>;
@@ -0,0 +1,61 @@
+#include "messages/MessageArena.hpp"
+
+#include "util/Metrics.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+namespace {
+
+    // Most messages fit into the first chunk, long ones (emote spam) grow
+    // the chunks up to the maximum size
+    constexpr size_t FIRST_CHUNK_SIZE = 1024;
+    constexpr size_t MAX_CHUNK_SIZE = 16 * 1024;
+
+}  // namespace
+
+MessageArena::~MessageArena()
+{
+    if (this->capacity_ > 0)
+    {
+        static auto &messageArenaBytes = Metrics::gauge("message arena bytes");
+        messageArenaBytes.decrease(this->capacity_);
+    }
+}
+
+void *MessageArena::allocate(size_t size, size_t alignment)
+{
+    void *pointer = this->current_;
+    if (pointer != nullptr &&
+        std::align(alignment, size, pointer, this->remaining_) != nullptr)
+    {
+        this->current_ = static_cast<char *>(pointer) + size;
+        this->remaining_ -= size;
+        return pointer;
+    }
+
+    auto chunkSize = this->chunks_.empty()
+                         ? FIRST_CHUNK_SIZE
+                         : std::min(this->capacity_, MAX_CHUNK_SIZE);
+    // operator new[] aligns for any fundamental type, which covers every
+    // element type
+    chunkSize = std::max(chunkSize, size);
+
+    this->chunks_.emplace_back(new char[chunkSize]);
+    this->capacity_ += chunkSize;
+    static auto &messageArenaBytes = Metrics::gauge("message arena bytes");
+    messageArenaBytes.increase(chunkSize);
+
+    pointer = this->chunks_.back().get();
+    this->current_ = static_cast<char *>(pointer) + size;
+    this->remaining_ = chunkSize - size;
+
+    return pointer;
+}
+
+size_t MessageArena::capacity() const
+{
+    return this->capacity_;
+}
+
+}  // namespace chatterino
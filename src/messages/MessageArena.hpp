@@ -0,0 +1,36 @@
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+// Bump allocator holding the elements of a single message.
+//
+// Elements are only added while a message is being built and are all
+// destroyed together with it, so instead of allocating every element on its
+// own they are placed next to each other in a few larger chunks. The arena
+// only hands out memory, destroying the objects placed in it is up to the
+// owner.
+class MessageArena : boost::noncopyable
+{
+public:
+    MessageArena() = default;
+    ~MessageArena();
+
+    void *allocate(size_t size, size_t alignment);
+
+    // Total amount of bytes reserved by the arena
+    size_t capacity() const;
+
+private:
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char *current_ = nullptr;
+    size_t remaining_ = 0;
+    size_t capacity_ = 0;
+};
+
+}  // namespace chatterino
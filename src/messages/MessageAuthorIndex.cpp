@@ -0,0 +1,185 @@
+#include "messages/MessageAuthorIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+std::vector<QString> MessageAuthorIndex::keysOf(const Message &message)
+{
+    std::vector<QString> keys;
+
+    auto add = [&keys](const QString &name) {
+        if (name.isEmpty())
+        {
+            return;
+        }
+
+        auto key = name.toLower();
+        if (std::find(keys.begin(), keys.end(), key) == keys.end())
+        {
+            keys.push_back(std::move(key));
+        }
+    };
+
+    add(message.loginName);
+    add(message.timeoutUser);
+
+    // Subscription notices without a sender start with the user's name
+    if (message.flags.has(MessageFlag::Subscription) &&
+        message.loginName.isEmpty())
+    {
+        add(message.messageText.section(' ', 0, 0));
+    }
+
+    return keys;
+}
+
+void MessageAuthorIndex::append(const MessagePtr &message)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto sequence = this->nextSequence_++;
+
+    for (auto &&key : keysOf(*message))
+    {
+        this->entries_[key].push_back({sequence, message});
+    }
+}
+
+void MessageAuthorIndex::prepend(const std::vector<MessagePtr> &messages)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    for (auto it = messages.rbegin(); it != messages.rend(); ++it)
+    {
+        auto sequence = --this->firstSequence_;
+
+        for (auto &&key : keysOf(**it))
+        {
+            this->entries_[key].push_front({sequence, *it});
+        }
+    }
+}
+
+void MessageAuthorIndex::removeOldest(const MessagePtr &message)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    for (auto &&key : keysOf(*message))
+    {
+        auto it = this->entries_.find(key);
+        if (it == this->entries_.end())
+        {
+            continue;
+        }
+
+        auto &entries = it->second;
+        if (!entries.empty() && entries.front().message == message)
+        {
+            entries.pop_front();
+        }
+
+        if (entries.empty())
+        {
+            this->entries_.erase(it);
+        }
+    }
+}
+
+void MessageAuthorIndex::replace(const MessagePtr &message,
+                                 const MessagePtr &replacement)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    bool found = false;
+    int64_t sequence = 0;
+
+    for (auto &&key : keysOf(*message))
+    {
+        auto it = this->entries_.find(key);
+        if (it == this->entries_.end())
+        {
+            continue;
+        }
+
+        // Replaced messages are usually recent ones
+        auto &entries = it->second;
+        auto position = std::find_if(entries.rbegin(), entries.rend(),
+                                     [&](const Entry &entry) {
+                                         return entry.message == message;
+                                     });
+        if (position == entries.rend())
+        {
+            continue;
+        }
+
+        found = true;
+        sequence = position->sequence;
+        entries.erase(std::next(position).base());
+
+        if (entries.empty())
+        {
+            this->entries_.erase(it);
+        }
+    }
+
+    if (!found)
+    {
+        return;
+    }
+
+    for (auto &&key : keysOf(*replacement))
+    {
+        this->insert(key, {sequence, replacement});
+    }
+}
+
+std::vector<MessagePtr> MessageAuthorIndex::find(const QString &user,
+                                                 size_t withinLast) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    std::vector<MessagePtr> messages;
+
+    auto it = this->entries_.find(user.toLower());
+    if (it == this->entries_.end())
+    {
+        return messages;
+    }
+
+    auto minimumSequence = std::numeric_limits<int64_t>::min();
+    if (withinLast < size_t(this->nextSequence_))
+    {
+        minimumSequence = this->nextSequence_ - int64_t(withinLast);
+    }
+
+    auto &entries = it->second;
+    auto first = std::lower_bound(entries.begin(), entries.end(),
+                                  minimumSequence,
+                                  [](const Entry &entry, int64_t sequence) {
+                                      return entry.sequence < sequence;
+                                  });
+
+    messages.reserve(std::distance(first, entries.end()));
+    for (; first != entries.end(); ++first)
+    {
+        messages.push_back(first->message);
+    }
+
+    return messages;
+}
+
+void MessageAuthorIndex::insert(const QString &key, Entry entry)
+{
+    auto &entries = this->entries_[key];
+    auto it = std::upper_bound(entries.begin(), entries.end(), entry.sequence,
+                               [](int64_t sequence, const Entry &entry) {
+                                   return sequence < entry.sequence;
+                               });
+
+    entries.insert(it, std::move(entry));
+}
+
+}  // namespace chatterino
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+// Secondary index over the messages of a channel, keyed by the users a
+// message belongs to: its sender, the target of a moderation action and the
+// user of a subscription notice. Lookups by user don't need to walk the whole
+// message buffer anymore.
+//
+// The index has to be kept in sync with the channel's LimitedQueue by calling
+// the matching function for every change made to it.
+class MessageAuthorIndex
+{
+public:
+    static constexpr size_t ALL_MESSAGES = std::numeric_limits<size_t>::max();
+
+    // A message was appended at the end
+    void append(const MessagePtr &message);
+    // Messages (in channel order) were inserted before all existing ones
+    void prepend(const std::vector<MessagePtr> &messages);
+    // The oldest message was evicted from the channel
+    void removeOldest(const MessagePtr &message);
+    void replace(const MessagePtr &message, const MessagePtr &replacement);
+
+    // Returns the messages belonging to `user` (case insensitive) in channel
+    // order. Only the last `withinLast` messages appended to the channel are
+    // considered.
+    std::vector<MessagePtr> find(const QString &user,
+                                 size_t withinLast = ALL_MESSAGES) const;
+
+    // The lowercase keys a message is indexed under
+    static std::vector<QString> keysOf(const Message &message);
+
+private:
+    struct Entry {
+        // Position in the channel. Appended messages count up from 0,
+        // prepended ones count down from -1.
+        int64_t sequence;
+        MessagePtr message;
+    };
+
+    void insert(const QString &key, Entry entry);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<QString, std::deque<Entry>> entries_;
+    int64_t nextSequence_ = 0;
+    int64_t firstSequence_ = 0;
+};
+
+}  // namespace chatterino
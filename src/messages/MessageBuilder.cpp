@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "common/LinkParser.hpp"
+#include "common/SymbolTable.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "messages/Image.hpp"
 #include "messages/Message.hpp"
@@ -17,6 +18,29 @@
 #include <QImageReader>
 
 namespace chatterino {
+namespace {
+
+    // Names are repeated across many messages, let them share their data
+    void internNames(Message &message)
+    {
+        auto &symbols = SymbolTable::instance();
+        message.loginName = symbols.intern(message.loginName);
+        message.displayName = symbols.intern(message.displayName);
+        message.localizedName = symbols.intern(message.localizedName);
+        message.timeoutUser = symbols.intern(message.timeoutUser);
+        message.channelName = symbols.intern(message.channelName);
+        for (auto &badge : message.badges)
+        {
+            badge.key_ = symbols.intern(badge.key_);
+            badge.value_ = symbols.intern(badge.value_);
+        }
+        for (auto &badgeInfo : message.badgeInfos)
+        {
+            badgeInfo.first = symbols.intern(badgeInfo.first);
+        }
+    }
+
+}  // namespace
 
 MessagePtr makeSystemMessage(const QString &text)
 {
@@ -446,6 +470,11 @@ Message &MessageBuilder::message()
 
 MessagePtr MessageBuilder::release()
 {
+    if (this->message_)
+    {
+        internNames(*this->message_);
+    }
+
     std::shared_ptr<Message> ptr;
     this->message_.swap(ptr);
     return ptr;
@@ -458,7 +487,19 @@ std::weak_ptr<Message> MessageBuilder::weakOf()
 
 void MessageBuilder::append(std::unique_ptr<MessageElement> element)
 {
-    this->message().elements.push_back(std::move(element));
+    this->message().elements.emplace_back(element.release(),
+                                          MessageElementDeleter{});
+}
+
+void *MessageBuilder::allocateElement(size_t size, size_t alignment)
+{
+    return this->message().arena.allocate(size, alignment);
+}
+
+void MessageBuilder::appendAllocated(MessageElement *element)
+{
+    this->message().elements.emplace_back(element,
+                                          MessageElementDeleter{true});
 }
 
 QString MessageBuilder::matchLink(const QString &string)
@@ -519,6 +560,7 @@ void MessageBuilder::addLink(const QString &origLink,
                                    textColor)
             ->setLink(linkElement);
 
+    // Nobody is waiting for the tooltip yet, it's only shown on hover
     LinkResolver::getLinkInfo(
         matchedLink, nullptr,
         [weakMessage = this->weakOf(), linkMELowercase, linkMEOriginal,
@@ -546,7 +588,8 @@ void MessageBuilder::addLink(const QString &origLink,
             linkMEOriginal->setThumbnail(thumbnail);
             linkMEOriginal->setThumbnailType(
                 MessageElement::ThumbnailType::Link_Thumbnail);
-        });
+        },
+        NetworkRequestPriority::Background);
 }
 
 TextElement *MessageBuilder::emplaceSystemTextAndUpdate(const QString &text,
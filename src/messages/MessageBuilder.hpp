@@ -4,6 +4,7 @@
 
 #include <QRegularExpression>
 #include <ctime>
+#include <new>
 #include <utility>
 
 namespace chatterino {
@@ -68,13 +69,17 @@ public:
         static_assert(std::is_base_of<MessageElement, T>::value,
                       "T must extend MessageElement");
 
-        auto unique = std::make_unique<T>(std::forward<Args>(args)...);
-        auto pointer = unique.get();
-        this->append(std::move(unique));
+        auto pointer = new (this->allocateElement(sizeof(T), alignof(T)))
+            T(std::forward<Args>(args)...);
+        this->appendAllocated(pointer);
         return pointer;
     }
 
 private:
+    // Elements emplaced into the message are allocated from its arena
+    void *allocateElement(size_t size, size_t alignment);
+    void appendAllocated(MessageElement *element);
+
     // Helper method that emplaces some text stylized as system text
     // and then appends that text to the QString parameter "toUpdate".
     // Returns the TextElement that was emplaced.
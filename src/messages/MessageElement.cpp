@@ -3,23 +3,27 @@
 #include "Application.hpp"
 #include "debug/Benchmark.hpp"
 #include "messages/Emote.hpp"
+#include "messages/TimestampFormatter.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 
 namespace chatterino {
 
 MessageElement::MessageElement(MessageElementFlags flags)
     : flags_(flags)
 {
-    DebugCount::increase("message elements");
+    static auto &messageElements = Metrics::gauge("message elements");
+    messageElements.increase();
 }
 
 MessageElement::~MessageElement()
 {
-    DebugCount::decrease("message elements");
+    static auto &messageElements = Metrics::gauge("message elements");
+    messageElements.decrease();
 }
 
 MessageElement *MessageElement::setLink(const Link &link)
@@ -399,9 +403,7 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
 TimestampElement::TimestampElement(QTime time)
     : MessageElement(MessageElementFlag::Timestamp)
     , time_(time)
-    , element_(this->formatTime(time))
 {
-    assert(this->element_ != nullptr);
 }
 
 void TimestampElement::addToContainer(MessageLayoutContainer &container,
@@ -409,24 +411,34 @@ void TimestampElement::addToContainer(MessageLayoutContainer &container,
 {
     if (flags.hasAny(this->getFlags()))
     {
-        if (getSettings()->timestampFormat != this->format_)
-        {
-            this->format_ = getSettings()->timestampFormat.getValue();
-            this->element_.reset(this->formatTime(this->time_));
-        }
+        auto app = getApp();
 
-        this->element_->addToContainer(container, flags);
-    }
-}
+        // Formatted on the first layout, so messages that are never shown
+        // don't pay for it
+        auto timestamp = TimestampFormatter::instance().get(
+            this->time_, container.getRenderSettings().timestampFormat,
+            container.getScale());
 
-TextElement *TimestampElement::formatTime(const QTime &time)
-{
-    static QLocale locale("en_US");
+        auto color = MessageColor(MessageColor::System).getColor(*app->themes);
+        app->themes->normalizeColor(color);
 
-    QString format = locale.toString(time, getSettings()->timestampFormat);
+        for (const auto &word : timestamp->words)
+        {
+            if (!container.fitsInLine(word.width) &&
+                !container.atStartOfLine())
+            {
+                container.breakLine();
+            }
 
-    return new TextElement(format, MessageElementFlag::Timestamp,
-                           MessageColor::System, FontStyle::ChatMedium);
+            // TextLayoutElement takes the text by non-const reference
+            auto text = word.text;
+            auto *element = new TextLayoutElement(
+                *this, text, QSize(word.width, timestamp->height), color,
+                FontStyle::ChatMedium, container.getScale());
+            element->setTrailingSpace(true);
+            container.addElementNoLineBreak(element);
+        }
+    }
 }
 
 // TWITCH MODERATION
@@ -343,12 +343,8 @@ public:
     void addToContainer(MessageLayoutContainer &container,
                         MessageElementFlags flags) override;
 
-    TextElement *formatTime(const QTime &time);
-
 private:
     QTime time_;
-    std::unique_ptr<TextElement> element_;
-    QString format_;
 };
 
 // adds all the custom moderation buttons, adds a variable amount of items
@@ -0,0 +1,428 @@
+#include "messages/MessageSpillStore.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/Metrics.hpp"
+
+#include <QDataStream>
+#include <QDir>
+
+#include <algorithm>
+
+namespace chatterino {
+
+namespace {
+
+    constexpr auto streamVersion = QDataStream::Qt_5_12;
+
+    Metric &spilledMessages()
+    {
+        static auto &spilledMessages = Metrics::gauge("spilled messages");
+        return spilledMessages;
+    }
+
+    void writeInfos(QDataStream &stream, const BadgeInfos &infos)
+    {
+        stream << quint32(infos.size());
+        for (const auto &[key, value] : infos)
+        {
+            stream << key << value;
+        }
+    }
+
+    void readInfos(QDataStream &stream, BadgeInfos &infos)
+    {
+        quint32 count = 0;
+        stream >> count;
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok;
+             i++)
+        {
+            QString key;
+            QString value;
+            stream >> key >> value;
+            infos.emplace_back(std::move(key), std::move(value));
+        }
+    }
+
+    void write(QDataStream &stream, const SpilledMessage &message)
+    {
+        stream << message.ircData << quint32(message.flags.value())
+               << message.parseTime << message.id << message.searchText
+               << message.messageText << message.loginName
+               << message.displayName << message.timeoutUser
+               << message.channelName << message.usernameColor
+               << message.highlightColor;
+        writeInfos(stream, message.badges);
+        writeInfos(stream, message.badgeInfos);
+    }
+
+    void read(QDataStream &stream, SpilledMessage &message)
+    {
+        quint32 flags = 0;
+        stream >> message.ircData >> flags >> message.parseTime >>
+            message.id >> message.searchText >> message.messageText >>
+            message.loginName >> message.displayName >> message.timeoutUser >>
+            message.channelName >> message.usernameColor >>
+            message.highlightColor;
+        readInfos(stream, message.badges);
+        readInfos(stream, message.badgeInfos);
+
+        message.flags = MessageFlags(static_cast<MessageFlag>(flags));
+    }
+
+}  // namespace
+
+//
+// SpilledMessage
+//
+SpilledMessage SpilledMessage::fromMessage(const Message &message)
+{
+    SpilledMessage spilled;
+    spilled.ircData = message.ircData;
+    spilled.flags = message.flags;
+    spilled.parseTime = message.parseTime;
+    spilled.id = message.id;
+    spilled.searchText = message.searchText;
+    spilled.messageText = message.messageText;
+    spilled.loginName = message.loginName;
+    spilled.displayName = message.displayName;
+    spilled.timeoutUser = message.timeoutUser;
+    spilled.channelName = message.channelName;
+    spilled.usernameColor = message.usernameColor;
+    if (message.highlightColor)
+    {
+        spilled.highlightColor = *message.highlightColor;
+    }
+
+    for (const auto &badge : message.badges)
+    {
+        spilled.badges.emplace_back(badge.key_, badge.value_);
+    }
+    spilled.badgeInfos = message.badgeInfos;
+
+    return spilled;
+}
+
+void SpilledMessage::applyTo(Message &message) const
+{
+    message.flags = this->flags;
+    message.parseTime = this->parseTime;
+    message.id = this->id;
+    message.searchText = this->searchText;
+    message.messageText = this->messageText;
+    message.loginName = this->loginName;
+    message.displayName = this->displayName;
+    message.timeoutUser = this->timeoutUser;
+    message.channelName = this->channelName;
+    message.usernameColor = this->usernameColor;
+    if (this->highlightColor.isValid())
+    {
+        message.highlightColor = std::make_shared<QColor>(this->highlightColor);
+    }
+
+    for (const auto &[key, value] : this->badges)
+    {
+        message.badges.emplace_back(key, value);
+    }
+    message.badgeInfos = this->badgeInfos;
+}
+
+MessagePtr SpilledMessage::toSearchProxy() const
+{
+    auto message = std::make_shared<Message>();
+    this->applyTo(*message);
+
+    return message;
+}
+
+//
+// MessageSpillStore
+//
+MessageSpillStore::MessageSpillStore()
+    : directory_(QDir::tempPath() + "/chatterino-scrollback-XXXXXX")
+{
+    if (!this->directory_.isValid())
+    {
+        qCWarning(chatterinoMessage)
+            << "Failed to create scrollback directory:"
+            << this->directory_.errorString();
+    }
+}
+
+MessageSpillStore::~MessageSpillStore()
+{
+    spilledMessages().decrease(int64_t(this->size()));
+}
+
+void MessageSpillStore::setLimit(size_t limit)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    this->limit_ = limit;
+    this->dropOverLimit();
+}
+
+void MessageSpillStore::append(const SpilledMessage &message)
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(streamVersion);
+        write(stream, message);
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    if (this->limit_ == 0 || !this->directory_.isValid())
+    {
+        return;
+    }
+
+    if (this->segments_.empty() ||
+        this->segments_.back().offsets.size() >= SEGMENT_SIZE)
+    {
+        auto path =
+            this->directory_.filePath(QString::number(this->nextFileId_++));
+        auto file = std::make_unique<QFile>(path);
+        if (!file->open(QIODevice::ReadWrite | QIODevice::Truncate))
+        {
+            qCWarning(chatterinoMessage)
+                << "Failed to open scrollback segment:" << file->errorString();
+            return;
+        }
+
+        // Keeps us from running out of file descriptors with long scrollback
+        // in many channels
+        if (!this->segments_.empty())
+        {
+            this->segments_.back().file.reset();
+        }
+
+        this->segments_.push_back({this->end_, path, std::move(file), {}, 0});
+    }
+
+    auto &segment = this->segments_.back();
+    if (!segment.file->seek(segment.bytes) ||
+        segment.file->write(data) != data.size())
+    {
+        qCWarning(chatterinoMessage) << "Failed to write scrollback segment:"
+                                     << segment.file->errorString();
+        return;
+    }
+
+    segment.offsets.push_back(segment.bytes);
+    segment.bytes += data.size();
+    this->end_++;
+    spilledMessages().increase();
+
+    this->dropOverLimit();
+}
+
+std::vector<SpilledMessage> MessageSpillStore::takeBack(size_t count)
+{
+    std::vector<Blob> blobs;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        count = std::min(count, this->end_ - this->begin_);
+        if (count == 0)
+        {
+            return {};
+        }
+
+        auto newEnd = this->end_ - count;
+        blobs = this->readLocked(newEnd, this->end_);
+
+        while (!this->segments_.empty())
+        {
+            auto &segment = this->segments_.back();
+            if (segment.first + segment.offsets.size() <= newEnd)
+            {
+                break;
+            }
+
+            if (segment.first >= newEnd)
+            {
+                removeSegment(segment);
+                this->segments_.pop_back();
+                continue;
+            }
+
+            // The segment is the newest one now, so it's appended to again
+            if (!segment.file)
+            {
+                segment.file = std::make_unique<QFile>(segment.path);
+                if (!segment.file->open(QIODevice::ReadWrite))
+                {
+                    qCWarning(chatterinoMessage)
+                        << "Failed to open scrollback segment:"
+                        << segment.file->errorString();
+                }
+            }
+
+            auto kept = newEnd - segment.first;
+            segment.bytes = segment.offsets[kept];
+            segment.offsets.resize(kept);
+            segment.file->resize(segment.bytes);
+            break;
+        }
+
+        this->end_ = newEnd;
+        spilledMessages().decrease(int64_t(count));
+    }
+
+    return parse(blobs);
+}
+
+std::vector<SpilledMessage> MessageSpillStore::read(size_t from,
+                                                    size_t to) const
+{
+    std::vector<Blob> blobs;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        blobs = this->readLocked(from, to);
+    }
+
+    return parse(blobs);
+}
+
+size_t MessageSpillStore::begin() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->begin_;
+}
+
+size_t MessageSpillStore::end() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->end_;
+}
+
+size_t MessageSpillStore::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->end_ - this->begin_;
+}
+
+std::vector<MessageSpillStore::Blob> MessageSpillStore::readLocked(
+    size_t from, size_t to) const
+{
+    from = std::max(from, this->begin_);
+    to = std::min(to, this->end_);
+
+    std::vector<Blob> blobs;
+
+    for (const auto &segment : this->segments_)
+    {
+        auto segmentEnd = segment.first + segment.offsets.size();
+        auto first = std::max(from, segment.first);
+        auto last = std::min(to, segmentEnd);
+        if (first >= last)
+        {
+            continue;
+        }
+
+        auto start = segment.offsets[first - segment.first];
+        auto stop = last < segmentEnd ? segment.offsets[last - segment.first]
+                                      : segment.bytes;
+
+        QFile closedFile(segment.path);
+        auto *file = segment.file.get();
+        if (!file)
+        {
+            if (!closedFile.open(QIODevice::ReadOnly))
+            {
+                qCWarning(chatterinoMessage)
+                    << "Failed to open scrollback segment:"
+                    << closedFile.errorString();
+                continue;
+            }
+            file = &closedFile;
+        }
+
+        QByteArray data;
+        if (file->seek(start))
+        {
+            data = file->read(stop - start);
+        }
+
+        if (data.size() != stop - start)
+        {
+            qCWarning(chatterinoMessage)
+                << "Failed to read scrollback segment:" << file->errorString();
+            continue;
+        }
+
+        blobs.push_back({std::move(data), last - first});
+    }
+
+    return blobs;
+}
+
+void MessageSpillStore::dropOverLimit()
+{
+    auto newBegin = this->end_ - std::min(this->limit_, this->end_);
+    if (newBegin > this->begin_)
+    {
+        spilledMessages().decrease(int64_t(newBegin - this->begin_));
+        this->begin_ = newBegin;
+    }
+
+    // Segments are only removed once all of their records were dropped
+    while (!this->segments_.empty())
+    {
+        auto &segment = this->segments_.front();
+        if (segment.first + segment.offsets.size() > this->begin_)
+        {
+            break;
+        }
+
+        removeSegment(segment);
+        this->segments_.pop_front();
+    }
+}
+
+void MessageSpillStore::removeSegment(Segment &segment)
+{
+    if (segment.file)
+    {
+        // Closes the file before removing it
+        segment.file->remove();
+    }
+    else
+    {
+        QFile::remove(segment.path);
+    }
+}
+
+std::vector<SpilledMessage> MessageSpillStore::parse(
+    const std::vector<Blob> &blobs)
+{
+    std::vector<SpilledMessage> messages;
+
+    for (const auto &blob : blobs)
+    {
+        QDataStream stream(blob.data);
+        stream.setVersion(streamVersion);
+
+        for (size_t i = 0; i < blob.count; i++)
+        {
+            SpilledMessage message;
+            read(stream, message);
+            if (stream.status() != QDataStream::Ok)
+            {
+                qCWarning(chatterinoMessage)
+                    << "Failed to parse spilled message";
+                break;
+            }
+
+            messages.push_back(std::move(message));
+        }
+    }
+
+    return messages;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "messages/Message.hpp"
+
+#include <QByteArray>
+#include <QColor>
+#include <QFile>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTime>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+// What's left of a message once it was evicted from a channel: the raw IRC
+// message it was built from, and the fields searches and filters look at.
+struct SpilledMessage {
+    // Empty if the message wasn't built from a PRIVMSG
+    QByteArray ircData;
+    MessageFlags flags;
+    QTime parseTime;
+    QString id;
+    QString searchText;
+    QString messageText;
+    QString loginName;
+    QString displayName;
+    QString timeoutUser;
+    QString channelName;
+    QColor usernameColor;
+    // Invalid if the message has no highlight color
+    QColor highlightColor;
+    // Key and value of every badge
+    BadgeInfos badges;
+    BadgeInfos badgeInfos;
+
+    static SpilledMessage fromMessage(const Message &message);
+
+    // Copies the fields into `message`, it won't have any elements
+    void applyTo(Message &message) const;
+
+    // A message without elements that predicates and filters can be run on
+    MessagePtr toSearchProxy() const;
+};
+
+// Messages that were evicted from a channel, kept in temporary files so they
+// can be scrolled and searched back to without keeping them in memory.
+//
+// Records are appended in segment files of SEGMENT_SIZE records each, and
+// only the offsets of the records are kept in memory. Only the newest segment
+// keeps its file open, older ones are opened whenever they're read. Records
+// keep their index until they're taken back or dropped, so indices returned
+// by begin() and end() can be read later on. Once there are more records than
+// the limit, the oldest ones are dropped.
+//
+// All functions can be called from any thread.
+class MessageSpillStore
+{
+public:
+    static constexpr size_t SEGMENT_SIZE = 4096;
+
+    MessageSpillStore();
+    ~MessageSpillStore();
+
+    MessageSpillStore(const MessageSpillStore &) = delete;
+    MessageSpillStore &operator=(const MessageSpillStore &) = delete;
+
+    // Keeps at most `limit` records, a limit of 0 drops all of them
+    void setLimit(size_t limit);
+
+    void append(const SpilledMessage &message);
+
+    // Removes up to `count` of the newest records and returns them, oldest
+    // first
+    std::vector<SpilledMessage> takeBack(size_t count);
+
+    // Returns the records with an index in [from, to), oldest first. Records
+    // that were dropped or taken back are skipped.
+    std::vector<SpilledMessage> read(size_t from, size_t to) const;
+
+    // Index of the oldest record
+    size_t begin() const;
+    // Index after the newest record
+    size_t end() const;
+    size_t size() const;
+
+private:
+    struct Segment {
+        // Index of the first record in the file
+        size_t first;
+        QString path;
+        // Only set for the newest segment
+        std::unique_ptr<QFile> file;
+        // Position of every record in the file
+        std::vector<qint64> offsets;
+        qint64 bytes = 0;
+    };
+
+    // Serialized records, each blob holds `count` of them back to back
+    struct Blob {
+        QByteArray data;
+        size_t count;
+    };
+
+    std::vector<Blob> readLocked(size_t from, size_t to) const;
+    void dropOverLimit();
+    static void removeSegment(Segment &segment);
+    static std::vector<SpilledMessage> parse(const std::vector<Blob> &blobs);
+
+    mutable std::mutex mutex_;
+    QTemporaryDir directory_;
+    std::deque<Segment> segments_;
+    size_t nextFileId_ = 0;
+
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    size_t limit_ = 0;
+};
+
+}  // namespace chatterino
@@ -6,6 +6,7 @@
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Helpers.hpp"
@@ -76,6 +77,7 @@ SharedMessageBuilder::SharedMessageBuilder(
     , tags(this->ircMessage->tags())
     , originalMessage_(_ircMessage->content())
     , action_(_ircMessage->isAction())
+    , renderSettings_(RenderSettings::get())
 {
 }
 
@@ -88,6 +90,7 @@ SharedMessageBuilder::SharedMessageBuilder(
     , tags(this->ircMessage->tags())
     , originalMessage_(content)
     , action_(isAction)
+    , renderSettings_(RenderSettings::get())
 {
 }
 
@@ -114,7 +117,7 @@ bool SharedMessageBuilder::isIgnored() const
 
 void SharedMessageBuilder::parseUsernameColor()
 {
-    if (getSettings()->colorizeNicknames)
+    if (this->renderSettings_->colorizeNicknames)
     {
         this->usernameColor_ = getRandomColor(this->ircMessage->nick());
     }
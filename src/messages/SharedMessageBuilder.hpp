@@ -10,6 +10,8 @@
 
 namespace chatterino {
 
+struct RenderSettings;
+
 class SharedMessageBuilder : public MessageBuilder
 {
 public:
@@ -60,6 +62,9 @@ protected:
 
     const bool action_{};
 
+    // Taken once, so the settings stay the same while building the message
+    const std::shared_ptr<const RenderSettings> renderSettings_;
+
     QColor usernameColor_ = {153, 153, 153};
     MessageColor textColor_ = MessageColor::Text;
 
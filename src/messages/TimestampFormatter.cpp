@@ -0,0 +1,113 @@
+#include "messages/TimestampFormatter.hpp"
+
+#include "Application.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "singletons/Fonts.hpp"
+#include "util/Metrics.hpp"
+
+#include <QLocale>
+#include <QStringList>
+#include <boost/functional/hash.hpp>
+
+namespace chatterino {
+
+namespace {
+
+    // A few hours of chat at one message per second
+    constexpr size_t maxEntries = 8192;
+
+}  // namespace
+
+bool TimestampFormatter::Key::operator==(const Key &other) const
+{
+    return this->msecs == other.msecs && this->scale == other.scale &&
+           this->format == other.format;
+}
+
+size_t TimestampFormatter::KeyHash::operator()(const Key &key) const
+{
+    size_t seed = qHash(key.format);
+    boost::hash_combine(seed, key.msecs);
+    boost::hash_combine(seed, key.scale);
+
+    return seed;
+}
+
+TimestampFormatter &TimestampFormatter::instance()
+{
+    static TimestampFormatter instance;
+
+    return instance;
+}
+
+std::shared_ptr<const TimestampFormatter::Timestamp> TimestampFormatter::get(
+    const QTime &time, const QString &format, float scale)
+{
+    assertInGuiThread();
+
+    auto msecs = time.msecsSinceStartOfDay();
+    // Timestamps only differ within a second if they show milliseconds
+    if (!format.contains('z'))
+    {
+        msecs -= msecs % 1000;
+    }
+
+    Key key{msecs, format, scale};
+
+    if (auto it = this->current_.find(key); it != this->current_.end())
+    {
+        static auto &timestampCacheHits =
+            Metrics::counter("timestamp cache hits");
+        timestampCacheHits.increase();
+
+        return it->second;
+    }
+
+    std::shared_ptr<const Timestamp> timestamp;
+
+    if (auto it = this->previous_.find(key); it != this->previous_.end())
+    {
+        timestamp = std::move(it->second);
+        this->previous_.erase(it);
+    }
+    else
+    {
+        auto metrics =
+            getApp()->fonts->getFontMetrics(FontStyle::ChatMedium, scale);
+
+        auto newTimestamp = std::make_shared<Timestamp>();
+        newTimestamp->height = metrics.height();
+        for (auto &text :
+             TimestampFormatter::format(time, format).split(' '))
+        {
+            auto width = metrics.horizontalAdvance(text);
+            newTimestamp->words.push_back({std::move(text), width});
+        }
+
+        timestamp = std::move(newTimestamp);
+    }
+
+    if (this->current_.size() >= maxEntries)
+    {
+        this->previous_ = std::move(this->current_);
+        this->current_.clear();
+    }
+    this->current_.emplace(std::move(key), timestamp);
+
+    return timestamp;
+}
+
+void TimestampFormatter::clear()
+{
+    this->current_.clear();
+    this->previous_.clear();
+}
+
+QString TimestampFormatter::format(const QTime &time, const QString &format)
+{
+    static QLocale locale("en_US");
+
+    return locale.toString(time, format);
+}
+
+}  // namespace chatterino
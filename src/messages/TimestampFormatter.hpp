@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QString>
+#include <QTime>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+// Formats and measures the timestamps of messages.
+//
+// Messages sent in the same second show the same timestamp, so the text and
+// its width are only computed once per (time, format, scale) and shared
+// between all of them. Only used on the GUI thread.
+class TimestampFormatter
+{
+public:
+    struct Word {
+        QString text;
+        int width;
+    };
+
+    struct Timestamp {
+        // Split at spaces, like a TextElement
+        std::vector<Word> words;
+        int height;
+    };
+
+    static TimestampFormatter &instance();
+
+    std::shared_ptr<const Timestamp> get(const QTime &time,
+                                         const QString &format, float scale);
+
+    // Forgets all widths, e.g. after the font changed
+    void clear();
+
+    static QString format(const QTime &time, const QString &format);
+
+private:
+    struct Key {
+        int msecs;
+        QString format;
+        float scale;
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    using Map =
+        std::unordered_map<Key, std::shared_ptr<const Timestamp>, KeyHash>;
+
+    // Once `current_` is full, it replaces `previous_`. Entries that are
+    // still used are moved back on their next lookup.
+    Map current_;
+    Map previous_;
+};
+
+}  // namespace chatterino
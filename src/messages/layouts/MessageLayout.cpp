@@ -2,14 +2,16 @@
 
 #include "Application.hpp"
 #include "debug/Benchmark.hpp"
+#include "messages/Image.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "singletons/Emotes.hpp"
-#include "singletons/Settings.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 
 #include <QApplication>
 #include <QDebug>
@@ -42,12 +44,14 @@ MessageLayout::MessageLayout(MessagePtr message)
     : message_(std::move(message))
     , container_(std::make_shared<MessageLayoutContainer>())
 {
-    DebugCount::increase("message layout");
+    static auto &messageLayout = Metrics::gauge("message layout");
+    messageLayout.increase();
 }
 
 MessageLayout::~MessageLayout()
 {
-    DebugCount::decrease("message layout");
+    static auto &messageLayout = Metrics::gauge("message layout");
+    messageLayout.decrease();
 }
 
 const Message *MessageLayout::getMessage()
@@ -63,7 +67,8 @@ int MessageLayout::getHeight() const
 
 // Layout
 // return true if redraw is required
-bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
+bool MessageLayout::layout(int width, float scale, MessageElementFlags flags,
+                           const RenderSettings &settings)
 {
     //    BenchmarkGuard benchmark("MessageLayout::layout()");
 
@@ -84,10 +89,18 @@ bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
         this->layoutState_ = app->windows->getGeneration();
     }
 
+    // check if a setting that's used in the layout changed
+    layoutRequired |= this->renderSettingsVersion_ != settings.version;
+    this->renderSettingsVersion_ = settings.version;
+
     // check if work mask changed
     layoutRequired |= this->currentWordFlags_ != flags;
     this->currentWordFlags_ = flags;  // getSettings()->getWordTypeMask();
 
+    // check if the message itself changed
+    layoutRequired |= this->currentMessageFlags_ != this->message_->flags;
+    this->currentMessageFlags_ = this->message_->flags;
+
     // check if layout was requested manually
     layoutRequired |= this->flags.has(MessageLayoutFlag::RequiresLayout);
     this->flags.unset(MessageLayoutFlag::RequiresLayout);
@@ -98,11 +111,21 @@ bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
 
     if (!layoutRequired)
     {
+        // check if only the way messages are painted changed
+        if (this->bufferState_ != app->windows->getBufferGeneration())
+        {
+            this->bufferState_ = app->windows->getBufferGeneration();
+            this->invalidateBuffer();
+            return true;
+        }
+
         return false;
     }
 
+    this->bufferState_ = app->windows->getBufferGeneration();
+
     int oldHeight = this->container_->getHeight();
-    this->actuallyLayout(width, flags);
+    this->actuallyLayout(width, flags, settings);
     if (widthChanged || this->container_->getHeight() != oldHeight)
     {
         this->deleteBuffer();
@@ -112,8 +135,12 @@ bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
     return true;
 }
 
-void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
+void MessageLayout::actuallyLayout(int width, MessageElementFlags flags,
+                                   const RenderSettings &settings)
 {
+    static auto &messageLayoutPass = Metrics::histogram("message layout pass");
+    MetricTimer timer(messageLayoutPass);
+
     this->layoutCount_++;
     auto messageFlags = this->message_->flags;
 
@@ -124,37 +151,74 @@ void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
         messageFlags.unset(MessageFlag::Collapsed);
     }
 
-    this->container_->begin(width, this->scale_, messageFlags);
-
-    for (const auto &element : this->message_->elements)
+    MessageLayoutCache::Key key{
+        this->message_.get(),
+        width,
+        this->scale_,
+        static_cast<int64_t>(flags.value()),
+        static_cast<uint32_t>(messageFlags.value()),
+        getApp()->windows->getGeneration(),
+        settings.version,
+    };
+
+    auto &cache = MessageLayoutCache::instance();
+    if (auto container = cache.find(key))
     {
-        if (getSettings()->hideModerated &&
-            this->message_->flags.has(MessageFlag::Disabled))
-        {
-            continue;
-        }
+        this->container_ = std::move(container);
+    }
+    else
+    {
+        auto newContainer = std::make_unique<MessageLayoutContainer>();
+        newContainer->begin(width, this->scale_, messageFlags, settings);
 
-        if (getSettings()->hideModerationActions &&
-            this->message_->flags.has(MessageFlag::Timeout))
+        for (const auto &element : this->message_->elements)
         {
-            continue;
+            if (settings.hideModerated &&
+                this->message_->flags.has(MessageFlag::Disabled))
+            {
+                continue;
+            }
+
+            if (settings.hideModerationActions &&
+                this->message_->flags.has(MessageFlag::Timeout))
+            {
+                continue;
+            }
+
+            if (settings.hideSimilar &&
+                this->message_->flags.has(MessageFlag::Similar))
+            {
+                continue;
+            }
+
+            element->addToContainer(*newContainer, flags);
         }
 
-        if (getSettings()->hideSimilar &&
-            this->message_->flags.has(MessageFlag::Similar))
+        newContainer->end();
+
+        // Images that aren't loaded yet only take up placeholder space, so
+        // the layout has to be redone once they are. Until then it's not
+        // shared, since only this layout gets notified.
+        auto unloadedImages = newContainer->getUnloadedImages();
+        if (unloadedImages.empty())
         {
-            continue;
+            this->container_ = cache.insert(key, std::move(newContainer));
         }
+        else
+        {
+            this->container_ = std::move(newContainer);
 
-        element->addToContainer(*this->container_, flags);
+            for (const auto &image : unloadedImages)
+            {
+                image->addPendingLayout(this->weak_from_this());
+            }
+        }
     }
 
     if (this->height_ != this->container_->getHeight())
     {
         this->deleteBuffer();
     }
-
-    this->container_->end();
     this->height_ = this->container_->getHeight();
 
     // collapsed state
@@ -168,7 +232,8 @@ void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
 // Painting
 void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
                           Selection &selection, bool isLastReadMessage,
-                          bool isWindowFocused, bool isMentions)
+                          bool isWindowFocused, bool isMentions,
+                          const RenderSettings &settings)
 {
     auto app = getApp();
     QPixmap *pixmap = this->buffer_.get();
@@ -188,12 +253,14 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
 
         this->buffer_ = std::shared_ptr<QPixmap>(pixmap);
         this->bufferValid_ = false;
-        DebugCount::increase("message drawing buffers");
+        static auto &messageDrawingBuffers =
+            Metrics::gauge("message drawing buffers");
+        messageDrawingBuffers.increase();
     }
 
     if (!this->bufferValid_ || !selection.isEmpty())
     {
-        this->updateBuffer(pixmap, messageIndex, selection);
+        this->updateBuffer(pixmap, messageIndex, selection, settings);
     }
 
     // draw on buffer
@@ -214,7 +281,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     }
 
     if (this->message_->flags.has(MessageFlag::RecentMessage) &&
-        getSettings()->grayOutRecents)
+        settings.grayOutRecents)
     {
         painter.fillRect(0, y, pixmap->width(), pixmap->height(),
                          app->themes->messages.disabled);
@@ -223,7 +290,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     if (!isMentions &&
         (this->message_->flags.has(MessageFlag::RedeemedChannelPointReward) ||
          this->message_->flags.has(MessageFlag::RedeemedHighlight)) &&
-        getSettings()->enableRedeemedHighlight.getValue())
+        settings.enableRedeemedHighlight)
     {
         painter.fillRect(
             0, y, this->scale_ * 4, pixmap->height(),
@@ -237,7 +304,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     }
 
     // draw message seperation line
-    if (getSettings()->separateMessages.getValue())
+    if (settings.separateMessages)
     {
         painter.fillRect(0, y, this->container_->getWidth() + 64, 1,
                          app->themes->splits.messageSeperator);
@@ -247,9 +314,9 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     if (isLastReadMessage)
     {
         QColor color;
-        if (getSettings()->lastMessageColor != "")
+        if (settings.lastMessageColor.isValid())
         {
-            color = QColor(getSettings()->lastMessageColor.getValue());
+            color = settings.lastMessageColor;
         }
         else
         {
@@ -259,8 +326,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
                     : app->themes->tabs.selected.backgrounds.unfocused.color();
         }
 
-        QBrush brush(color, static_cast<Qt::BrushStyle>(
-                                getSettings()->lastMessagePattern.getValue()));
+        QBrush brush(color, settings.lastMessagePattern);
 
         painter.fillRect(0, y + this->container_->getHeight() - 1,
                          pixmap->width(), 1, brush);
@@ -270,20 +336,20 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
 }
 
 void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
-                                 Selection & /*selection*/)
+                                 Selection & /*selection*/,
+                                 const RenderSettings &settings)
 {
     if (buffer->isNull())
         return;
 
     auto app = getApp();
-    auto settings = getSettings();
 
     QPainter painter(buffer);
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
 
     // draw background
-    QColor backgroundColor = [this, &app] {
-        if (getSettings()->alternateMessages.getValue() &&
+    QColor backgroundColor = [this, &app, &settings] {
+        if (settings.alternateMessages &&
             this->flags.has(MessageLayoutFlag::AlternateBackground))
         {
             return app->themes->messages.backgrounds.alternate;
@@ -295,7 +361,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
     }();
 
     if (this->message_->flags.has(MessageFlag::FirstMessage) &&
-        getSettings()->enableFirstMessageHighlight.getValue())
+        settings.enableFirstMessageHighlight)
     {
         backgroundColor = blendColors(
             backgroundColor,
@@ -310,7 +376,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
             blendColors(backgroundColor, *this->message_->highlightColor);
     }
     else if (this->message_->flags.has(MessageFlag::Subscription) &&
-             getSettings()->enableSubHighlight)
+             settings.enableSubHighlight)
     {
         // Blend highlight color with usual background color
         backgroundColor = blendColors(
@@ -320,7 +386,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
     else if ((this->message_->flags.has(MessageFlag::RedeemedHighlight) ||
               this->message_->flags.has(
                   MessageFlag::RedeemedChannelPointReward)) &&
-             settings->enableRedeemedHighlight.getValue())
+             settings.enableRedeemedHighlight)
     {
         // Blend highlight color with usual background color
         backgroundColor = blendColors(
@@ -362,11 +428,18 @@ void MessageLayout::invalidateBuffer()
     this->bufferValid_ = false;
 }
 
+bool MessageLayout::hasAnimatedElements() const
+{
+    return this->container_->hasAnimatedElements();
+}
+
 void MessageLayout::deleteBuffer()
 {
     if (this->buffer_ != nullptr)
     {
-        DebugCount::decrease("message drawing buffers");
+        static auto &messageDrawingBuffers =
+            Metrics::gauge("message drawing buffers");
+        messageDrawingBuffers.decrease();
 
         this->buffer_ = nullptr;
     }
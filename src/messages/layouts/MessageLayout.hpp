@@ -15,10 +15,13 @@ using MessagePtr = std::shared_ptr<const Message>;
 
 struct Selection;
 struct MessageLayoutContainer;
+struct RenderSettings;
 class MessageLayoutElement;
 
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
+enum class MessageFlag : uint32_t;
+using MessageFlags = FlagsEnum<MessageFlag>;
 
 enum class MessageLayoutFlag : uint8_t {
     RequiresBufferUpdate = 1 << 1,
@@ -30,7 +33,8 @@ enum class MessageLayoutFlag : uint8_t {
 };
 using MessageLayoutFlags = FlagsEnum<MessageLayoutFlag>;
 
-class MessageLayout : boost::noncopyable
+class MessageLayout : public std::enable_shared_from_this<MessageLayout>,
+                      boost::noncopyable
 {
 public:
     MessageLayout(MessagePtr message_);
@@ -42,15 +46,20 @@ public:
 
     MessageLayoutFlags flags;
 
-    bool layout(int width, float scale_, MessageElementFlags flags);
+    bool layout(int width, float scale_, MessageElementFlags flags,
+                const RenderSettings &settings);
 
     // Painting
     void paint(QPainter &painter, int width, int y, int messageIndex,
                Selection &selection, bool isLastReadMessage,
-               bool isWindowFocused, bool isMentions);
+               bool isWindowFocused, bool isMentions,
+               const RenderSettings &settings);
     void invalidateBuffer();
     void deleteBuffer();
     void deleteCache();
+    // Whether the message contains images that need to be repainted while
+    // they're animating
+    bool hasAnimatedElements() const;
 
     // Elements
     const MessageLayoutElement *getElementAt(QPoint point);
@@ -74,17 +83,24 @@ private:
 
     int currentLayoutWidth_ = -1;
     int layoutState_ = -1;
+    int bufferState_ = -1;
+    uint64_t renderSettingsVersion_ = 0;
     float scale_ = -1;
     unsigned int layoutCount_ = 0;
     unsigned int bufferUpdatedCount_ = 0;
 
     MessageElementFlags currentWordFlags_;
+    // Flags of the message when it was last laid out, e.g. a message that
+    // got disabled by a timeout has to be laid out again
+    MessageFlags currentMessageFlags_;
 
     int collapsedHeight_ = 32;
 
     // methods
-    void actuallyLayout(int width, MessageElementFlags flags);
-    void updateBuffer(QPixmap *pixmap, int messageIndex, Selection &selection);
+    void actuallyLayout(int width, MessageElementFlags flags,
+                        const RenderSettings &settings);
+    void updateBuffer(QPixmap *pixmap, int messageIndex, Selection &selection,
+                      const RenderSettings &settings);
 };
 
 using MessageLayoutPtr = std::shared_ptr<MessageLayout>;
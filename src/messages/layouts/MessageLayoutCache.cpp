@@ -0,0 +1,112 @@
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include "messages/layouts/MessageLayoutContainer.hpp"
+#include "util/Metrics.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace chatterino {
+
+bool MessageLayoutCache::Key::operator==(const Key &other) const
+{
+    return this->message == other.message && this->width == other.width &&
+           this->scale == other.scale &&
+           this->elementFlags == other.elementFlags &&
+           this->messageFlags == other.messageFlags &&
+           this->generation == other.generation &&
+           this->renderSettingsVersion == other.renderSettingsVersion;
+}
+
+size_t MessageLayoutCache::KeyHash::operator()(const Key &key) const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, key.message);
+    boost::hash_combine(seed, key.width);
+    boost::hash_combine(seed, key.scale);
+    boost::hash_combine(seed, key.elementFlags);
+    boost::hash_combine(seed, key.messageFlags);
+    boost::hash_combine(seed, key.generation);
+    boost::hash_combine(seed, key.renderSettingsVersion);
+
+    return seed;
+}
+
+MessageLayoutCache &MessageLayoutCache::instance()
+{
+    // Never destroyed, layouts can outlive static destructors
+    static auto *instance = new MessageLayoutCache;
+
+    return *instance;
+}
+
+std::shared_ptr<MessageLayoutContainer> MessageLayoutCache::find(
+    const Key &key)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return nullptr;
+    }
+
+    auto container = it->second.lock();
+    if (container)
+    {
+        static auto &messageLayoutCacheHits =
+            Metrics::counter("message layout cache hits");
+        messageLayoutCacheHits.increase();
+    }
+
+    return container;
+}
+
+std::shared_ptr<MessageLayoutContainer> MessageLayoutCache::insert(
+    const Key &key, std::unique_ptr<MessageLayoutContainer> container)
+{
+    std::shared_ptr<MessageLayoutContainer> shared(
+        container.release(), [this, key](MessageLayoutContainer *removed) {
+            this->remove(key);
+            delete removed;
+        });
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    // An existing entry belongs to a container that's about to be removed
+    auto [it, inserted] = this->entries_.try_emplace(key);
+    if (inserted)
+    {
+        static auto &messageLayoutCacheEntries =
+            Metrics::gauge("message layout cache entries");
+        messageLayoutCacheEntries.increase();
+    }
+    it->second = shared;
+
+    return shared;
+}
+
+void MessageLayoutCache::remove(const Key &key)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto it = this->entries_.find(key);
+
+    // The key might already belong to a newer container
+    if (it != this->entries_.end() && it->second.expired())
+    {
+        this->entries_.erase(it);
+
+        static auto &messageLayoutCacheEntries =
+            Metrics::gauge("message layout cache entries");
+        messageLayoutCacheEntries.decrease();
+    }
+}
+
+size_t MessageLayoutCache::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->entries_.size();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+struct Message;
+struct MessageLayoutContainer;
+
+// Laid out messages shared between all views that show the same message with
+// the same geometry.
+//
+// Messages that end up in /mentions or /live are also shown in the channel
+// they came from, and a channel can be open in several splits. Every view
+// keeps its own MessageLayout since collapsing, the alternating background
+// and the buffer belong to the view, but the laid out elements only depend on
+// the key and can be shared.
+//
+// Entries are reference counted: a container stays in the cache as long as a
+// layout holds on to it and is removed when the last one lets go. Containers
+// must not be changed after they were inserted.
+class MessageLayoutCache
+{
+public:
+    struct Key {
+        const Message *message;
+        int width;
+        float scale;
+        int64_t elementFlags;
+        // Flags the message was laid out with, e.g. without Collapsed if the
+        // layout was expanded
+        uint32_t messageFlags;
+        // WindowManager::getGeneration, changes with fonts and themes
+        int generation;
+        uint64_t renderSettingsVersion;
+
+        bool operator==(const Key &other) const;
+    };
+
+    MessageLayoutCache() = default;
+    // All containers from this cache must be gone by then
+    ~MessageLayoutCache() = default;
+
+    MessageLayoutCache(const MessageLayoutCache &) = delete;
+    MessageLayoutCache &operator=(const MessageLayoutCache &) = delete;
+
+    static MessageLayoutCache &instance();
+
+    // Returns the container for `key` if a layout still holds on to it
+    std::shared_ptr<MessageLayoutContainer> find(const Key &key);
+
+    // Shares `container` under `key` and returns it
+    std::shared_ptr<MessageLayoutContainer> insert(
+        const Key &key, std::unique_ptr<MessageLayoutContainer> container);
+
+    size_t size() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    void remove(const Key &key);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::weak_ptr<MessageLayoutContainer>, KeyHash>
+        entries_;
+};
+
+}  // namespace chatterino
@@ -1,6 +1,7 @@
 #include "MessageLayoutContainer.hpp"
 
 #include "Application.hpp"
+#include "messages/Image.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/Selection.hpp"
@@ -12,6 +13,9 @@
 #include <QDebug>
 #include <QPainter>
 
+#include <algorithm>
+#include <cassert>
+
 #define COMPACT_EMOTES_OFFSET 4
 #define MAX_UNCOLLAPSED_LINES \
     (getSettings()->collpseMessagesMinLines.getValue())
@@ -33,13 +37,22 @@ float MessageLayoutContainer::getScale() const
     return this->scale_;
 }
 
+const RenderSettings &MessageLayoutContainer::getRenderSettings() const
+{
+    assert(this->renderSettings_ != nullptr);
+
+    return *this->renderSettings_;
+}
+
 // methods
-void MessageLayoutContainer::begin(int width, float scale, MessageFlags flags)
+void MessageLayoutContainer::begin(int width, float scale, MessageFlags flags,
+                                   const RenderSettings &settings)
 {
     this->clear();
     this->width_ = width;
     this->scale_ = scale;
     this->flags_ = flags;
+    this->renderSettings_ = &settings;
     auto mediumFontMetrics =
         getApp()->fonts->getFontMetrics(FontStyle::ChatMedium, scale);
     this->textLineHeight_ = mediumFontMetrics.height();
@@ -320,6 +333,9 @@ void MessageLayoutContainer::end()
         this->lines_.back().endIndex = this->elements_.size();
         this->lines_.back().endCharIndex = this->charIndex_;
     }
+
+    // The snapshot is only borrowed for the layout pass
+    this->renderSettings_ = nullptr;
 }
 
 bool MessageLayoutContainer::canCollapse()
@@ -369,6 +385,30 @@ void MessageLayoutContainer::paintAnimatedElements(QPainter &painter,
     }
 }
 
+bool MessageLayoutContainer::hasAnimatedElements() const
+{
+    return std::any_of(this->elements_.begin(), this->elements_.end(),
+                       [](const auto &element) {
+                           return element->isAnimated();
+                       });
+}
+
+std::vector<ImagePtr> MessageLayoutContainer::getUnloadedImages() const
+{
+    std::vector<ImagePtr> images;
+
+    for (const auto &element : this->elements_)
+    {
+        auto image = element->getImage();
+        if (image && !image->isEmpty() && !image->loaded())
+        {
+            images.push_back(std::move(image));
+        }
+    }
+
+    return images;
+}
+
 void MessageLayoutContainer::paintSelection(QPainter &painter, int messageIndex,
                                             Selection &selection, int yOffset)
 {
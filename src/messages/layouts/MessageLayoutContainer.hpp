@@ -16,6 +16,7 @@ namespace chatterino {
 
 enum class MessageFlag : uint32_t;
 using MessageFlags = FlagsEnum<MessageFlag>;
+struct RenderSettings;
 
 struct Margin {
     int top;
@@ -52,9 +53,12 @@ struct MessageLayoutContainer {
     int getHeight() const;
     int getWidth() const;
     float getScale() const;
+    // Only valid between begin() and end()
+    const RenderSettings &getRenderSettings() const;
 
     // methods
-    void begin(int width_, float scale_, MessageFlags flags_);
+    void begin(int width_, float scale_, MessageFlags flags_,
+               const RenderSettings &settings);
     void end();
 
     void clear();
@@ -69,6 +73,10 @@ struct MessageLayoutContainer {
     // painting
     void paintElements(QPainter &painter);
     void paintAnimatedElements(QPainter &painter, int yOffset);
+    bool hasAnimatedElements() const;
+    // Images that are shown with a placeholder size because they haven't been
+    // loaded yet
+    std::vector<ImagePtr> getUnloadedImages() const;
     void paintSelection(QPainter &painter, int messageIndex,
                         Selection &selection, int yOffset);
 
@@ -97,6 +105,7 @@ private:
     float scale_ = 1.f;
     int width_ = 0;
     MessageFlags flags_{};
+    const RenderSettings *renderSettings_ = nullptr;
     int line_ = 0;
     int height_ = 0;
     int currentX_ = 0;
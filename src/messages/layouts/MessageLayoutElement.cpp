@@ -6,7 +6,7 @@
 #include "messages/MessageElement.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "singletons/Theme.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 
 #include <QDebug>
 #include <QPainter>
@@ -23,12 +23,16 @@ MessageLayoutElement::MessageLayoutElement(MessageElement &creator,
     : creator_(creator)
 {
     this->rect_.setSize(size);
-    DebugCount::increase("message layout elements");
+    static auto &messageLayoutElements =
+        Metrics::gauge("message layout elements");
+    messageLayoutElements.increase();
 }
 
 MessageLayoutElement::~MessageLayoutElement()
 {
-    DebugCount::decrease("message layout elements");
+    static auto &messageLayoutElements =
+        Metrics::gauge("message layout elements");
+    messageLayoutElements.decrease();
 }
 
 MessageElement &MessageLayoutElement::getCreator() const
@@ -156,6 +160,16 @@ void ImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
     }
 }
 
+bool ImageLayoutElement::isAnimated() const
+{
+    return this->image_ != nullptr && this->image_->animated();
+}
+
+ImagePtr ImageLayoutElement::getImage() const
+{
+    return this->image_;
+}
+
 int ImageLayoutElement::getMouseOverIndex(const QPoint &abs) const
 {
     return 0;
@@ -261,6 +275,16 @@ void TextLayoutElement::paintAnimated(QPainter &, int)
 {
 }
 
+bool TextLayoutElement::isAnimated() const
+{
+    return false;
+}
+
+ImagePtr TextLayoutElement::getImage() const
+{
+    return nullptr;
+}
+
 int TextLayoutElement::getMouseOverIndex(const QPoint &abs) const
 {
     if (abs.x() < this->getRect().left())
@@ -380,6 +404,16 @@ void TextIconLayoutElement::paintAnimated(QPainter &painter, int yOffset)
 {
 }
 
+bool TextIconLayoutElement::isAnimated() const
+{
+    return false;
+}
+
+ImagePtr TextIconLayoutElement::getImage() const
+{
+    return nullptr;
+}
+
 int TextIconLayoutElement::getMouseOverIndex(const QPoint &abs) const
 {
     return 0;
@@ -43,6 +43,8 @@ public:
     virtual int getSelectionIndexCount() const = 0;
     virtual void paint(QPainter &painter) = 0;
     virtual void paintAnimated(QPainter &painter, int yOffset) = 0;
+    virtual bool isAnimated() const = 0;
+    virtual ImagePtr getImage() const = 0;
     virtual int getMouseOverIndex(const QPoint &abs) const = 0;
     virtual int getXFromIndex(int index) = 0;
 
@@ -74,6 +76,8 @@ protected:
     int getSelectionIndexCount() const override;
     void paint(QPainter &painter) override;
     void paintAnimated(QPainter &painter, int yOffset) override;
+    bool isAnimated() const override;
+    ImagePtr getImage() const override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
 
@@ -109,6 +113,8 @@ protected:
     int getSelectionIndexCount() const override;
     void paint(QPainter &painter) override;
     void paintAnimated(QPainter &painter, int yOffset) override;
+    bool isAnimated() const override;
+    ImagePtr getImage() const override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
 
@@ -133,6 +139,8 @@ protected:
     int getSelectionIndexCount() const override;
     void paint(QPainter &painter) override;
     void paintAnimated(QPainter &painter, int yOffset) override;
+    bool isAnimated() const override;
+    ImagePtr getImage() const override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
 
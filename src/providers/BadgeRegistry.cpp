@@ -0,0 +1,110 @@
+#include "providers/BadgeRegistry.hpp"
+
+#include "util/Metrics.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+BadgeRegistry &BadgeRegistry::instance()
+{
+    static auto *instance = new BadgeRegistry;
+
+    return *instance;
+}
+
+boost::optional<uint64_t> BadgeRegistry::parseUserId(const QString &userId)
+{
+    bool ok = false;
+    auto id = userId.toULongLong(&ok);
+    if (!ok)
+    {
+        return boost::none;
+    }
+
+    return id;
+}
+
+void BadgeRegistry::setBadges(Source source,
+                              std::vector<Assignment> assignments)
+{
+    std::lock_guard<std::mutex> lock(this->writeMutex_);
+
+    this->sources_[size_t(source)] = std::move(assignments);
+
+    size_t size = 0;
+    for (const auto &sourceAssignments : this->sources_)
+    {
+        size += sourceAssignments.size();
+    }
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->reserve(size);
+
+    // Adding the sources in order and sorting stably keeps the badges of a
+    // user in Source order, and the badges of a source in assignment order
+    for (size_t i = 0; i < this->sources_.size(); i++)
+    {
+        for (const auto &assignment : this->sources_[i])
+        {
+            snapshot->push_back(
+                {assignment.userId, Source(i), assignment.badge});
+        }
+    }
+
+    std::stable_sort(snapshot->begin(), snapshot->end(),
+                     [](const Entry &a, const Entry &b) {
+                         return a.userId < b.userId;
+                     });
+
+    // Providers only ever showed the last badge they assigned to a user
+    auto last = std::unique(snapshot->rbegin(), snapshot->rend(),
+                            [](const Entry &a, const Entry &b) {
+                                return a.userId == b.userId &&
+                                       a.source == b.source;
+                            });
+    snapshot->erase(snapshot->begin(), last.base());
+
+    std::atomic_store(&this->snapshot_,
+                      std::shared_ptr<const Snapshot>(std::move(snapshot)));
+
+    static auto &badgeRegistryRebuilds =
+        Metrics::counter("badge registry rebuilds");
+    badgeRegistryRebuilds.increase();
+}
+
+std::vector<ThirdPartyBadge> BadgeRegistry::getBadges(
+    const QString &userId) const
+{
+    auto id = parseUserId(userId);
+    auto snapshot = std::atomic_load(&this->snapshot_);
+    if (!id || !snapshot)
+    {
+        return {};
+    }
+
+    struct Compare {
+        bool operator()(const Entry &entry, uint64_t id) const
+        {
+            return entry.userId < id;
+        }
+        bool operator()(uint64_t id, const Entry &entry) const
+        {
+            return id < entry.userId;
+        }
+    };
+
+    auto range =
+        std::equal_range(snapshot->begin(), snapshot->end(), *id, Compare{});
+
+    std::vector<ThirdPartyBadge> badges;
+    badges.reserve(std::distance(range.first, range.second));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        badges.push_back(it->badge);
+    }
+
+    return badges;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "messages/MessageElement.hpp"
+
+#include <QColor>
+#include <QString>
+#include <boost/optional.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+
+struct ThirdPartyBadge {
+    EmotePtr emote;
+    MessageElementFlag flag;
+    // FFZ badges are drawn on top of a colored background
+    boost::optional<QColor> color;
+};
+
+// Badges that third party providers assign to Twitch users.
+//
+// Every provider publishes all of its assignments at once, which builds a new
+// immutable snapshot sorted by user id. Lookups only copy the current
+// snapshot pointer and binary search it, so building messages never waits
+// for a provider that is (re)loading.
+class BadgeRegistry
+{
+public:
+    // Badges of a user are returned in this order
+    enum class Source : uint8_t {
+        Chatterino,
+        Seventv,
+        Ffz,
+        itzAlex,
+        itzAlex2,
+        itzAlex3,
+
+        Count,
+    };
+
+    struct Assignment {
+        uint64_t userId;
+        ThirdPartyBadge badge;
+    };
+
+    BadgeRegistry() = default;
+
+    static BadgeRegistry &instance();
+
+    // Returns boost::none if `userId` isn't a valid Twitch user id
+    static boost::optional<uint64_t> parseUserId(const QString &userId);
+
+    // Replaces all badges of `source`. If a user is assigned more than one
+    // badge, only the last one is kept. Can be called from any thread.
+    void setBadges(Source source, std::vector<Assignment> assignments);
+
+    // Returns the badges of the user, at most one per Source and ordered by
+    // Source
+    std::vector<ThirdPartyBadge> getBadges(const QString &userId) const;
+
+private:
+    struct Entry {
+        uint64_t userId;
+        Source source;
+        ThirdPartyBadge badge;
+    };
+    using Snapshot = std::vector<Entry>;
+
+    // Only used with std::atomic_load/std::atomic_store
+    std::shared_ptr<const Snapshot> snapshot_;
+
+    // Only taken by providers publishing their badges
+    std::mutex writeMutex_;
+    std::array<std::vector<Assignment>, size_t(Source::Count)> sources_;
+};
+
+}  // namespace chatterino
@@ -3,61 +3,233 @@
 #include "common/Common.hpp"
 #include "common/Env.hpp"
 #include "common/NetworkRequest.hpp"
+#include "lrucache/lrucache.hpp"
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
 #include "singletons/Settings.hpp"
+#include "util/Metrics.hpp"
+#include "util/QStringHash.hpp"
 
+#include <QPointer>
 #include <QString>
+#include <boost/optional.hpp>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace chatterino {
 
-void LinkResolver::getLinkInfo(
-    const QString url, QObject *caller,
-    std::function<void(QString, Link, ImagePtr)> successCallback)
-{
-    if (!getSettings()->linkInfoTooltip)
+namespace {
+
+    // Enough for the links of a few hours of busy chats
+    constexpr size_t LINK_INFO_CACHE_SIZE = 2000;
+
+    struct LinkInfo {
+        QString tooltip;
+        // Only set if the resolver knew the link
+        boost::optional<QString> link;
+        QString thumbnail;
+    };
+
+    struct PendingLookup {
+        bool hasCaller;
+        QPointer<QObject> caller;
+        LinkResolver::Callback callback;
+    };
+
+    struct PendingUrl {
+        // Priority of the most urgent request made for the url
+        NetworkRequestPriority priority;
+        std::vector<PendingLookup> lookups;
+    };
+
+    struct State {
+        std::mutex mutex;
+        cache::lru_cache<QString, LinkInfo> resolved{LINK_INFO_CACHE_SIZE};
+        std::unordered_map<QString, PendingUrl> pending;
+        QString resolverUrl = Env::get().linkResolverUrl;
+    };
+
+    State &getState()
     {
-        successCallback("No link info loaded", Link(Link::Url, url), nullptr);
-        return;
+        static auto *state = new State;
+
+        return *state;
+    }
+
+    void deliver(const QString &url, const LinkInfo &info,
+                 const LinkResolver::Callback &callback)
+    {
+        if (!info.link)
+        {
+            callback(info.tooltip, Link(Link::Url, url), nullptr);
+            return;
+        }
+
+        // Checked here instead of when resolving, so changing the setting
+        // also applies to links that were resolved before
+        auto link = getSettings()->unshortLinks ? *info.link : url;
+
+        // Thumbnails are only loaded once the tooltip is shown
+        callback(info.tooltip, Link(Link::Url, link),
+                 Image::fromUrl({info.thumbnail}));
+    }
+
+    // `info` is boost::none if the url couldn't be resolved. Only links the
+    // resolver knew are cached, so the next lookup of others tries again.
+    void finish(const QString &url, const boost::optional<LinkInfo> &info)
+    {
+        auto &state = getState();
+        std::vector<PendingLookup> lookups;
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            if (info && info->link)
+            {
+                state.resolved.put(url, *info);
+            }
+
+            auto it = state.pending.find(url);
+            if (it != state.pending.end())
+            {
+                lookups = std::move(it->second.lookups);
+                state.pending.erase(it);
+            }
+        }
+
+        for (const auto &lookup : lookups)
+        {
+            if (lookup.hasCaller && lookup.caller.isNull())
+            {
+                continue;
+            }
+
+            if (info)
+            {
+                deliver(url, *info, lookup.callback);
+            }
+            else
+            {
+                lookup.callback("No link info found", Link(Link::Url, url),
+                                nullptr);
+            }
+        }
     }
-    // Uncomment to test crashes
-    // QTimer::singleShot(3000, [=]() {
-    NetworkRequest(Env::get().linkResolverUrl.arg(QString::fromUtf8(
-                       QUrl::toPercentEncoding(url, "", "/:"))))
-        .caller(caller)
-        .timeout(30000)
-        .onSuccess(
-            [successCallback, url](NetworkResult result) mutable -> Outcome {
+
+    // Several requests can be made for the same url, only the first one to
+    // finish is delivered to the pending lookups
+    void resolve(const QString &resolverUrl, const QString &url,
+                 NetworkRequestPriority priority)
+    {
+        NetworkRequest(resolverUrl.arg(QString::fromUtf8(
+                           QUrl::toPercentEncoding(url, "", "/:"))))
+            .priority(priority)
+            .timeout(30000)
+            .onSuccess([url](NetworkResult result) -> Outcome {
                 auto root = result.parseJson();
                 auto statusCode = root.value("status").toInt();
-                QString response = QString();
-                QString linkString = url;
-                ImagePtr thumbnail = nullptr;
+
+                LinkInfo info;
                 if (statusCode == 200)
                 {
-                    response = root.value("tooltip").toString();
-                    thumbnail =
-                        Image::fromUrl({root.value("thumbnail").toString()});
-                    if (getSettings()->unshortLinks)
-                    {
-                        linkString = root.value("link").toString();
-                    }
+                    info.tooltip = root.value("tooltip").toString();
+                    info.link = root.value("link").toString();
+                    info.thumbnail = root.value("thumbnail").toString();
                 }
                 else
                 {
-                    response = root.value("message").toString();
+                    info.tooltip = root.value("message").toString();
                 }
-                successCallback(QUrl::fromPercentEncoding(response.toUtf8()),
-                                Link(Link::Url, linkString), thumbnail);
+                info.tooltip = QUrl::fromPercentEncoding(info.tooltip.toUtf8());
+
+                finish(url, info);
 
                 return Success;
             })
-        .onError([successCallback, url](auto /*result*/) {
-            successCallback("No link info found", Link(Link::Url, url),
-                            nullptr);
-        })
-        .execute();
-    // });
+            .onError([url](auto /*result*/) {
+                finish(url, boost::none);
+            })
+            .execute();
+    }
+
+}  // namespace
+
+void LinkResolver::getLinkInfo(const QString url, QObject *caller,
+                               Callback callback,
+                               NetworkRequestPriority priority)
+{
+    if (!getSettings()->linkInfoTooltip)
+    {
+        callback("No link info loaded", Link(Link::Url, url), nullptr);
+        return;
+    }
+
+    auto &state = getState();
+    QString resolverUrl;
+
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+
+        if (state.resolved.exists(url))
+        {
+            auto info = state.resolved.get(url);
+            lock.unlock();
+
+            static auto &linkInfoCacheHit =
+                Metrics::counter("link info cache hit");
+            linkInfoCacheHit.increase();
+
+            deliver(url, info, callback);
+            return;
+        }
+
+        auto [it, inserted] = state.pending.try_emplace(url);
+        auto &pending = it->second;
+        pending.lookups.push_back(
+            {caller != nullptr, caller, std::move(callback)});
+
+        if (inserted)
+        {
+            pending.priority = priority;
+        }
+        else
+        {
+            // The url is already being resolved
+            static auto &linkInfoRequestsSaved =
+                Metrics::counter("link info requests saved");
+            linkInfoRequestsSaved.increase();
+
+            // Lower values are more urgent
+            if (priority >= pending.priority)
+            {
+                return;
+            }
+
+            // E.g. a hover joined a prefetch from MessageBuilder::addLink.
+            // The request is made again at the higher priority, the network
+            // scheduler merges it with the pending one and starts that one
+            // sooner, so the url is still only fetched once.
+            pending.priority = priority;
+
+            static auto &linkInfoRequestsPromoted =
+                Metrics::counter("link info requests promoted");
+            linkInfoRequestsPromoted.increase();
+        }
+
+        resolverUrl = state.resolverUrl;
+    }
+
+    resolve(resolverUrl, url, priority);
+}
+
+void LinkResolver::setResolverUrl(const QString &resolverUrl)
+{
+    auto &state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    state.resolverUrl = resolverUrl;
 }
 
 }  // namespace chatterino
@@ -3,17 +3,33 @@
 #include <QString>
 #include <functional>
 
+#include "common/NetworkCommon.hpp"
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
 
+class QObject;
+
 namespace chatterino {
 
 class LinkResolver
 {
 public:
+    using Callback = std::function<void(QString, Link, ImagePtr)>;
+
+    // Resolves the tooltip, thumbnail and unshortened link of `url`.
+    //
+    // Results the resolver knew are kept in memory, so those urls are only
+    // resolved once. Lookups of a url that is still being resolved wait
+    // for the same request, which is sped up if they're more urgent than the
+    // lookup that started it. `callback` is called right away if the url was
+    // resolved before, and skipped if `caller` was destroyed in the meantime.
     static void getLinkInfo(
-        const QString url, QObject *caller,
-        std::function<void(QString, Link, ImagePtr)> callback);
+        const QString url, QObject *caller, Callback callback,
+        NetworkRequestPriority priority = NetworkRequestPriority::Interactive);
+
+    // Defaults to Env::linkResolverUrl, `%1` is replaced with the url to
+    // resolve. Lets tests use a local stand-in resolver.
+    static void setResolverUrl(const QString &resolverUrl);
 };
 
 }  // namespace chatterino
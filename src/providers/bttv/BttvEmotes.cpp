@@ -6,6 +6,7 @@
 #include "common/Common.hpp"
 #include "common/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
@@ -18,6 +19,9 @@ namespace {
     const QString CHANNEL_HAS_NO_EMOTES(
         "This channel has no BetterTTV channel emotes.");
 
+    const QString GLOBAL_SNAPSHOT("bttv-global");
+    const QString CHANNEL_SNAPSHOT_PREFIX("bttv-channel-");
+
     QString emoteLinkFormat("https://betterttv.com/emotes/%1");
 
     Url getEmoteLink(QString urlTemplate, const EmoteId &id,
@@ -38,10 +42,9 @@ namespace {
     }
     EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
     {
-        static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-        static std::mutex mutex;
+        static WeakEmoteIdRegistry registry("bttv emote registry");
 
-        return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+        return cachedOrMakeEmotePtr(std::move(emote), registry, id);
     }
     std::pair<Outcome, EmoteMap> parseGlobalEmotes(
         const QJsonArray &jsonEmotes, const EmoteMap &currentEmotes)
@@ -225,15 +228,36 @@ void BttvEmotes::addEmote(QString emoteID, TwitchChannel *channel)
 
 void BttvEmotes::loadEmotes()
 {
+    auto apply = [this](const QJsonArray &jsonRoot) -> Outcome {
+        auto emotes = this->global_.get();
+        auto pair = parseGlobalEmotes(jsonRoot, *emotes);
+        if (pair.first)
+            this->global_.set(
+                std::make_shared<EmoteMap>(std::move(pair.second)));
+        return pair.first;
+    };
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (this->global_.get()->empty())
+    {
+        SnapshotStore::load(GLOBAL_SNAPSHOT, fresh,
+                            [apply](const QJsonValue &snapshot) {
+                                apply(snapshot.toArray());
+                            });
+    }
+
     NetworkRequest(QString(globalEmoteApiUrl))
         .timeout(30000)
-        .onSuccess([this](auto result) -> Outcome {
-            auto emotes = this->global_.get();
-            auto pair = parseGlobalEmotes(result.parseJsonArray(), *emotes);
-            if (pair.first)
-                this->global_.set(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
-            return pair.first;
+        .onSuccess([apply, fresh](auto result) -> Outcome {
+            auto jsonRoot = result.parseJsonArray();
+            auto outcome = apply(jsonRoot);
+            if (outcome == Success)
+            {
+                *fresh = true;
+                SnapshotStore::save(GLOBAL_SNAPSHOT, jsonRoot);
+            }
+            return outcome;
         })
         .execute();
 }
@@ -244,18 +268,43 @@ void BttvEmotes::loadChannel(std::weak_ptr<Channel> channel,
                              std::function<void(EmoteMap &&)> callback,
                              bool manualRefresh)
 {
+    auto shared = channel.lock();
+    if (!shared)
+    {
+        return;
+    }
+
+    auto snapshotName = SnapshotStore::channelSnapshot(
+        shared->getName(), CHANNEL_SNAPSHOT_PREFIX + channelId);
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (!manualRefresh)
+    {
+        SnapshotStore::load(
+            snapshotName, fresh,
+            [callback, channelDisplayName](const QJsonValue &snapshot) {
+                auto pair = parseChannelEmotes(snapshot.toObject(),
+                                               channelDisplayName);
+                if (pair.first)
+                    callback(std::move(pair.second));
+            });
+    }
+
     NetworkRequest(QString(bttvChannelEmoteApiUrl) + channelId)
         .timeout(20000)
         .onSuccess([callback = std::move(callback), channel,
-                    &channelDisplayName,
-                    manualRefresh](auto result) -> Outcome {
-            auto pair =
-                parseChannelEmotes(result.parseJson(), channelDisplayName);
+                    &channelDisplayName, manualRefresh, snapshotName,
+                    fresh](auto result) -> Outcome {
+            auto jsonRoot = result.parseJson();
+            auto pair = parseChannelEmotes(jsonRoot, channelDisplayName);
             bool hasEmotes = false;
             if (pair.first)
             {
                 hasEmotes = !pair.second.empty();
+                *fresh = true;
                 callback(std::move(pair.second));
+                SnapshotStore::save(snapshotName, jsonRoot);
             }
             if (auto shared = channel.lock(); manualRefresh)
             {
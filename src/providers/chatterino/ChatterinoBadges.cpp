@@ -7,7 +7,9 @@
 #include <QUrl>
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
+#include "providers/BadgeRegistry.hpp"
 
 namespace chatterino {
 void ChatterinoBadges::initialize(Settings &settings, Paths &paths)
@@ -19,54 +21,56 @@ ChatterinoBadges::ChatterinoBadges()
 {
 }
 
-boost::optional<EmotePtr> ChatterinoBadges::getBadge(const UserId &id)
-{
-    std::shared_lock lock(this->mutex_);
-
-    auto it = badgeMap.find(id.string);
-    if (it != badgeMap.end())
-    {
-        return emotes[it->second];
-    }
-    return boost::none;
-}
-
 void ChatterinoBadges::loadChatterinoBadges()
 {
-    badgeMap.clear();
-    emotes.clear();
+    // Show the badges from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    SnapshotStore::load("chatterino-badges", fresh,
+                        [this](const QJsonValue &snapshot) {
+                            this->parseBadges(snapshot.toObject());
+                        });
 
     static QUrl url("https://api.chatterino.com/badges");
 
     NetworkRequest(url)
         .concurrent()
-        .onSuccess([this](auto result) -> Outcome {
+        .priority(NetworkRequestPriority::Background)
+        .onSuccess([this, fresh](auto result) -> Outcome {
+            *fresh = true;
             auto jsonRoot = result.parseJson();
+            this->parseBadges(jsonRoot);
+            SnapshotStore::save("chatterino-badges", jsonRoot);
 
-            std::unique_lock lock(this->mutex_);
+            return Success;
+        })
+        .execute();
+}
 
-            int index = 0;
-            for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
-            {
-                auto jsonBadge = jsonBadge_.toObject();
-                auto emote = Emote{
-                    EmoteName{},
-                    ImageSet{Url{jsonBadge.value("image1").toString()},
-                             Url{jsonBadge.value("image2").toString()},
-                             Url{jsonBadge.value("image3").toString()}},
-                    Tooltip{jsonBadge.value("tooltip").toString()}, Url{}};
+void ChatterinoBadges::parseBadges(const QJsonObject &jsonRoot)
+{
+    std::vector<BadgeRegistry::Assignment> assignments;
 
-                emotes.push_back(
-                    std::make_shared<const Emote>(std::move(emote)));
+    for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
+    {
+        auto jsonBadge = jsonBadge_.toObject();
+        auto emote = std::make_shared<const Emote>(Emote{
+            EmoteName{},
+            ImageSet{Url{jsonBadge.value("image1").toString()},
+                     Url{jsonBadge.value("image2").toString()},
+                     Url{jsonBadge.value("image3").toString()}},
+            Tooltip{jsonBadge.value("tooltip").toString()}, Url{}});
 
-                for (const auto &user : jsonBadge.value("users").toArray())
-                {
-                    badgeMap[user.toString()] = index;
-                }
-                ++index;
+        for (const auto &user : jsonBadge.value("users").toArray())
+        {
+            if (auto id = BadgeRegistry::parseUserId(user.toString()))
+            {
+                assignments.push_back(
+                    {*id, {emote, MessageElementFlag::BadgeChatterino, {}}});
             }
-            return Success;
-        })
-        .execute();
+        }
+    }
+
+    BadgeRegistry::instance().setBadges(BadgeRegistry::Source::Chatterino,
+                                        std::move(assignments));
 }
 }  // namespace chatterino
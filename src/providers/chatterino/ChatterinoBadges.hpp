@@ -1,19 +1,11 @@
 #pragma once
 
-#include <boost/optional.hpp>
+#include <QJsonObject>
 #include <common/Singleton.hpp>
-#include <memory>
-#include <shared_mutex>
-#include <unordered_map>
-#include <vector>
-#include "common/Aliases.hpp"
-#include "util/QStringHash.hpp"
 
 namespace chatterino {
 
-struct Emote;
-using EmotePtr = std::shared_ptr<const Emote>;
-
+// Loads the Chatterino badges into the BadgeRegistry
 class ChatterinoBadges : public Singleton
 {
 public:
@@ -21,13 +13,8 @@ public:
     ChatterinoBadges();
     void loadChatterinoBadges();
 
-    boost::optional<EmotePtr> getBadge(const UserId &id);
-
 private:
-    std::shared_mutex mutex_;
-
-    std::unordered_map<QString, int> badgeMap;
-    std::vector<EmotePtr> emotes;
+    void parseBadges(const QJsonObject &jsonRoot);
 };
 
 }  // namespace chatterino
@@ -5,11 +5,11 @@
 #include <QJsonValue>
 #include <QThread>
 #include <QUrl>
-#include <map>
-#include <shared_mutex>
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
+#include "providers/BadgeRegistry.hpp"
 
 namespace chatterino {
 
@@ -18,76 +18,26 @@ void FfzBadges::initialize(Settings &settings, Paths &paths)
     this->loadFfzBadges();
 }
 
-boost::optional<EmotePtr> FfzBadges::getBadge(const UserId &id)
-{
-    std::shared_lock lock(this->mutex_);
-
-    auto it = this->badgeMap.find(id.string);
-    if (it != this->badgeMap.end())
-    {
-        return this->badges[it->second];
-    }
-    return boost::none;
-}
-boost::optional<QColor> FfzBadges::getBadgeColor(const UserId &id)
-{
-    std::shared_lock lock(this->mutex_);
-
-    auto badgeIt = this->badgeMap.find(id.string);
-    if (badgeIt != this->badgeMap.end())
-    {
-        auto colorIt = this->colorMap.find(badgeIt->second);
-        if (colorIt != this->colorMap.end())
-        {
-            return colorIt->second;
-        }
-        return boost::none;
-    }
-    return boost::none;
-}
-
 void FfzBadges::loadFfzBadges()
 {
-    badgeMap.clear();
-    badges.clear();
-    colorMap.clear();
+    // Show the badges from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    SnapshotStore::load("ffz-badges", fresh,
+                        [this](const QJsonValue &snapshot) {
+                            this->parseBadges(snapshot.toObject());
+                        });
 
     static QUrl url("https://api.frankerfacez.com/v1/badges/ids");
 
     NetworkRequest(url)
-        .onSuccess([this](auto result) -> Outcome {
-            std::unique_lock lock(this->mutex_);
-
+        .priority(NetworkRequestPriority::Background)
+        .onSuccess([this, fresh](auto result) -> Outcome {
+            *fresh = true;
             auto jsonRoot = result.parseJson();
-            int index = 0;
-            for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
+            this->parseBadges(jsonRoot);
+            if (!jsonRoot.value("badges").toArray().isEmpty())
             {
-                auto jsonBadge = jsonBadge_.toObject();
-                auto jsonUrls = jsonBadge.value("urls").toObject();
-
-                auto emote = Emote{
-                    EmoteName{},
-                    ImageSet{
-                        Url{QString("https:") + jsonUrls.value("1").toString()},
-                        Url{QString("https:") + jsonUrls.value("2").toString()},
-                        Url{QString("https:") +
-                            jsonUrls.value("4").toString()}},
-                    Tooltip{jsonBadge.value("title").toString()}, Url{}};
-
-                this->badges.push_back(
-                    std::make_shared<const Emote>(std::move(emote)));
-                this->colorMap[index] =
-                    QColor(jsonBadge.value("color").toString());
-
-                auto badgeId = QString::number(jsonBadge.value("id").toInt());
-                for (const auto &user : jsonRoot.value("users")
-                                            .toObject()
-                                            .value(badgeId)
-                                            .toArray())
-                {
-                    this->badgeMap[QString::number(user.toInt())] = index;
-                }
-                ++index;
+                SnapshotStore::save("ffz-badges", jsonRoot);
             }
 
             return Success;
@@ -95,4 +45,40 @@ void FfzBadges::loadFfzBadges()
         .execute();
 }
 
+void FfzBadges::parseBadges(const QJsonObject &jsonRoot)
+{
+    std::vector<BadgeRegistry::Assignment> assignments;
+
+    for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
+    {
+        auto jsonBadge = jsonBadge_.toObject();
+        auto jsonUrls = jsonBadge.value("urls").toObject();
+
+        auto emote = std::make_shared<const Emote>(Emote{
+            EmoteName{},
+            ImageSet{Url{QString("https:") + jsonUrls.value("1").toString()},
+                     Url{QString("https:") + jsonUrls.value("2").toString()},
+                     Url{QString("https:") + jsonUrls.value("4").toString()}},
+            Tooltip{jsonBadge.value("title").toString()}, Url{}});
+        auto color = QColor(jsonBadge.value("color").toString());
+
+        auto badgeId = QString::number(jsonBadge.value("id").toInt());
+        for (const auto &user :
+             jsonRoot.value("users").toObject().value(badgeId).toArray())
+        {
+            if (!user.isDouble())
+            {
+                continue;
+            }
+
+            assignments.push_back(
+                {uint64_t(user.toDouble()),
+                 {emote, MessageElementFlag::BadgeFfz, color}});
+        }
+    }
+
+    BadgeRegistry::instance().setBadges(BadgeRegistry::Source::Ffz,
+                                        std::move(assignments));
+}
+
 }  // namespace chatterino
@@ -1,23 +1,11 @@
 #pragma once
 
-#include <boost/optional.hpp>
+#include <QJsonObject>
 #include <common/Singleton.hpp>
 
-#include "common/Aliases.hpp"
-#include "util/QStringHash.hpp"
-
-#include <map>
-#include <memory>
-#include <shared_mutex>
-#include <vector>
-
-#include <QColor>
-
 namespace chatterino {
 
-struct Emote;
-using EmotePtr = std::shared_ptr<const Emote>;
-
+// Loads the FrankerFaceZ badges into the BadgeRegistry
 class FfzBadges : public Singleton
 {
 public:
@@ -25,15 +13,8 @@ public:
     FfzBadges() = default;
     void loadFfzBadges();
 
-    boost::optional<EmotePtr> getBadge(const UserId &id);
-    boost::optional<QColor> getBadgeColor(const UserId &id);
-
 private:
-    std::shared_mutex mutex_;
-
-    std::unordered_map<QString, int> badgeMap;
-    std::vector<EmotePtr> badges;
-    std::unordered_map<int, QColor> colorMap;
+    void parseBadges(const QJsonObject &jsonRoot);
 };
 
 }  // namespace chatterino
@@ -5,6 +5,7 @@
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -16,6 +17,9 @@ namespace {
     const QString CHANNEL_HAS_NO_EMOTES(
         "This channel has no FrankerFaceZ channel emotes.");
 
+    const QString GLOBAL_SNAPSHOT("ffz-global");
+    const QString CHANNEL_SNAPSHOT_PREFIX("ffz-channel-");
+
     Url getEmoteLink(const QJsonObject &urls, const QString &emoteScale)
     {
         auto emote = urls.value(emoteScale);
@@ -47,10 +51,9 @@ namespace {
     }
     EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
     {
-        static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-        static std::mutex mutex;
+        static WeakEmoteIdRegistry registry("ffz emote registry");
 
-        return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+        return cachedOrMakeEmotePtr(std::move(emote), registry, id);
     }
     std::pair<Outcome, EmoteMap> parseGlobalEmotes(
         const QJsonObject &jsonRoot, const EmoteMap &currentEmotes)
@@ -183,16 +186,37 @@ void FfzEmotes::loadEmotes()
 {
     QString url("https://api.frankerfacez.com/v1/set/global");
 
+    auto apply = [this](const QJsonObject &jsonRoot) -> Outcome {
+        auto emotes = this->emotes();
+        auto pair = parseGlobalEmotes(jsonRoot, *emotes);
+        if (pair.first)
+            this->global_.set(
+                std::make_shared<EmoteMap>(std::move(pair.second)));
+        return pair.first;
+    };
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (this->emotes()->empty())
+    {
+        SnapshotStore::load(GLOBAL_SNAPSHOT, fresh,
+                            [apply](const QJsonValue &snapshot) {
+                                apply(snapshot.toObject());
+                            });
+    }
+
     NetworkRequest(url)
 
         .timeout(30000)
-        .onSuccess([this](auto result) -> Outcome {
-            auto emotes = this->emotes();
-            auto pair = parseGlobalEmotes(result.parseJson(), *emotes);
-            if (pair.first)
-                this->global_.set(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
-            return pair.first;
+        .onSuccess([apply, fresh](auto result) -> Outcome {
+            auto jsonRoot = result.parseJson();
+            auto outcome = apply(jsonRoot);
+            if (outcome == Success)
+            {
+                *fresh = true;
+                SnapshotStore::save(GLOBAL_SNAPSHOT, jsonRoot);
+            }
+            return outcome;
         })
         .execute();
 }
@@ -207,27 +231,61 @@ void FfzEmotes::loadChannel(
     qCDebug(chatterinoFfzemotes)
         << "[FFZEmotes] Reload FFZ Channel Emotes for channel" << channelId;
 
+    // Returns whether the channel has any emotes
+    auto apply = [emoteCallback = std::move(emoteCallback),
+                  modBadgeCallback = std::move(modBadgeCallback),
+                  vipBadgeCallback = std::move(vipBadgeCallback)](
+                     const QJsonObject &json) {
+        auto emoteMap = parseChannelEmotes(json);
+        auto modBadge = parseAuthorityBadge(
+            json.value("room").toObject().value("mod_urls").toObject(),
+            "Moderator");
+        auto vipBadge = parseAuthorityBadge(
+            json.value("room").toObject().value("vip_badge").toObject(),
+            "VIP");
+
+        bool hasEmotes = !emoteMap.empty();
+
+        emoteCallback(std::move(emoteMap));
+        modBadgeCallback(std::move(modBadge));
+        vipBadgeCallback(std::move(vipBadge));
+
+        return hasEmotes;
+    };
+
+    auto shared = channel.lock();
+    if (!shared)
+    {
+        return;
+    }
+
+    auto snapshotName = SnapshotStore::channelSnapshot(
+        shared->getName(), CHANNEL_SNAPSHOT_PREFIX + channelId);
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (!manualRefresh)
+    {
+        SnapshotStore::load(snapshotName, fresh,
+                            [apply](const QJsonValue &snapshot) {
+                                apply(snapshot.toObject());
+                            });
+    }
+
     NetworkRequest("https://api.frankerfacez.com/v1/room/id/" + channelId)
 
         .timeout(20000)
-        .onSuccess([emoteCallback = std::move(emoteCallback),
-                    modBadgeCallback = std::move(modBadgeCallback),
-                    vipBadgeCallback = std::move(vipBadgeCallback), channel,
-                    manualRefresh](auto result) -> Outcome {
+        .onSuccess([apply, channel, manualRefresh, snapshotName,
+                    fresh](auto result) -> Outcome {
+            *fresh = true;
             auto json = result.parseJson();
-            auto emoteMap = parseChannelEmotes(json);
-            auto modBadge = parseAuthorityBadge(
-                json.value("room").toObject().value("mod_urls").toObject(),
-                "Moderator");
-            auto vipBadge = parseAuthorityBadge(
-                json.value("room").toObject().value("vip_badge").toObject(),
-                "VIP");
-
-            bool hasEmotes = !emoteMap.empty();
-
-            emoteCallback(std::move(emoteMap));
-            modBadgeCallback(std::move(modBadge));
-            vipBadgeCallback(std::move(vipBadge));
+            bool hasEmotes = apply(json);
+            // A broken response shouldn't replace the last good one
+            if (hasEmotes)
+            {
+                SnapshotStore::save(snapshotName, json);
+            }
+
             if (auto shared = channel.lock(); manualRefresh)
             {
                 if (hasEmotes)
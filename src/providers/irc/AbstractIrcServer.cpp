@@ -8,6 +8,7 @@
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "util/Metrics.hpp"
 
 #include <QCoreApplication>
 
@@ -63,11 +64,19 @@ AbstractIrcServer::AbstractIrcServer()
     QObject::connect(this->readConnection_.get(),
                      &Communi::IrcConnection::messageReceived, this,
                      [this](auto msg) {
+                         static auto &ircHandling =
+                             Metrics::histogram("irc message handling");
+                         MetricTimer timer(ircHandling);
+
                          this->readConnectionMessageReceived(msg);
                      });
     QObject::connect(this->readConnection_.get(),
                      &Communi::IrcConnection::privateMessageReceived, this,
                      [this](auto msg) {
+                         static auto &ircHandling =
+                             Metrics::histogram("irc message handling");
+                         MetricTimer timer(ircHandling);
+
                          getApp()->commands->newMessageReceived(*msg);
                          this->privateMessageReceived(msg);
                      });
@@ -201,7 +210,8 @@ void AbstractIrcServer::writeConnectionMessageReceived(
     (void)message;
 }
 
-ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
+ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName,
+                                              bool deferActivation)
 {
     auto channelName = this->cleanChannelName(dirtyChannelName);
 
@@ -209,6 +219,11 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
     ChannelPtr chan = this->getChannelOrEmpty(channelName);
     if (chan != Channel::getEmpty())
     {
+        if (!deferActivation)
+        {
+            chan->activate();
+        }
+
         return chan;
     }
 
@@ -235,8 +250,8 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
         }
     });
 
-    // join IRC channel
-    {
+    // join IRC channel once the channel is activated
+    this->connections_.managedConnect(chan->activated, [this, channelName] {
         std::lock_guard<std::mutex> lock2(this->connectionMutex_);
 
         if (this->readConnection_)
@@ -246,6 +261,11 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
                 this->joinBucket_->send(channelName);
             }
         }
+    });
+
+    if (!deferActivation)
+    {
+        chan->activate();
     }
 
     return chan;
@@ -298,10 +318,11 @@ void AbstractIrcServer::onReadConnected(IrcConnection *connection)
 
     std::lock_guard lock(this->channelMutex);
 
-    // join channels
+    // join channels, deferred channels are joined once they get activated
     for (auto &&weak : this->channels)
     {
-        if (auto channel = weak.lock())
+        auto channel = weak.lock();
+        if (channel && channel->isActivated())
         {
             this->joinBucket_->send(channel->getName());
         }
@@ -34,7 +34,10 @@ public:
     void sendRawMessage(const QString &rawMessage);
 
     // channels
-    ChannelPtr getOrAddChannel(const QString &dirtyChannelName);
+    // If deferActivation is true, a newly created channel is only registered.
+    // It will not be joined until Channel::activate is called on it.
+    ChannelPtr getOrAddChannel(const QString &dirtyChannelName,
+                               bool deferActivation = false);
     ChannelPtr getChannelOrEmpty(const QString &dirtyChannelName);
     std::vector<std::weak_ptr<Channel>> getChannels();
 
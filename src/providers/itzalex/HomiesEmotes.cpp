@@ -3,6 +3,7 @@
 #include "common/Common.hpp"
 #include "common/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
@@ -18,6 +19,9 @@ namespace {
     const QString CHANNEL_HAS_NO_EMOTES(
         "This channel has no Homies channel emotes.");
 
+    const QString GLOBAL_SNAPSHOT("homies-global");
+    const QString CHANNEL_SNAPSHOT_PREFIX("homies-channel-");
+
     const QString emoteLinkFormat("https://7tv.app/emotes/%1");
 
     Url getEmoteLink(const EmoteId &id, const QString &emoteScale)
@@ -29,10 +33,9 @@ namespace {
 
     EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
     {
-        static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-        static std::mutex mutex;
+        static WeakEmoteIdRegistry registry("homies emote registry");
 
-        return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+        return cachedOrMakeEmotePtr(std::move(emote), registry, id);
     }
 
     struct CreateEmoteResult {
@@ -121,8 +124,26 @@ void HomiesEmotes::loadEmotes()
 {
     qCDebug(chatterinoHomies) << "Loading Homies Emotes";
 
+    auto apply = [this](const QJsonArray &parsedEmotes) -> Outcome {
+        auto pair = parseGlobalEmotes(parsedEmotes, *this->global_.get());
+        if (pair.first)
+            this->global_.set(
+                std::make_shared<EmoteMap>(std::move(pair.second)));
+        return pair.first;
+    };
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (this->global_.get()->empty())
+    {
+        SnapshotStore::load(GLOBAL_SNAPSHOT, fresh,
+                            [apply](const QJsonValue &snapshot) {
+                                apply(snapshot.toArray());
+                            });
+    }
+
     NetworkRequest(apiUrl)
-        .onSuccess([this](NetworkResult result) -> Outcome {
+        .onSuccess([apply, fresh](NetworkResult result) -> Outcome {
             QJsonArray parsedEmotes = result.parseJson()
                                           .value("data")
                                           .toObject()
@@ -132,11 +153,13 @@ void HomiesEmotes::loadEmotes()
             qCDebug(chatterinoHomies)
                 << "Homies Global Emotes" << parsedEmotes.size();
 
-            auto pair = parseGlobalEmotes(parsedEmotes, *this->global_.get());
-            if (pair.first)
-                this->global_.set(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
-            return pair.first;
+            auto outcome = apply(parsedEmotes);
+            if (outcome == Success)
+            {
+                *fresh = true;
+                SnapshotStore::save(GLOBAL_SNAPSHOT, parsedEmotes);
+            }
+            return outcome;
         })
         .execute();
 }
@@ -149,9 +172,35 @@ void HomiesEmotes::loadChannel(std::weak_ptr<Channel> channel,
     qCDebug(chatterinoHomies)
         << "Reloading Homies Channel Emotes" << channelId << manualRefresh;
 
+    auto shared = channel.lock();
+    if (!shared)
+    {
+        return;
+    }
+
+    auto snapshotName = SnapshotStore::channelSnapshot(
+        shared->getName(), CHANNEL_SNAPSHOT_PREFIX + channelId);
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (!manualRefresh)
+    {
+        SnapshotStore::load(
+            snapshotName, fresh,
+            [callback, channelId](const QJsonValue &snapshot) {
+                auto emoteMap =
+                    parseChannelEmotes(snapshot.toObject(), channelId);
+                if (!emoteMap.empty())
+                {
+                    callback(std::move(emoteMap));
+                }
+            });
+    }
+
     NetworkRequest(apiUrl)
         .onSuccess([callback = std::move(callback), channel, channelId,
-                    manualRefresh](NetworkResult result) -> Outcome {
+                    manualRefresh, snapshotName,
+                    fresh](NetworkResult result) -> Outcome {
             QJsonObject parsedEmotes = result.parseJson()
                                            .value("data")
                                            .toObject()
@@ -162,6 +211,8 @@ void HomiesEmotes::loadChannel(std::weak_ptr<Channel> channel,
 
             auto emoteMap = parseChannelEmotes(parsedEmotes, channelId);
             bool hasEmotes = !emoteMap.empty();
+            *fresh = true;
+            SnapshotStore::save(snapshotName, parsedEmotes);
 
             qCDebug(chatterinoHomies)
                 << "Loaded Homies Channel Emotes" << channelId
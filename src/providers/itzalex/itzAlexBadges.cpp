@@ -8,6 +8,7 @@
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
 #include "messages/Emote.hpp"
+#include "providers/BadgeRegistry.hpp"
 
 namespace chatterino {
 void itzAlexBadges::initialize(Settings &settings, Paths &paths)
@@ -19,145 +20,87 @@ itzAlexBadges::itzAlexBadges()
 {
 }
 
-boost::optional<EmotePtr> itzAlexBadges::getBadge(const UserId &id)
-{
-    std::shared_lock lock(this->mutex_);
+namespace {
 
-    auto it = badgeMap.find(id.string);
-    if (it != badgeMap.end())
+    EmotePtr parseBadgeEmote(const QJsonObject &jsonBadge)
     {
-        return emotes[it->second];
+        return std::make_shared<const Emote>(Emote{
+            EmoteName{},
+            ImageSet{Url{jsonBadge.value("image1").toString()},
+                     Url{jsonBadge.value("image2").toString()},
+                     Url{jsonBadge.value("image3").toString()}},
+            Tooltip{jsonBadge.value("tooltip").toString()}, Url{}});
     }
-    return boost::none;
-}
-
-boost::optional<EmotePtr> itzAlexBadges::getBadge2(const UserId &id)
-{
-    std::shared_lock lock(this->mutex_);
 
-    auto it = badgeMap2.find(id.string);
-    if (it != badgeMap2.end())
+    void addAssignment(std::vector<BadgeRegistry::Assignment> &assignments,
+                       const QString &userId, const EmotePtr &emote)
     {
-        return emotes2[it->second];
+        if (auto id = BadgeRegistry::parseUserId(userId))
+        {
+            assignments.push_back(
+                {*id, {emote, MessageElementFlag::BadgeitzAlex, {}}});
+        }
     }
-    return boost::none;
-}
-
-boost::optional<EmotePtr> itzAlexBadges::getBadge3(const UserId &id)
-{
-    std::shared_lock lock(this->mutex_);
 
-    auto it = badgeMap3.find(id.string);
-    if (it != badgeMap3.end())
+    // Parses the lists where every badge has a list of users
+    void loadBadgeList(const QUrl &url, BadgeRegistry::Source source)
     {
-        return emotes3[it->second];
+        NetworkRequest(url)
+            .concurrent()
+            .onSuccess([source](auto result) -> Outcome {
+                auto jsonRoot = result.parseJson();
+
+                std::vector<BadgeRegistry::Assignment> assignments;
+                for (const auto &jsonBadge_ :
+                     jsonRoot.value("badges").toArray())
+                {
+                    auto jsonBadge = jsonBadge_.toObject();
+                    auto emote = parseBadgeEmote(jsonBadge);
+
+                    for (const auto &user : jsonBadge.value("users").toArray())
+                    {
+                        addAssignment(assignments, user.toString(), emote);
+                    }
+                }
+
+                BadgeRegistry::instance().setBadges(source,
+                                                    std::move(assignments));
+                return Success;
+            })
+            .execute();
     }
-    return boost::none;
-}
+
+}  // namespace
 
 void itzAlexBadges::loaditzAlexBadges()
 {
-    badgeMap.clear();
-    badgeMap2.clear();
-    badgeMap3.clear();
-    emotes.clear();
-    emotes2.clear();
-    emotes3.clear();
-
     static QUrl url("https://chatterinohomies.com/api/badges/list");
 
+    // Every badge of this list belongs to a single user
     NetworkRequest(url)
         .concurrent()
-        .onSuccess([this](auto result) -> Outcome {
+        .onSuccess([](auto result) -> Outcome {
             auto jsonRoot = result.parseJson();
 
-            std::unique_lock lock(this->mutex_);
-
-            int index = 0;
+            std::vector<BadgeRegistry::Assignment> assignments;
             for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
             {
                 auto jsonBadge = jsonBadge_.toObject();
-                auto emote = Emote{
-                    EmoteName{},
-                    ImageSet{Url{jsonBadge.value("image1").toString()},
-                             Url{jsonBadge.value("image2").toString()},
-                             Url{jsonBadge.value("image3").toString()}},
-                    Tooltip{jsonBadge.value("tooltip").toString()}, Url{}};
-
-                emotes.push_back(
-                    std::make_shared<const Emote>(std::move(emote)));
-
-                badgeMap[jsonBadge.value("userId").toString()] = index;
-                ++index;
+                addAssignment(assignments,
+                              jsonBadge.value("userId").toString(),
+                              parseBadgeEmote(jsonBadge));
             }
+
+            BadgeRegistry::instance().setBadges(
+                BadgeRegistry::Source::itzAlex, std::move(assignments));
             return Success;
         })
         .execute();
 
     static QUrl url2("https://itzalex.github.io/badges");
-
-    NetworkRequest(url2)
-        .concurrent()
-        .onSuccess([this](auto result) -> Outcome {
-            auto jsonRoot = result.parseJson();
-
-            std::unique_lock lock(this->mutex_);
-
-            int index = 0;
-            for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
-            {
-                auto jsonBadge = jsonBadge_.toObject();
-                auto emote = Emote{
-                    EmoteName{},
-                    ImageSet{Url{jsonBadge.value("image1").toString()},
-                             Url{jsonBadge.value("image2").toString()},
-                             Url{jsonBadge.value("image3").toString()}},
-                    Tooltip{jsonBadge.value("tooltip").toString()}, Url{}};
-
-                emotes2.push_back(
-                    std::make_shared<const Emote>(std::move(emote)));
-
-                for (const auto &user : jsonBadge.value("users").toArray())
-                {
-                    badgeMap2[user.toString()] = index;
-                }
-                ++index;
-            }
-            return Success;
-        })
-        .execute();
+    loadBadgeList(url2, BadgeRegistry::Source::itzAlex2);
 
     static QUrl url3("https://itzalex.github.io/badges2");
-
-    NetworkRequest(url3)
-        .concurrent()
-        .onSuccess([this](auto result) -> Outcome {
-            auto jsonRoot = result.parseJson();
-
-            std::unique_lock lock(this->mutex_);
-
-            int index = 0;
-            for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
-            {
-                auto jsonBadge = jsonBadge_.toObject();
-                auto emote = Emote{
-                    EmoteName{},
-                    ImageSet{Url{jsonBadge.value("image1").toString()},
-                             Url{jsonBadge.value("image2").toString()},
-                             Url{jsonBadge.value("image3").toString()}},
-                    Tooltip{jsonBadge.value("tooltip").toString()}, Url{}};
-
-                emotes3.push_back(
-                    std::make_shared<const Emote>(std::move(emote)));
-
-                for (const auto &user : jsonBadge.value("users").toArray())
-                {
-                    badgeMap3[user.toString()] = index;
-                }
-                ++index;
-            }
-            return Success;
-        })
-        .execute();
+    loadBadgeList(url3, BadgeRegistry::Source::itzAlex3);
 }
 }  // namespace chatterino
@@ -1,39 +1,17 @@
 #pragma once
 
-#include <boost/optional.hpp>
+#include <QJsonObject>
 #include <common/Singleton.hpp>
-#include <memory>
-#include <shared_mutex>
-#include <unordered_map>
-#include <vector>
-#include "common/Aliases.hpp"
-#include "util/QStringHash.hpp"
 
 namespace chatterino {
 
-struct Emote;
-using EmotePtr = std::shared_ptr<const Emote>;
-
+// Loads the Homies badges into the BadgeRegistry
 class itzAlexBadges : public Singleton
 {
 public:
     virtual void initialize(Settings &settings, Paths &paths) override;
     itzAlexBadges();
     void loaditzAlexBadges();
-
-    boost::optional<EmotePtr> getBadge(const UserId &id);
-    boost::optional<EmotePtr> getBadge2(const UserId &id);
-    boost::optional<EmotePtr> getBadge3(const UserId &id);
-
-private:
-    std::shared_mutex mutex_;
-
-    std::unordered_map<QString, int> badgeMap;
-    std::unordered_map<QString, int> badgeMap2;
-    std::unordered_map<QString, int> badgeMap3;
-    std::vector<EmotePtr> emotes;
-    std::vector<EmotePtr> emotes2;
-    std::vector<EmotePtr> emotes3;
 };
 
 }  // namespace chatterino
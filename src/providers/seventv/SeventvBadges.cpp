@@ -2,7 +2,9 @@
 
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
+#include "providers/BadgeRegistry.hpp"
 
 #include <QJsonArray>
 #include <QJsonObject>
@@ -11,8 +13,6 @@
 #include <QUrl>
 #include <QUrlQuery>
 
-#include <map>
-
 namespace chatterino {
 void SeventvBadges::initialize(Settings &settings, Paths &paths)
 {
@@ -23,20 +23,14 @@ SeventvBadges::SeventvBadges()
 {
 }
 
-boost::optional<EmotePtr> SeventvBadges::getBadge(const UserId &id)
-{
-    auto it = badgeMap.find(id.string);
-    if (it != badgeMap.end())
-    {
-        return emotes[it->second];
-    }
-    return boost::none;
-}
-
 void SeventvBadges::loadSeventvBadges()
 {
-    badgeMap.clear();
-    emotes.clear();
+    // Show the badges from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    SnapshotStore::load("seventv-badges", fresh,
+                        [this](const QJsonValue &snapshot) {
+                            this->parseBadges(snapshot.toObject());
+                        });
 
     static QUrl url("https://api.7tv.app/v2/badges");
 
@@ -47,29 +41,14 @@ void SeventvBadges::loadSeventvBadges()
     url.setQuery(urlQuery);
 
     NetworkRequest(url)
-        .onSuccess([this](NetworkResult result) -> Outcome {
+        .priority(NetworkRequestPriority::Background)
+        .onSuccess([this, fresh](NetworkResult result) -> Outcome {
+            *fresh = true;
             auto root = result.parseJson();
-
-            int index = 0;
-            for (const auto &jsonBadge_ : root.value("badges").toArray())
+            this->parseBadges(root);
+            if (!root.value("badges").toArray().isEmpty())
             {
-                auto badge = jsonBadge_.toObject();
-                auto urls = badge.value("urls").toArray();
-                auto emote =
-                    Emote{EmoteName{},
-                          ImageSet{Url{urls.at(0).toArray().at(1).toString()},
-                                   Url{urls.at(1).toArray().at(1).toString()},
-                                   Url{urls.at(2).toArray().at(1).toString()}},
-                          Tooltip{badge.value("tooltip").toString()}, Url{}};
-
-                emotes.push_back(
-                    std::make_shared<const Emote>(std::move(emote)));
-
-                for (const auto &user : badge.value("users").toArray())
-                {
-                    badgeMap[user.toString()] = index;
-                }
-                ++index;
+                SnapshotStore::save("seventv-badges", root);
             }
 
             return Success;
@@ -77,4 +56,33 @@ void SeventvBadges::loadSeventvBadges()
         .execute();
 }
 
+void SeventvBadges::parseBadges(const QJsonObject &root)
+{
+    std::vector<BadgeRegistry::Assignment> assignments;
+
+    for (const auto &jsonBadge_ : root.value("badges").toArray())
+    {
+        auto badge = jsonBadge_.toObject();
+        auto urls = badge.value("urls").toArray();
+        auto emote = std::make_shared<const Emote>(
+            Emote{EmoteName{},
+                  ImageSet{Url{urls.at(0).toArray().at(1).toString()},
+                           Url{urls.at(1).toArray().at(1).toString()},
+                           Url{urls.at(2).toArray().at(1).toString()}},
+                  Tooltip{badge.value("tooltip").toString()}, Url{}});
+
+        for (const auto &user : badge.value("users").toArray())
+        {
+            if (auto id = BadgeRegistry::parseUserId(user.toString()))
+            {
+                assignments.push_back(
+                    {*id, {emote, MessageElementFlag::BadgeSeventv, {}}});
+            }
+        }
+    }
+
+    BadgeRegistry::instance().setBadges(BadgeRegistry::Source::Seventv,
+                                        std::move(assignments));
+}
+
 }  // namespace chatterino
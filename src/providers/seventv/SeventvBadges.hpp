@@ -1,18 +1,11 @@
 #pragma once
 
-#include "common/Aliases.hpp"
-
-#include <boost/optional.hpp>
+#include <QJsonObject>
 #include <common/Singleton.hpp>
 
-#include <map>
-#include <memory>
-
 namespace chatterino {
 
-struct Emote;
-using EmotePtr = std::shared_ptr<const Emote>;
-
+// Loads the 7TV badges into the BadgeRegistry
 class SeventvBadges : public Singleton
 {
 public:
@@ -20,11 +13,8 @@ public:
     SeventvBadges();
     void loadSeventvBadges();
 
-    boost::optional<EmotePtr> getBadge(const UserId &id);
-
 private:
-    std::map<QString, int> badgeMap;
-    std::vector<EmotePtr> emotes;
+    void parseBadges(const QJsonObject &root);
 };
 
 }  // namespace chatterino
@@ -3,6 +3,7 @@
 #include "common/Common.hpp"
 #include "common/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
+#include "common/SnapshotStore.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
@@ -13,12 +14,17 @@
 #include <QJsonDocument>
 #include <QThread>
 
+#include <algorithm>
+
 namespace chatterino {
 namespace {
     const QRegularExpression whitespaceRegex(R"(\s+)");
 
     const QString CHANNEL_HAS_NO_EMOTES(
         "This channel has no 7TV channel emotes.");
+
+    const QString GLOBAL_SNAPSHOT("seventv-global");
+    const QString CHANNEL_SNAPSHOT_PREFIX("seventv-channel-");
     const QString emoteLinkFormat("https://7tv.app/emotes/%1");
 
     // maximum pageSize that 7tv's API accepts
@@ -34,10 +40,9 @@ namespace {
 
     EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
     {
-        static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-        static std::mutex mutex;
+        static WeakEmoteIdRegistry registry("7tv emote registry");
 
-        return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+        return cachedOrMakeEmotePtr(std::move(emote), registry, id);
     }
 
     struct CreateEmoteResult {
@@ -283,11 +288,29 @@ void SeventvEmotes::loadEmotes()
     payload.insert("query", query.replace(whitespaceRegex, " "));
     payload.insert("variables", variables);
 
+    auto apply = [this](const QJsonArray &parsedEmotes) -> Outcome {
+        auto pair = parseGlobalEmotes(parsedEmotes, *this->global_.get());
+        if (pair.first)
+            this->global_.set(
+                std::make_shared<EmoteMap>(std::move(pair.second)));
+        return pair.first;
+    };
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (this->global_.get()->empty())
+    {
+        SnapshotStore::load(GLOBAL_SNAPSHOT, fresh,
+                            [apply](const QJsonValue &snapshot) {
+                                apply(snapshot.toArray());
+                            });
+    }
+
     NetworkRequest(apiUrlGQL, NetworkRequestType::Post)
         .timeout(30000)
         .header("Content-Type", "application/json")
         .payload(QJsonDocument(payload).toJson(QJsonDocument::Compact))
-        .onSuccess([this](NetworkResult result) -> Outcome {
+        .onSuccess([apply, fresh](NetworkResult result) -> Outcome {
             QJsonArray parsedEmotes = result.parseJson()
                                           .value("data")
                                           .toObject()
@@ -296,11 +319,13 @@ void SeventvEmotes::loadEmotes()
             qCDebug(chatterinoSeventv)
                 << "7TV Global Emotes" << parsedEmotes.size();
 
-            auto pair = parseGlobalEmotes(parsedEmotes, *this->global_.get());
-            if (pair.first)
-                this->global_.set(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
-            return pair.first;
+            auto outcome = apply(parsedEmotes);
+            if (outcome == Success)
+            {
+                *fresh = true;
+                SnapshotStore::save(GLOBAL_SNAPSHOT, parsedEmotes);
+            }
+            return outcome;
         })
         .execute();
 }
@@ -342,12 +367,38 @@ void SeventvEmotes::loadChannel(std::weak_ptr<Channel> channel,
 
     // qDebug() << QJsonDocument(payload).toJson(QJsonDocument::Compact);
 
+    auto shared = channel.lock();
+    if (!shared)
+    {
+        return;
+    }
+
+    auto snapshotName = SnapshotStore::channelSnapshot(
+        shared->getName(), CHANNEL_SNAPSHOT_PREFIX + channelId);
+
+    // Show the emotes from last time until the request is done
+    auto fresh = SnapshotStore::makeFresh();
+    if (!manualRefresh)
+    {
+        SnapshotStore::load(
+            snapshotName, fresh,
+            [callback, channelId](const QJsonValue &snapshot) {
+                auto emoteMap =
+                    parseChannelEmotes(snapshot.toObject(), channelId);
+                if (!emoteMap.empty())
+                {
+                    callback(std::move(emoteMap));
+                }
+            });
+    }
+
     NetworkRequest(apiUrlGQL, NetworkRequestType::Post)
         .timeout(20000)
         .header("Content-Type", "application/json")
         .payload(QJsonDocument(payload).toJson(QJsonDocument::Compact))
         .onSuccess([callback = std::move(callback), channel, channelId,
-                    manualRefresh](NetworkResult result) -> Outcome {
+                    manualRefresh, snapshotName,
+                    fresh](NetworkResult result) -> Outcome {
             QJsonObject parsedEmotes = result.parseJson()
                                            .value("data")
                                            .toObject()
@@ -356,6 +407,12 @@ void SeventvEmotes::loadChannel(std::weak_ptr<Channel> channel,
 
             auto emoteMap = parseChannelEmotes(parsedEmotes, channelId);
             bool hasEmotes = !emoteMap.empty();
+            // A broken response shouldn't replace the last good one
+            if (hasEmotes)
+            {
+                *fresh = true;
+                SnapshotStore::save(snapshotName, parsedEmotes);
+            }
 
             qCDebug(chatterinoSeventv)
                 << "Loaded 7TV Channel Emotes" << channelId << emoteMap.size()
@@ -415,4 +472,49 @@ void SeventvEmotes::loadChannel(std::weak_ptr<Channel> channel,
         .execute();
 }
 
+boost::optional<EmoteMap> SeventvEmotes::applyEmoteEvent(
+    const EmoteMap &emotes, const SeventvEmoteEvent &event)
+{
+    // Emotes are stored by name, but a rename only tells us the new one
+    auto homePage = emoteLinkFormat.arg(event.emoteId);
+    auto existing = std::find_if(emotes.begin(), emotes.end(),
+                                 [&homePage](const auto &pair) {
+                                     return pair.second->homePage.string ==
+                                            homePage;
+                                 });
+
+    if (event.action == SeventvEmoteEvent::Action::Remove)
+    {
+        if (existing == emotes.end())
+        {
+            return boost::none;
+        }
+
+        auto updated = emotes;
+        updated.erase(existing->first);
+        return updated;
+    }
+
+    auto jsonEmote = event.emote;
+    jsonEmote.insert("id", event.emoteId);
+    jsonEmote.insert("name", event.name);
+
+    auto emote = createEmote(jsonEmote, false);
+    auto emotePtr = cachedOrMake(std::move(emote.emote), emote.id);
+
+    if (existing != emotes.end() && existing->second == emotePtr)
+    {
+        return boost::none;
+    }
+
+    auto updated = emotes;
+    if (existing != emotes.end())
+    {
+        updated.erase(existing->first);
+    }
+    updated[emote.name] = emotePtr;
+
+    return updated;
+}
+
 }  // namespace chatterino
@@ -5,6 +5,9 @@
 #include "common/Atomic.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 
+#include <QJsonObject>
+#include <QString>
+
 #include <memory>
 
 namespace chatterino {
@@ -31,6 +34,27 @@ struct Emote;
 using EmotePtr = std::shared_ptr<const Emote>;
 class EmoteMap;
 
+// A change to a channel's emote set, sent by the 7TV event API
+struct SeventvEmoteEvent {
+    enum class Action {
+        Add,
+        Remove,
+        // The emote was renamed
+        Update,
+    };
+
+    Action action;
+    // Login name of the channel
+    QString channel;
+    QString emoteId;
+    // The (new) name of the emote
+    QString name;
+    // Display name of the user that changed the emote set
+    QString actor;
+    // The emote data, only sent with Add and Update
+    QJsonObject emote;
+};
+
 class SeventvEmotes final
 {
     static constexpr const char *apiUrlGQL = "https://api.7tv.app/v2/gql";
@@ -47,6 +71,11 @@ public:
                             std::function<void(EmoteMap &&)> callback,
                             bool manualRefresh);
 
+    // Returns a copy of `emotes` with `event` applied, or boost::none if the
+    // event doesn't change them
+    static boost::optional<EmoteMap> applyEmoteEvent(
+        const EmoteMap &emotes, const SeventvEmoteEvent &event);
+
 private:
     Atomic<std::shared_ptr<const EmoteMap>> global_;
 };
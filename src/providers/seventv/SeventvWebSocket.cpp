@@ -1,5 +1,388 @@
-#include "SeventvWebSocket.hpp"
+#include "providers/seventv/SeventvWebSocket.hpp"
 
-SeventvWebSocket::SeventvWebSocket()
+#include "common/QLogging.hpp"
+#include "providers/twitch/PubsubHelpers.hpp"
+#include "util/Metrics.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QJsonDocument>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+
+#include <functional>
+#include <type_traits>
+
+namespace chatterino {
+namespace {
+
+    // Same as chatterinoconfig, but without TLS
+    struct SeventvPlainConfig : public websocketpp::config::asio_client {
+        typedef websocketpp::log::chatterinowebsocketpplogger<
+            concurrency_type, websocketpp::log::elevel>
+            elog_type;
+        typedef websocketpp::log::chatterinowebsocketpplogger<
+            concurrency_type, websocketpp::log::alevel>
+            alog_type;
+
+        struct permessage_deflate_config {
+        };
+
+        typedef websocketpp::extensions::permessage_deflate::disabled<
+            permessage_deflate_config>
+            permessage_deflate_type;
+    };
+
+    websocketpp::lib::shared_ptr<boost::asio::ssl::context> makeTLSContext()
+    {
+        websocketpp::lib::shared_ptr<boost::asio::ssl::context> ctx(
+            new boost::asio::ssl::context(boost::asio::ssl::context::tlsv12));
+
+        try
+        {
+            ctx->set_options(boost::asio::ssl::context::default_workarounds |
+                             boost::asio::ssl::context::no_sslv2 |
+                             boost::asio::ssl::context::single_dh_use);
+        }
+        catch (const std::exception &e)
+        {
+            qCDebug(chatterinoSeventv)
+                << "Exception caught in OnTLSInit:" << e.what();
+        }
+
+        return ctx;
+    }
+
+}  // namespace
+
+class SeventvWebSocket::Transport
+{
+public:
+    virtual ~Transport() = default;
+
+    virtual void connect(const std::string &url) = 0;
+    virtual WebsocketErrorCode send(WebsocketHandle hdl,
+                                    const std::string &payload) = 0;
+    virtual void runAfter(std::chrono::milliseconds delay,
+                          std::function<void()> callback) = 0;
+
+    // Runs the client until stop() is called
+    virtual void run() = 0;
+    virtual void stop() = 0;
+};
+
+template <typename Config>
+class SeventvWebSocket::BasicTransport : public SeventvWebSocket::Transport
+{
+public:
+    explicit BasicTransport(SeventvWebSocket &owner)
+    {
+        this->client_.set_access_channels(websocketpp::log::alevel::all);
+        this->client_.clear_access_channels(
+            websocketpp::log::alevel::frame_payload |
+            websocketpp::log::alevel::frame_header);
+
+        this->client_.init_asio();
+
+        if constexpr (!std::is_same_v<Config, SeventvPlainConfig>)
+        {
+            // SSL Handshake
+            this->client_.set_tls_init_handler([](auto) {
+                return makeTLSContext();
+            });
+        }
+
+        this->client_.set_message_handler([&owner](auto, auto message) {
+            owner.onMessage(message->get_payload());
+        });
+        this->client_.set_open_handler([&owner](auto hdl) {
+            owner.onConnectionOpen(hdl);
+        });
+        this->client_.set_close_handler([&owner](auto hdl) {
+            owner.onConnectionClose(hdl);
+        });
+        this->client_.set_fail_handler([&owner](auto hdl) {
+            owner.onConnectionFail(hdl);
+        });
+
+        // Keep running while we're waiting to reconnect
+        this->client_.start_perpetual();
+    }
+
+    void connect(const std::string &url) override
+    {
+        WebsocketErrorCode ec;
+        auto con = this->client_.get_connection(url, ec);
+
+        if (ec)
+        {
+            qCDebug(chatterinoSeventv)
+                << "Unable to establish connection:" << ec.message().c_str();
+            return;
+        }
+
+        this->client_.connect(con);
+    }
+
+    WebsocketErrorCode send(WebsocketHandle hdl,
+                            const std::string &payload) override
+    {
+        WebsocketErrorCode ec;
+        this->client_.send(hdl, payload, websocketpp::frame::opcode::text, ec);
+
+        return ec;
+    }
+
+    void runAfter(std::chrono::milliseconds delay,
+                  std::function<void()> callback) override
+    {
+        chatterino::runAfter(this->client_.get_io_service(), delay,
+                             [callback = std::move(callback)](auto) {
+                                 callback();
+                             });
+    }
+
+    void run() override
+    {
+        this->client_.run();
+    }
+
+    void stop() override
+    {
+        this->client_.stop_perpetual();
+        this->client_.stop();
+    }
+
+private:
+    websocketpp::client<Config> client_;
+};
+
+SeventvWebSocket::SeventvWebSocket(const QString &url)
+    : url_(url.toStdString())
+{
+    if (url.startsWith("ws://"))
+    {
+        this->transport_ =
+            std::make_unique<BasicTransport<SeventvPlainConfig>>(*this);
+    }
+    else
+    {
+        this->transport_ =
+            std::make_unique<BasicTransport<chatterinoconfig>>(*this);
+    }
+}
+
+SeventvWebSocket::~SeventvWebSocket()
+{
+    this->stopping_ = true;
+    this->transport_->stop();
+
+    if (this->thread_ && this->thread_->joinable())
+    {
+        this->thread_->join();
+    }
+
+    // The close handler doesn't run for connections that were still open
+    if (this->handle_)
+    {
+        static auto &seventvEventAPIConnections =
+            Metrics::gauge("7TV event API connections");
+        seventvEventAPIConnections.decrease();
+    }
+}
+
+void SeventvWebSocket::start()
+{
+    this->connect();
+
+    this->thread_.reset(new std::thread([this] {
+        qCDebug(chatterinoSeventv) << "Start 7TV event API thread";
+        this->transport_->run();
+        qCDebug(chatterinoSeventv) << "Done with 7TV event API thread";
+    }));
+}
+
+void SeventvWebSocket::joinChannel(const QString &channelName)
 {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    if (++this->channels_[channelName] == 1)
+    {
+        this->send("join", channelName);
+    }
+}
+
+void SeventvWebSocket::partChannel(const QString &channelName)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto it = this->channels_.find(channelName);
+    if (it == this->channels_.end())
+    {
+        return;
+    }
+
+    if (--it->second == 0)
+    {
+        this->channels_.erase(it);
+        this->send("part", channelName);
+    }
 }
+
+boost::optional<SeventvEmoteEvent> SeventvWebSocket::parseEmoteEvent(
+    const QJsonObject &message)
+{
+    if (message.value("action").toString() != "update")
+    {
+        return boost::none;
+    }
+
+    // The event is sent as a string containing JSON
+    auto payloadValue = message.value("payload");
+    auto payload =
+        payloadValue.isString()
+            ? QJsonDocument::fromJson(payloadValue.toString().toUtf8()).object()
+            : payloadValue.toObject();
+
+    SeventvEmoteEvent event;
+
+    auto action = payload.value("action").toString();
+    if (action == "ADD")
+    {
+        event.action = SeventvEmoteEvent::Action::Add;
+    }
+    else if (action == "REMOVE")
+    {
+        event.action = SeventvEmoteEvent::Action::Remove;
+    }
+    else if (action == "UPDATE")
+    {
+        event.action = SeventvEmoteEvent::Action::Update;
+    }
+    else
+    {
+        return boost::none;
+    }
+
+    event.channel = payload.value("channel").toString().toLower();
+    event.emoteId = payload.value("emote_id").toString();
+    event.name = payload.value("name").toString();
+    event.actor = payload.value("actor").toString();
+    event.emote = payload.value("emote").toObject();
+
+    if (event.channel.isEmpty() || event.emoteId.isEmpty() ||
+        (event.action != SeventvEmoteEvent::Action::Remove &&
+         event.name.isEmpty()))
+    {
+        return boost::none;
+    }
+
+    return event;
+}
+
+void SeventvWebSocket::connect()
+{
+    this->transport_->connect(this->url_);
+}
+
+void SeventvWebSocket::reconnect()
+{
+    if (this->stopping_)
+    {
+        return;
+    }
+
+    this->transport_->runAfter(this->backoff_.next(), [this] {
+        this->connect();
+    });
+}
+
+void SeventvWebSocket::send(const QString &action, const QString &channelName)
+{
+    // Channels are (re)joined once we're connected
+    if (!this->handle_)
+    {
+        return;
+    }
+
+    QJsonObject message;
+    message.insert("action", action);
+    message.insert("payload", channelName);
+
+    auto payload = QJsonDocument(message).toJson(QJsonDocument::Compact);
+
+    auto ec = this->transport_->send(*this->handle_, payload.toStdString());
+
+    if (ec)
+    {
+        qCDebug(chatterinoSeventv) << "Error sending message" << payload
+                                   << ":" << ec.message().c_str();
+    }
+}
+
+void SeventvWebSocket::onMessage(const std::string &payload)
+{
+    QJsonParseError error;
+    auto document =
+        QJsonDocument::fromJson(QByteArray::fromStdString(payload), &error);
+
+    if (error.error != QJsonParseError::NoError || !document.isObject())
+    {
+        qCDebug(chatterinoSeventv)
+            << "Error parsing message from 7TV event API:"
+            << error.errorString();
+        return;
+    }
+
+    auto event = parseEmoteEvent(document.object());
+    if (!event)
+    {
+        return;
+    }
+
+    static auto &seventvEmoteEvents = Metrics::counter("7TV emote events");
+    seventvEmoteEvents.increase();
+
+    postToThread([this, event = std::move(*event)] {
+        this->emoteEvent.invoke(event);
+    });
+}
+
+void SeventvWebSocket::onConnectionOpen(WebsocketHandle hdl)
+{
+    static auto &seventvEventAPIConnections =
+        Metrics::gauge("7TV event API connections");
+    seventvEventAPIConnections.increase();
+    this->backoff_.reset();
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    this->handle_ = hdl;
+
+    for (const auto &channel : this->channels_)
+    {
+        this->send("join", channel.first);
+    }
+}
+
+void SeventvWebSocket::onConnectionClose(WebsocketHandle hdl)
+{
+    static auto &seventvEventAPIConnections =
+        Metrics::gauge("7TV event API connections");
+    seventvEventAPIConnections.decrease();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        this->handle_ = boost::none;
+    }
+
+    this->reconnect();
+}
+
+void SeventvWebSocket::onConnectionFail(WebsocketHandle hdl)
+{
+    qCDebug(chatterinoSeventv) << "Failed to connect to the 7TV event API";
+
+    this->reconnect();
+}
+
+}  // namespace chatterino
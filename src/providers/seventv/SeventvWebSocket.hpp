@@ -1,10 +1,82 @@
-#ifndef SEVENTVWEBSOCKET_H
-#define SEVENTVWEBSOCKET_H
+#pragma once
 
+#include "providers/seventv/SeventvEmotes.hpp"
+#include "providers/twitch/PubsubClient.hpp"
+#include "util/ExponentialBackoff.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QJsonObject>
+#include <QString>
+#include <boost/optional.hpp>
+#include <pajlada/signals/signal.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace chatterino {
+
+// Client for the 7TV event API, which pushes changes to the emote sets of the
+// channels we joined. The changes are applied to the channel emotes directly,
+// so they don't have to be reloaded.
+//
+// The url can point at a local server (see Env::seventvEventApiUrl) to test
+// the client, ws:// urls are connected to without TLS.
 class SeventvWebSocket
 {
 public:
-    SeventvWebSocket();
+    SeventvWebSocket(const QString &url);
+    // Closes the connection and waits for the websocket thread to finish
+    ~SeventvWebSocket();
+
+    SeventvWebSocket(const SeventvWebSocket &) = delete;
+    SeventvWebSocket &operator=(const SeventvWebSocket &) = delete;
+
+    void start();
+
+    // Joins are counted, the channel is parted once every join was parted
+    void joinChannel(const QString &channelName);
+    void partChannel(const QString &channelName);
+
+    // Returns boost::none if `message` isn't an emote event
+    static boost::optional<SeventvEmoteEvent> parseEmoteEvent(
+        const QJsonObject &message);
+
+    // Invoked on the GUI thread for the events of every joined channel, see
+    // SeventvEmoteEvent::channel for the channel it belongs to
+    pajlada::Signals::Signal<SeventvEmoteEvent> emoteEvent;
+
+private:
+    // The websocketpp client, with or without TLS depending on the url
+    class Transport;
+    template <typename Config>
+    class BasicTransport;
+
+    void connect();
+    void reconnect();
+    // Must be called with mutex_ held
+    void send(const QString &action, const QString &channelName);
+
+    void onMessage(const std::string &payload);
+    void onConnectionOpen(WebsocketHandle hdl);
+    void onConnectionClose(WebsocketHandle hdl);
+    void onConnectionFail(WebsocketHandle hdl);
+
+    const std::string url_;
+
+    std::unique_ptr<Transport> transport_;
+    std::unique_ptr<std::thread> thread_;
+    ExponentialBackoff<6> backoff_{std::chrono::milliseconds(1000)};
+    // Set once we're shutting down, so closed connections aren't reopened
+    std::atomic<bool> stopping_{false};
+
+    // Guards everything below
+    std::mutex mutex_;
+    boost::optional<WebsocketHandle> handle_;
+    std::unordered_map<QString, int> channels_;
 };
 
-#endif  // SEVENTVWEBSOCKET_H
+}  // namespace chatterino
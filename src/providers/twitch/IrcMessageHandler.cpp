@@ -490,7 +490,9 @@ void IrcMessageHandler::handleClearChatMessage(Communi::IrcMessage *message)
     getApp()->windows->repaintVisibleChatWidgets(chan.get());
     if (getSettings()->hideModerated)
     {
-        getApp()->windows->forceLayoutChannelViews();
+        // Only the messages that just got disabled are laid out again, but
+        // they might be shown in other channels (e.g. /mentions) too
+        getApp()->windows->layoutChannelViews();
     }
 }
 
@@ -3,12 +3,13 @@
 #include "providers/twitch/PubsubActions.hpp"
 #include "providers/twitch/PubsubHelpers.hpp"
 #include "singletons/Settings.hpp"
-#include "util/DebugCount.hpp"
 #include "util/Helpers.hpp"
+#include "util/Metrics.hpp"
 #include "util/RapidjsonHelpers.hpp"
 
 #include <rapidjson/error/en.h>
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <thread>
@@ -62,26 +63,59 @@ namespace detail {
             return false;
         }
         this->numListens_ += numRequestedListens;
-        DebugCount::increase("PubSub topic pending listens",
-                             numRequestedListens);
+        static auto &pubSubTopicPendingListens =
+            Metrics::gauge("PubSub topic pending listens");
+        pubSubTopicPendingListens.increase(numRequestedListens);
 
+        QString authToken;
+        rj::getSafe(message["data"], "auth_token", authToken);
+
+        std::vector<QString> topics;
         for (const auto &topic : message["data"]["topics"].GetArray())
         {
             this->listeners_.emplace_back(
-                Listener{topic.GetString(), false, false, false});
+                Listener{topic.GetString(), false, false, false, authToken});
+            topics.emplace_back(topic.GetString());
         }
 
         auto nonce = generateUuid();
         rj::set(message, "nonce", nonce);
 
         QString payload = rj::stringify(message);
-        sentListens[nonce] = RequestMessage{payload, numRequestedListens};
+        sentListens[nonce] = RequestMessage{payload, numRequestedListens,
+                                            std::move(topics), authToken};
 
         this->send(payload.toUtf8());
 
         return true;
     }
 
+    boost::optional<size_t> pickConnection(const std::vector<int> &numListens,
+                                           int numTopics)
+    {
+        boost::optional<size_t> used;
+        boost::optional<size_t> idle;
+
+        for (size_t i = 0; i < numListens.size(); i++)
+        {
+            if (numListens[i] + numTopics > MAX_PUBSUB_LISTENS)
+            {
+                continue;
+            }
+
+            if (numListens[i] == 0)
+            {
+                idle = i;
+            }
+            else if (!used || numListens[i] < numListens[*used])
+            {
+                used = i;
+            }
+        }
+
+        return used ? used : idle;
+    }
+
     void PubSubClient::unlistenPrefix(const QString &prefix)
     {
         std::vector<QString> topics;
@@ -108,8 +142,9 @@ namespace detail {
         int numRequestedUnlistens = topics.size();
 
         this->numListens_ -= numRequestedUnlistens;
-        DebugCount::increase("PubSub topic pending unlistens",
-                             numRequestedUnlistens);
+        static auto &pubSubTopicPendingUnlistens =
+            Metrics::gauge("PubSub topic pending unlistens");
+        pubSubTopicPendingUnlistens.increase(numRequestedUnlistens);
 
         auto message = createUnlistenMessage(topics);
 
@@ -122,11 +157,46 @@ namespace detail {
         this->send(payload.toUtf8());
     }
 
+    void PubSubClient::removeListeners(const std::vector<QString> &topics)
+    {
+        for (const auto &topic : topics)
+        {
+            auto it = std::find_if(this->listeners_.begin(),
+                                   this->listeners_.end(),
+                                   [&topic](const auto &listener) {
+                                       return listener.topic == topic;
+                                   });
+
+            if (it != this->listeners_.end())
+            {
+                this->listeners_.erase(it);
+                this->numListens_--;
+            }
+        }
+    }
+
+    void PubSubClient::confirmListeners(const std::vector<QString> &topics)
+    {
+        for (auto &listener : this->listeners_)
+        {
+            if (std::find(topics.begin(), topics.end(), listener.topic) !=
+                topics.end())
+            {
+                listener.confirmed = true;
+            }
+        }
+    }
+
     void PubSubClient::handlePong()
     {
         assert(this->awaitingPong_);
 
         this->awaitingPong_ = false;
+
+        this->latency_ =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - this->pingSentAt_)
+                .count();
     }
 
     bool PubSubClient::isListeningToTopic(const QString &topic)
@@ -142,10 +212,34 @@ namespace detail {
         return false;
     }
 
+    const std::vector<Listener> &PubSubClient::getListeners() const
+    {
+        return this->listeners_;
+    }
+
+    int PubSubClient::getNumListens() const
+    {
+        return this->numListens_;
+    }
+
+    boost::optional<std::chrono::milliseconds> PubSubClient::getLatency()
+        const
+    {
+        auto latency = this->latency_.load();
+        if (latency < 0)
+        {
+            return boost::none;
+        }
+
+        return std::chrono::milliseconds(latency);
+    }
+
     void PubSubClient::ping()
     {
         assert(this->started_);
 
+        this->pingSentAt_ = std::chrono::steady_clock::now();
+
         if (!this->send(pingPayload))
         {
             return;
@@ -166,7 +260,13 @@ namespace detail {
                      {
                          qCDebug(chatterinoPubsub)
                              << "No pong response, disconnect!";
-                         // TODO(pajlada): Label this connection as "disconnect me"
+
+                         // Its topics are moved to another connection once
+                         // it's closed
+                         WebsocketErrorCode ec;
+                         self->websocketClient_.close(
+                             self->handle_, websocketpp::close::status::normal,
+                             "No pong response", ec);
                      }
                  });
 
@@ -865,14 +965,47 @@ PubSub::PubSub()
         bind(&PubSub::onConnectionOpen, this, ::_1));
     this->websocketClient.set_close_handler(
         bind(&PubSub::onConnectionClose, this, ::_1));
+    this->websocketClient.set_fail_handler(
+        bind(&PubSub::onConnectionFail, this, ::_1));
 
     // Add an initial client
     this->addClient();
 }
 
+std::shared_ptr<detail::PubSubClient> PubSub::pickClient(int numTopics) const
+{
+    std::vector<std::shared_ptr<detail::PubSubClient>> clients;
+    std::vector<int> numListens;
+    for (const auto &p : this->clients)
+    {
+        clients.push_back(p.second);
+        numListens.push_back(p.second->getNumListens());
+    }
+
+    if (auto index = detail::pickConnection(numListens, numTopics))
+    {
+        return clients[*index];
+    }
+
+    return nullptr;
+}
+
+void PubSub::ensureStandbyClients()
+{
+    auto idleClients = std::count_if(
+        this->clients.begin(), this->clients.end(), [](const auto &p) {
+            return p.second->getNumListens() == 0;
+        });
+
+    if (idleClients < PUBSUB_STANDBY_CONNECTIONS)
+    {
+        this->addClient();
+    }
+}
+
 void PubSub::addClient()
 {
-    if (this->addingClient)
+    if (this->addingClient || this->clients.size() >= MAX_PUBSUB_CONNECTIONS)
     {
         return;
     }
@@ -886,6 +1019,7 @@ void PubSub::addClient()
     {
         qCDebug(chatterinoPubsub)
             << "Unable to establish connection:" << ec.message().c_str();
+        this->addingClient = false;
         return;
     }
 
@@ -902,6 +1036,8 @@ void PubSub::listenToWhispers(std::shared_ptr<TwitchAccount> account)
 {
     static const QString topicFormat("whispers.%1");
 
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     assert(account != nullptr);
 
     auto userID = account->getUserId();
@@ -924,6 +1060,8 @@ void PubSub::listenToWhispers(std::shared_ptr<TwitchAccount> account)
 
 void PubSub::unlistenAllModerationActions()
 {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     for (const auto &p : this->clients)
     {
         const auto &client = p.second;
@@ -935,6 +1073,9 @@ void PubSub::listenToChannelModerationActions(
     const QString &channelID, std::shared_ptr<TwitchAccount> account)
 {
     static const QString topicFormat("chat_moderator_actions.%1.%2");
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     assert(!channelID.isEmpty());
     assert(account != nullptr);
     QString userID = account->getUserId();
@@ -957,6 +1098,9 @@ void PubSub::listenToAutomod(const QString &channelID,
                              std::shared_ptr<TwitchAccount> account)
 {
     static const QString topicFormat("automod-queue.%1.%2");
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     assert(!channelID.isEmpty());
     assert(account != nullptr);
     QString userID = account->getUserId();
@@ -979,6 +1123,9 @@ void PubSub::listenToChannelPointRewards(const QString &channelID,
                                          std::shared_ptr<TwitchAccount> account)
 {
     static const QString topicFormat("community-points-channel-v1.%1");
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     assert(!channelID.isEmpty());
     assert(account != nullptr);
 
@@ -1013,21 +1160,21 @@ void PubSub::listen(rapidjson::Document &&msg)
     this->requests.emplace_back(
         std::make_unique<rapidjson::Document>(std::move(msg)));
 
-    DebugCount::increase("PubSub topic backlog");
+    static auto &pubSubTopicBacklog = Metrics::gauge("PubSub topic backlog");
+    pubSubTopicBacklog.increase();
 }
 
 bool PubSub::tryListen(rapidjson::Document &msg)
 {
-    for (const auto &p : this->clients)
+    auto client = this->pickClient(msg["data"]["topics"].Size());
+    if (!client || !client->listen(msg))
     {
-        const auto &client = p.second;
-        if (client->listen(msg))
-        {
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    this->ensureStandbyClients();
+
+    return true;
 }
 
 bool PubSub::isListeningToTopic(const QString &topic)
@@ -1047,39 +1194,43 @@ bool PubSub::isListeningToTopic(const QString &topic)
 void PubSub::onMessage(websocketpp::connection_hdl hdl,
                        WebsocketMessagePtr websocketMessage)
 {
-    const auto &payload =
-        QString::fromStdString(websocketMessage->get_payload());
+    // Parse the frame in place, its strings point into the websocket buffer
+    // which stays alive until we're done with the message. get_payload() is
+    // const, the raw payload is the same buffer but mutable.
+    auto &payload = websocketMessage->get_raw_payload();
 
-    rapidjson::Document msg;
+    InsituDocument document;
+    auto &msg = document.get();
 
-    rapidjson::ParseResult res = msg.Parse(payload.toUtf8());
+    rapidjson::ParseResult res = document.parse(payload.data());
 
     if (!res)
     {
         qCDebug(chatterinoPubsub)
-            << QString("Error parsing message '%1' from PubSub: %2")
-                   .arg(payload, rapidjson::GetParseError_En(res.Code()));
+            << QString("Error parsing message from PubSub at offset %1: %2")
+                   .arg(res.Offset())
+                   .arg(rapidjson::GetParseError_En(res.Code()));
         return;
     }
 
     if (!msg.IsObject())
     {
-        qCDebug(chatterinoPubsub)
-            << QString("Error parsing message '%1' from PubSub. Root object is "
-                       "not an object")
-                   .arg(payload);
+        qCDebug(chatterinoPubsub) << "Error parsing message from PubSub. Root "
+                                     "object is not an object";
         return;
     }
 
-    QString type;
+    auto typeIt = msg.FindMember("type");
 
-    if (!rj::getSafe(msg, "type", type))
+    if (typeIt == msg.MemberEnd() || !typeIt->value.IsString())
     {
         qCDebug(chatterinoPubsub)
             << "Missing required string member `type` in message root";
         return;
     }
 
+    const auto &type = typeIt->value;
+
     if (type == "RESPONSE")
     {
         this->handleResponse(msg);
@@ -1105,6 +1256,8 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
     }
     else if (type == "PONG")
     {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
         auto clientIt = this->clients.find(hdl);
 
         // If this assert goes off, there's something wrong with the connection
@@ -1117,64 +1270,162 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
     }
     else
     {
-        qCDebug(chatterinoPubsub) << "Unknown message type:" << type;
+        qCDebug(chatterinoPubsub)
+            << "Unknown message type:" << type.GetString();
     }
 }
 
 void PubSub::onConnectionOpen(WebsocketHandle hdl)
 {
-    DebugCount::increase("PubSub connections");
-    this->addingClient = false;
+    static auto &pubSubConnections = Metrics::gauge("PubSub connections");
+    pubSubConnections.increase();
 
-    auto client =
-        std::make_shared<detail::PubSubClient>(this->websocketClient, hdl);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
 
-    // We separate the starting from the constructor because we will want to use
-    // shared_from_this
-    client->start();
+        this->addingClient = false;
+        this->connectBackoff.reset();
 
-    this->clients.emplace(hdl, client);
+        auto client =
+            std::make_shared<detail::PubSubClient>(this->websocketClient, hdl);
 
-    this->connected.invoke();
+        // We separate the starting from the constructor because we will want
+        // to use shared_from_this
+        client->start();
 
-    for (auto it = this->requests.begin(); it != this->requests.end();)
-    {
-        const auto &request = *it;
-        if (client->listen(*request))
+        this->clients.emplace(hdl, client);
+
+        for (auto it = this->requests.begin(); it != this->requests.end();)
         {
-            DebugCount::decrease("PubSub topic backlog");
-            it = this->requests.erase(it);
+            const auto &request = *it;
+            if (client->listen(*request))
+            {
+                static auto &pubSubTopicBacklog =
+                    Metrics::gauge("PubSub topic backlog");
+                pubSubTopicBacklog.decrease();
+                it = this->requests.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (!this->requests.empty())
+        {
+            this->addClient();
         }
         else
         {
-            ++it;
+            this->ensureStandbyClients();
         }
     }
 
-    if (!this->requests.empty())
-    {
-        this->addClient();
-    }
+    this->connected.invoke();
 }
 
 void PubSub::onConnectionClose(WebsocketHandle hdl)
 {
-    DebugCount::decrease("PubSub connections");
-    auto clientIt = this->clients.find(hdl);
+    static auto &pubSubConnections = Metrics::gauge("PubSub connections");
+    pubSubConnections.decrease();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        auto clientIt = this->clients.find(hdl);
+
+        // If this assert goes off, there's something wrong with the connection
+        // creation/preserving code KKona
+        assert(clientIt != this->clients.end());
+
+        auto client = clientIt->second;
+
+        client->stop();
+
+        this->clients.erase(clientIt);
 
-    // If this assert goes off, there's something wrong with the connection
-    // creation/preserving code KKona
-    assert(clientIt != this->clients.end());
+        // Listen to the topics of the dropped connection again. Topics are
+        // batched into as few LISTEN requests as possible, which usually go to
+        // a standby connection.
+        static auto &pubSubTopicListening =
+            Metrics::gauge("PubSub topic listening");
+        static auto &pubSubTopicPendingListens =
+            Metrics::gauge("PubSub topic pending listens");
 
-    auto &client = clientIt->second;
+        std::set<QString> droppedTopics;
+        std::map<QString, std::vector<QString>> topicsByToken;
+        for (const auto &listener : client->getListeners())
+        {
+            droppedTopics.insert(listener.topic);
+            if (listener.confirmed)
+            {
+                pubSubTopicListening.decrease();
+            }
+            else
+            {
+                pubSubTopicPendingListens.decrease();
+            }
+            topicsByToken[listener.authToken].push_back(listener.topic);
+        }
+
+        // Responses to the listens sent on the dropped connection never
+        // arrive, the topics get new ones below
+        for (auto it = sentListens.begin(); it != sentListens.end();)
+        {
+            const auto &topics = it->second.topics;
+            bool dropped = std::any_of(topics.begin(), topics.end(),
+                                       [&](const QString &topic) {
+                                           return droppedTopics.count(topic);
+                                       });
+            if (dropped)
+            {
+                it = sentListens.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
 
-    client->stop();
+        for (const auto &[authToken, topics] : topicsByToken)
+        {
+            for (size_t i = 0; i < topics.size(); i += MAX_PUBSUB_LISTENS)
+            {
+                auto end = std::min(topics.size(), i + MAX_PUBSUB_LISTENS);
+                this->listen(createListenMessage(
+                    std::vector<QString>(topics.begin() + i,
+                                         topics.begin() + end),
+                    authToken));
+            }
+        }
 
-    this->clients.erase(clientIt);
+        this->ensureStandbyClients();
+    }
 
     this->connected.invoke();
 }
 
+void PubSub::onConnectionFail(WebsocketHandle hdl)
+{
+    qCDebug(chatterinoPubsub) << "Failed to open a PubSub connection";
+
+    this->addingClient = false;
+
+    runAfter(this->websocketClient.get_io_service(),
+             this->connectBackoff.next(), [this](auto timer) {
+                 std::lock_guard<std::mutex> lock(this->mutex);
+
+                 if (!this->requests.empty())
+                 {
+                     this->addClient();
+                 }
+                 else
+                 {
+                     this->ensureStandbyClients();
+                 }
+             });
+}
+
 PubSub::WebsocketContextPtr PubSub::onTLSInit(websocketpp::connection_hdl hdl)
 {
     WebsocketContextPtr ctx(
@@ -1195,8 +1446,10 @@ PubSub::WebsocketContextPtr PubSub::onTLSInit(websocketpp::connection_hdl hdl)
     return ctx;
 }
 
-void PubSub::handleResponse(const rapidjson::Document &msg)
+void PubSub::handleResponse(const rapidjson::Value &msg)
 {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     QString error;
 
     if (!rj::getSafe(msg, "error", error))
@@ -1215,13 +1468,17 @@ void PubSub::handleResponse(const rapidjson::Document &msg)
 
     if (auto it = sentListens.find(nonce); it != sentListens.end())
     {
-        this->handleListenResponse(it->second, failed);
+        auto request = std::move(it->second);
+        sentListens.erase(it);
+        this->handleListenResponse(request, error);
         return;
     }
 
     if (auto it = sentUnlistens.find(nonce); it != sentUnlistens.end())
     {
-        this->handleUnlistenResponse(it->second, failed);
+        auto request = std::move(it->second);
+        sentUnlistens.erase(it);
+        this->handleUnlistenResponse(request, failed);
         return;
     }
 
@@ -1229,65 +1486,118 @@ void PubSub::handleResponse(const rapidjson::Document &msg)
         << "Response on unused" << nonce << "client/topic listener mismatch?";
 }
 
-void PubSub::handleListenResponse(const RequestMessage &msg, bool failed)
+void PubSub::handleListenResponse(const RequestMessage &msg,
+                                  const QString &error)
 {
-    DebugCount::decrease("PubSub topic pending listens", msg.topicCount);
-    if (failed)
+    static auto &pubSubTopicPendingListens =
+        Metrics::gauge("PubSub topic pending listens");
+    pubSubTopicPendingListens.decrease(msg.topicCount);
+
+    if (error.isEmpty())
     {
-        DebugCount::increase("PubSub topic failed listens", msg.topicCount);
+        static auto &pubSubTopicListening =
+            Metrics::gauge("PubSub topic listening");
+        pubSubTopicListening.increase(msg.topicCount);
+        this->listenBackoff.reset();
+
+        for (const auto &p : this->clients)
+        {
+            p.second->confirmListeners(msg.topics);
+        }
+        return;
     }
-    else
+
+    static auto &pubSubTopicFailedListens =
+        Metrics::counter("PubSub topic failed listens");
+    pubSubTopicFailedListens.increase(msg.topicCount);
+
+    // Give the topics' budget back to their connection
+    for (const auto &p : this->clients)
+    {
+        p.second->removeListeners(msg.topics);
+    }
+
+    // Bad auth tokens or topics won't work the next time either. Server
+    // errors (e.g. from listening to too many topics too quickly) are retried
+    // with an increasing delay.
+    if (error != "ERR_SERVER")
     {
-        DebugCount::increase("PubSub topic listening", msg.topicCount);
+        return;
     }
+
+    runAfter(this->websocketClient.get_io_service(),
+             this->listenBackoff.next(),
+             [this, topics = msg.topics, authToken = msg.authToken](auto) {
+                 std::lock_guard<std::mutex> lock(this->mutex);
+
+                 this->listen(createListenMessage(topics, authToken));
+             });
 }
 
 void PubSub::handleUnlistenResponse(const RequestMessage &msg, bool failed)
 {
-    DebugCount::decrease("PubSub topic pending unlistens", msg.topicCount);
+    static auto &pubSubTopicPendingUnlistens =
+        Metrics::gauge("PubSub topic pending unlistens");
+    pubSubTopicPendingUnlistens.decrease(msg.topicCount);
     if (failed)
     {
-        DebugCount::increase("PubSub topic failed unlistens", msg.topicCount);
+        static auto &pubSubTopicFailedUnlistens =
+            Metrics::counter("PubSub topic failed unlistens");
+        pubSubTopicFailedUnlistens.increase(msg.topicCount);
     }
     else
     {
-        DebugCount::decrease("PubSub topic listening", msg.topicCount);
+        static auto &pubSubTopicListening =
+            Metrics::gauge("PubSub topic listening");
+        pubSubTopicListening.decrease(msg.topicCount);
     }
 }
 
 void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
 {
-    QString topic;
     qCDebug(chatterinoPubsub) << rj::stringify(outerData);
 
-    if (!rj::getSafe(outerData, "topic", topic))
+    auto topicIt = outerData.FindMember("topic");
+
+    if (topicIt == outerData.MemberEnd() || !topicIt->value.IsString())
     {
         qCDebug(chatterinoPubsub)
             << "Missing required string member `topic` in outerData";
         return;
     }
 
-    QString payload;
+    auto messageIt = outerData.FindMember("message");
 
-    if (!rj::getSafe(outerData, "message", payload))
+    if (messageIt == outerData.MemberEnd() || !messageIt->value.IsString())
     {
         qCDebug(chatterinoPubsub) << "Expected string message in outerData";
         return;
     }
 
-    rapidjson::Document msg;
+    std::string_view topic(topicIt->value.GetString(),
+                           topicIt->value.GetStringLength());
 
-    rapidjson::ParseResult res = msg.Parse(payload.toUtf8());
+    // The frame was parsed in place, so the nested message is an unescaped,
+    // null terminated string in the websocket buffer that we can parse in
+    // place as well
+    InsituDocument document;
+    auto &msg = document.get();
+
+    rapidjson::ParseResult res =
+        document.parse(const_cast<char *>(messageIt->value.GetString()));
 
     if (!res)
     {
         qCDebug(chatterinoPubsub)
-            << QString("Error parsing message '%1' from PubSub: %2")
-                   .arg(payload, rapidjson::GetParseError_En(res.Code()));
+            << QString("Error parsing message from PubSub at offset %1: %2")
+                   .arg(res.Offset())
+                   .arg(rapidjson::GetParseError_En(res.Code()));
         return;
     }
 
-    if (topic.startsWith("whispers."))
+    auto topicType = getTopicType(topic);
+
+    if (topicType == PubSubTopic::Whispers)
     {
         QString whisperType;
 
@@ -1315,10 +1625,9 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
             return;
         }
     }
-    else if (topic.startsWith("chat_moderator_actions."))
+    else if (topicType == PubSubTopic::ChatModeratorActions)
     {
-        auto topicParts = topic.split(".");
-        assert(topicParts.length() == 3);
+        auto channelId = getTopicChannelId(topic);
         const auto &data = msg["data"];
 
         QString moderationEventType;
@@ -1351,7 +1660,7 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
                 return;
             }
             // Invoke handler function
-            handlerIt->second(data, topicParts[2]);
+            handlerIt->second(data, channelId);
         }
         else if (moderationEventType == "channel_terms_action")
         {
@@ -1376,10 +1685,10 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
                 return;
             }
             // Invoke handler function
-            handlerIt->second(data, topicParts[2]);
+            handlerIt->second(data, channelId);
         }
     }
-    else if (topic.startsWith("community-points-channel-v1."))
+    else if (topicType == PubSubTopic::CommunityPointsChannel)
     {
         QString pointEventType;
         if (!rj::getSafe(msg, "type", pointEventType))
@@ -1410,10 +1719,9 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
                 << "Invalid point event type:" << pointEventType;
         }
     }
-    else if (topic.startsWith("automod-queue."))
+    else if (topicType == PubSubTopic::AutomodQueue)
     {
-        auto topicParts = topic.split(".");
-        assert(topicParts.length() == 3);
+        auto channelId = getTopicChannelId(topic);
         auto &data = msg["data"];
 
         QString automodEventType;
@@ -1433,7 +1741,7 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
             }
             if (status == "PENDING")
             {
-                AutomodAction action(data, topicParts[2]);
+                AutomodAction action(data, channelId);
                 rapidjson::Value classification;
                 if (!rj::getSafeObject(data, "content_classification",
                                        classification))
@@ -1562,11 +1870,26 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
     }
     else
     {
-        qCDebug(chatterinoPubsub) << "Unknown topic:" << topic;
+        qCDebug(chatterinoPubsub)
+            << "Unknown topic:" << topicIt->value.GetString();
         return;
     }
 }
 
+std::vector<PubSub::ConnectionStats> PubSub::getConnectionStats()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    std::vector<ConnectionStats> stats;
+    for (const auto &p : this->clients)
+    {
+        const auto &client = p.second;
+        stats.push_back({client->getNumListens(), client->getLatency()});
+    }
+
+    return stats;
+}
+
 void PubSub::runThread()
 {
     qCDebug(chatterinoPubsub) << "Start pubsub manager thread";
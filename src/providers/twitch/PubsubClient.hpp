@@ -4,9 +4,11 @@
 #include "providers/twitch/PubsubActions.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "util/ExponentialBackoff.hpp"
 
 #include <rapidjson/document.h>
 #include <QString>
+#include <boost/optional.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <websocketpp/client.hpp>
 #include <websocketpp/config/asio_client.hpp>
@@ -17,6 +19,7 @@
 #include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <unordered_map>
@@ -46,10 +49,15 @@ using WebsocketErrorCode = websocketpp::lib::error_code;
 
 #define MAX_PUBSUB_LISTENS 50
 #define MAX_PUBSUB_CONNECTIONS 10
+// Idle connections kept open, so topics of a dropped connection or new topics
+// don't have to wait for a connection to open
+#define PUBSUB_STANDBY_CONNECTIONS 1
 
 struct RequestMessage {
     QString payload;
     int topicCount;
+    std::vector<QString> topics;
+    QString authToken;
 };
 
 namespace detail {
@@ -59,6 +67,8 @@ namespace detail {
         bool authed;
         bool persistent;
         bool confirmed = false;
+        // Used to listen to the topic again if the connection drops
+        QString authToken;
     };
 
     class PubSubClient : public std::enable_shared_from_this<PubSubClient>
@@ -73,10 +83,20 @@ namespace detail {
         bool listen(rapidjson::Document &message);
         void unlistenPrefix(const QString &prefix);
 
+        // Forgets the topics without unlistening, used for failed listens
+        void removeListeners(const std::vector<QString> &topics);
+        void confirmListeners(const std::vector<QString> &topics);
+
         void handlePong();
 
         bool isListeningToTopic(const QString &topic);
 
+        const std::vector<Listener> &getListeners() const;
+        int getNumListens() const;
+
+        // Round-trip time of the last answered PING
+        boost::optional<std::chrono::milliseconds> getLatency() const;
+
     private:
         void ping();
         bool send(const char *payload);
@@ -89,8 +109,19 @@ namespace detail {
 
         std::atomic<bool> awaitingPong_{false};
         std::atomic<bool> started_{false};
+
+        std::chrono::steady_clock::time_point pingSentAt_;
+        // In milliseconds, negative until the first PONG
+        std::atomic<int64_t> latency_{-1};
     };
 
+    // Returns the index of the least loaded connection that has room for
+    // `numTopics`, given the number of topics of every connection. Idle
+    // connections are only picked once every used one is full, so they stay
+    // available as standby connections.
+    boost::optional<size_t> pickConnection(const std::vector<int> &numListens,
+                                           int numTopics);
+
 }  // namespace detail
 
 class PubSub
@@ -165,6 +196,14 @@ public:
     void listenToChannelPointRewards(const QString &channelID,
                                      std::shared_ptr<TwitchAccount> account);
 
+    struct ConnectionStats {
+        int topics;
+        boost::optional<std::chrono::milliseconds> latency;
+    };
+
+    // Returns the topic count and latency of every open connection
+    std::vector<ConnectionStats> getConnectionStats();
+
     std::vector<std::unique_ptr<rapidjson::Document>> requests;
 
 private:
@@ -176,8 +215,20 @@ private:
 
     bool isListeningToTopic(const QString &topic);
 
+    // Picks a connection for `numTopics` with detail::pickConnection
+    std::shared_ptr<detail::PubSubClient> pickClient(int numTopics) const;
+    void ensureStandbyClients();
+
     void addClient();
     std::atomic<bool> addingClient{false};
+    ExponentialBackoff<5> connectBackoff{std::chrono::milliseconds(1000)};
+    // Used to retry listens that failed because of server errors
+    ExponentialBackoff<5> listenBackoff{std::chrono::milliseconds(1000)};
+
+    // Guards the clients, the pending requests and the sent listens.
+    // Websocket callbacks run on the PubSub thread while topics are listened
+    // to from the GUI thread.
+    std::mutex mutex;
 
     State state = State::Connected;
 
@@ -196,11 +247,13 @@ private:
     void onMessage(websocketpp::connection_hdl hdl, WebsocketMessagePtr msg);
     void onConnectionOpen(websocketpp::connection_hdl hdl);
     void onConnectionClose(websocketpp::connection_hdl hdl);
+    void onConnectionFail(websocketpp::connection_hdl hdl);
     WebsocketContextPtr onTLSInit(websocketpp::connection_hdl hdl);
 
-    void handleResponse(const rapidjson::Document &msg);
-    void handleListenResponse(const RequestMessage &msg, bool failed);
+    void handleResponse(const rapidjson::Value &msg);
+    void handleListenResponse(const RequestMessage &msg, const QString &error);
     void handleUnlistenResponse(const RequestMessage &msg, bool failed);
+    // `data` has to be parsed in place, see onMessage
     void handleMessageResponse(const rapidjson::Value &data);
 
     void runThread();
@@ -5,6 +5,21 @@
 #include "util/RapidjsonHelpers.hpp"
 
 namespace chatterino {
+namespace {
+
+    // FNV-1a, used to compute the hashes of the known topics at compile time
+    constexpr uint32_t hashTopicPrefix(std::string_view prefix)
+    {
+        uint32_t hash = 2166136261U;
+        for (char c : prefix)
+        {
+            hash ^= uint8_t(c);
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+}  // namespace
 
 const rapidjson::Value &getArgs(const rapidjson::Value &data)
 {
@@ -53,6 +68,13 @@ bool getTargetUserName(const rapidjson::Value &data, ActionUser &user)
 
 rapidjson::Document createListenMessage(const std::vector<QString> &topicsVec,
                                         std::shared_ptr<TwitchAccount> account)
+{
+    return createListenMessage(topicsVec,
+                               account ? account->getOAuthToken() : QString());
+}
+
+rapidjson::Document createListenMessage(const std::vector<QString> &topicsVec,
+                                        const QString &authToken)
 {
     rapidjson::Document msg(rapidjson::kObjectType);
     auto &a = msg.GetAllocator();
@@ -61,9 +83,9 @@ rapidjson::Document createListenMessage(const std::vector<QString> &topicsVec,
 
     rapidjson::Value data(rapidjson::kObjectType);
 
-    if (account)
+    if (!authToken.isEmpty())
     {
-        rj::set(data, "auth_token", account->getOAuthToken(), a);
+        rj::set(data, "auth_token", authToken, a);
     }
 
     rapidjson::Value topics(rapidjson::kArrayType);
@@ -101,4 +123,50 @@ rapidjson::Document createUnlistenMessage(const std::vector<QString> &topicsVec)
     return msg;
 }
 
+PubSubTopic getTopicType(std::string_view topic)
+{
+    auto prefix = topic.substr(0, topic.find('.'));
+
+    // Compare the prefix too, in case an unknown topic has the same hash
+    auto check = [prefix](std::string_view expected, PubSubTopic type) {
+        return prefix == expected ? type : PubSubTopic::Unknown;
+    };
+
+    switch (hashTopicPrefix(prefix))
+    {
+        case hashTopicPrefix("whispers"):
+            return check("whispers", PubSubTopic::Whispers);
+        case hashTopicPrefix("chat_moderator_actions"):
+            return check("chat_moderator_actions",
+                         PubSubTopic::ChatModeratorActions);
+        case hashTopicPrefix("community-points-channel-v1"):
+            return check("community-points-channel-v1",
+                         PubSubTopic::CommunityPointsChannel);
+        case hashTopicPrefix("automod-queue"):
+            return check("automod-queue", PubSubTopic::AutomodQueue);
+        default:
+            return PubSubTopic::Unknown;
+    }
+}
+
+QString getTopicChannelId(std::string_view topic)
+{
+    auto channelId = topic.substr(topic.rfind('.') + 1);
+
+    return QString::fromUtf8(channelId.data(), int(channelId.size()));
+}
+
+InsituDocument::InsituDocument()
+    : valueAllocator_(this->valueBuffer_, VALUE_BUFFER_SIZE)
+    , stackAllocator_(this->stackBuffer_, STACK_BUFFER_SIZE)
+    , document_(&this->valueAllocator_, STACK_BUFFER_SIZE / 2,
+                &this->stackAllocator_)
+{
+}
+
+rapidjson::ParseResult InsituDocument::parse(char *json)
+{
+    return this->document_.ParseInsitu(json);
+}
+
 }  // namespace chatterino
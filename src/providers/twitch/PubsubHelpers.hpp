@@ -3,6 +3,7 @@
 #include <boost/asio.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <memory>
+#include <string_view>
 #include "common/QLogging.hpp"
 #include "util/RapidjsonHelpers.hpp"
 
@@ -21,9 +22,65 @@ bool getTargetUserName(const rapidjson::Value &data, ActionUser &user);
 
 rapidjson::Document createListenMessage(const std::vector<QString> &topicsVec,
                                         std::shared_ptr<TwitchAccount> account);
+// An empty `authToken` listens without authentication
+rapidjson::Document createListenMessage(const std::vector<QString> &topicsVec,
+                                        const QString &authToken);
 rapidjson::Document createUnlistenMessage(
     const std::vector<QString> &topicsVec);
 
+enum class PubSubTopic : uint8_t {
+    Unknown,
+    Whispers,
+    ChatModeratorActions,
+    CommunityPointsChannel,
+    AutomodQueue,
+};
+
+// Returns the type of `topic` (e.g. "automod-queue.<user id>.<channel id>")
+// by hashing the part before the first dot
+PubSubTopic getTopicType(std::string_view topic);
+
+// Returns the part after the last dot of `topic`, which is the channel id for
+// moderation and automod topics
+QString getTopicChannelId(std::string_view topic);
+
+// A JSON document that is parsed in place from a mutable buffer.
+//
+// Its strings point into the parsed buffer, so the buffer has to outlive the
+// document. Values and the parse stack are allocated from inline buffers
+// first, so parsing a typical PubSub frame doesn't allocate at all.
+class InsituDocument
+{
+public:
+    using Document =
+        rapidjson::GenericDocument<rapidjson::UTF8<>,
+                                   rapidjson::MemoryPoolAllocator<>,
+                                   rapidjson::MemoryPoolAllocator<>>;
+
+    InsituDocument();
+
+    InsituDocument(const InsituDocument &) = delete;
+    InsituDocument &operator=(const InsituDocument &) = delete;
+
+    // `json` has to be null terminated, it's modified while parsing
+    rapidjson::ParseResult parse(char *json);
+
+    Document &get()
+    {
+        return this->document_;
+    }
+
+private:
+    static constexpr size_t VALUE_BUFFER_SIZE = 4096;
+    static constexpr size_t STACK_BUFFER_SIZE = 1024;
+
+    char valueBuffer_[VALUE_BUFFER_SIZE];
+    char stackBuffer_[STACK_BUFFER_SIZE];
+    rapidjson::MemoryPoolAllocator<> valueAllocator_;
+    rapidjson::MemoryPoolAllocator<> stackAllocator_;
+    Document document_;
+};
+
 // Create timer using given ioService
 template <typename Duration, typename Callback>
 void runAfter(boost::asio::io_service &ioService, Duration duration,
@@ -8,6 +8,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/notifications/NotificationController.hpp"
 #include "messages/Message.hpp"
+#include "messages/MessageSpillStore.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/bttv/LoadBttvChannelEmote.hpp"
 #include "providers/chatterino/ChatterinoBadges.hpp"
@@ -16,6 +17,7 @@
 #include "providers/itzalex/itzAlexBadges.hpp"
 #include "providers/seventv/SeventvBadges.hpp"
 #include "providers/seventv/SeventvEmotes.hpp"
+#include "providers/seventv/SeventvWebSocket.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "providers/twitch/PubsubClient.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
@@ -194,16 +196,11 @@ TwitchChannel::TwitchChannel(const QString &name)
         this->refreshBTTVChannelEmotes(false);
     });
 
-    // timers
+    // timers, started once the channel is activated
+    // the live status is periodically refreshed in bulk by TwitchIrcServer
     QObject::connect(&this->chattersListTimer_, &QTimer::timeout, [=] {
         this->refreshChatters();
     });
-    this->chattersListTimer_.start(5 * 60 * 1000);
-
-    QObject::connect(&this->liveStatusTimer_, &QTimer::timeout, [=] {
-        this->refreshLiveStatus();
-    });
-    this->liveStatusTimer_.start(60 * 1000);
 
     // debugging
 #if 0
@@ -213,6 +210,14 @@ TwitchChannel::TwitchChannel(const QString &name)
 #endif
 }
 
+TwitchChannel::~TwitchChannel()
+{
+    if (!this->isEmpty() && this->isActivated())
+    {
+        getApp()->twitch2->seventvEventApi->partChannel(this->getName());
+    }
+}
+
 void TwitchChannel::initialize()
 {
     this->fetchDisplayName();
@@ -220,6 +225,20 @@ void TwitchChannel::initialize()
     this->refreshBadges();
 }
 
+void TwitchChannel::onActivated()
+{
+    this->initialize();
+
+    // 7TV emote set changes are applied as they happen, see
+    // TwitchIrcServer::initialize
+    if (!this->isEmpty())
+    {
+        getApp()->twitch2->seventvEventApi->joinChannel(this->getName());
+    }
+
+    this->chattersListTimer_.start(5 * 60 * 1000);
+}
+
 bool TwitchChannel::isEmpty() const
 {
     return this->getName().isEmpty();
@@ -268,6 +287,33 @@ void TwitchChannel::refresh7TVChannelEmotes(bool manualRefresh)
         manualRefresh);
 }
 
+void TwitchChannel::applySeventvEmoteEvent(const SeventvEmoteEvent &event)
+{
+    auto updated =
+        SeventvEmotes::applyEmoteEvent(*this->seventvEmotes_.get(), event);
+    if (!updated)
+    {
+        return;
+    }
+
+    this->seventvEmotes_.set(std::make_shared<EmoteMap>(std::move(*updated)));
+
+    QString text;
+    switch (event.action)
+    {
+        case SeventvEmoteEvent::Action::Add:
+            text = "%1 added 7TV emote %2.";
+            break;
+        case SeventvEmoteEvent::Action::Remove:
+            text = "%1 removed 7TV emote %2.";
+            break;
+        case SeventvEmoteEvent::Action::Update:
+            text = "%1 renamed a 7TV emote to %2.";
+            break;
+    }
+    this->addMessage(makeSystemMessage(text.arg(event.actor, event.name)));
+}
+
 void TwitchChannel::refreshHomiesChannelEmotes(bool manualRefresh)
 {
     HomiesEmotes::loadChannel(
@@ -843,6 +889,42 @@ void TwitchChannel::parseLiveStatus(bool live, const HelixStream &stream)
     this->liveStatusChanged.invoke();
 }
 
+MessagePtr TwitchChannel::rebuildMessage(const SpilledMessage &message)
+{
+    if (message.ircData.isEmpty())
+    {
+        return Channel::rebuildMessage(message);
+    }
+
+    std::unique_ptr<Communi::IrcMessage> ircMessage(
+        Communi::IrcMessage::fromData(message.ircData, nullptr));
+
+    // Keeps the original timestamp and doesn't trigger highlights again
+    auto tags = ircMessage->tags();
+    tags.insert("historical", "1");
+    ircMessage->setTags(tags);
+
+    auto built =
+        IrcMessageHandler::instance().parseMessage(this, ircMessage.get());
+    if (built.empty())
+    {
+        // Ignored since it was spilled
+        return nullptr;
+    }
+
+    // Restore what happened to the message before it was spilled
+    auto rebuilt = built.front();
+    for (auto flag : {MessageFlag::Disabled, MessageFlag::RecentMessage})
+    {
+        if (message.flags.has(flag))
+        {
+            rebuilt->flags.set(flag);
+        }
+    }
+
+    return rebuilt;
+}
+
 void TwitchChannel::loadRecentMessages()
 {
     if (!getSettings()->loadTwitchMessageHistoryOnConnect)
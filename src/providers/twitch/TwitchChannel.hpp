@@ -31,6 +31,7 @@ class EmoteMap;
 
 class TwitchBadges;
 class SeventvEmotes;
+struct SeventvEmoteEvent;
 class HomiesEmotes;
 class FfzEmotes;
 class BttvEmotes;
@@ -59,6 +60,8 @@ public:
         int slowMode = 0;
     };
 
+    ~TwitchChannel() override;
+
     void initialize();
 
     // Channel methods
@@ -81,6 +84,7 @@ public:
     const QString &popoutPlayerUrl();
     int chatterCount();
     virtual bool isLive() const override;
+    MessagePtr rebuildMessage(const SpilledMessage &message) override;
     QString roomId() const;
     SharedAccessGuard<const RoomModes> accessRoomModes() const;
     SharedAccessGuard<const StreamStatus> accessStreamStatus() const;
@@ -124,6 +128,9 @@ public:
     boost::optional<ChannelPointReward> channelPointReward(
         const QString &rewardId) const;
 
+    // Applies a change of the 7TV emote set of this channel
+    void applySeventvEmoteEvent(const SeventvEmoteEvent &event);
+
 private:
     struct NameOptions {
         QString displayName;
@@ -133,6 +140,8 @@ private:
 protected:
     explicit TwitchChannel(const QString &channelName);
 
+    void onActivated() override;
+
 private:
     // Methods
     void refreshLiveStatus();
@@ -187,7 +196,6 @@ private:
     // --
     QString lastSentMessage_;
     QObject lifetimeGuard_;
-    QTimer liveStatusTimer_;
     QTimer chattersListTimer_;
     QElapsedTimer titleRefreshedTimer_;
     QElapsedTimer clipCreationTimer_;
@@ -44,12 +44,8 @@ EmotePtr TwitchEmotes::getOrCreateEmote(const EmoteId &id,
     auto name = TwitchEmotes::cleanUpEmoteCode(name_.string);
 
     // search in cache or create new emote
-    auto cache = this->twitchEmotesCache_.access();
-    auto shared = (*cache)[id].lock();
-
-    if (!shared)
-    {
-        (*cache)[id] = shared = std::make_shared<Emote>(Emote{
+    return this->twitchEmotesCache_.getOrCreate(id, [&] {
+        return std::make_shared<const Emote>(Emote{
             EmoteName{name},
             ImageSet{
                 Image::fromUrl(getEmoteLink(id, "1.0"), 1),
@@ -58,9 +54,7 @@ EmotePtr TwitchEmotes::getOrCreateEmote(const EmoteId &id,
             },
             Tooltip{name.toHtmlEscaped() + "<br>Twitch Emote"},
         });
-    }
-
-    return shared;
+    });
 }
 
 Url TwitchEmotes::getEmoteLink(const EmoteId &id, const QString &emoteScale)
@@ -6,7 +6,7 @@
 #include <unordered_map>
 
 #include "common/Aliases.hpp"
-#include "common/UniqueAccess.hpp"
+#include "common/WeakRegistry.hpp"
 
 #include <memory>
 
@@ -43,8 +43,8 @@ public:
 
 private:
     Url getEmoteLink(const EmoteId &id, const QString &emoteScale);
-    UniqueAccess<std::unordered_map<EmoteId, std::weak_ptr<Emote>>>
-        twitchEmotesCache_;
+    WeakRegistry<EmoteId, const Emote> twitchEmotesCache_{
+        "twitch emote registry"};
 
     std::mutex mutex_;
 };
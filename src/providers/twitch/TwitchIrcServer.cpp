@@ -10,19 +10,35 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "providers/seventv/SeventvWebSocket.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "providers/twitch/PubsubClient.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchHelpers.hpp"
+#include "providers/twitch/api/Helix.hpp"
+#include "util/Helpers.hpp"
 #include "util/PostToThread.hpp"
+#include "util/QStringHash.hpp"
 
 #include <QMetaEnum>
+#include <QSet>
+
+#include <unordered_map>
 
 // using namespace Communi;
 using namespace std::chrono_literals;
 
 namespace chatterino {
+namespace {
+
+    constexpr int LIVE_STATUS_REFRESH_INTERVAL = 60 * 1000;
+
+    // Delay between two consecutive live status batch requests, so a large
+    // amount of channels doesn't burst our Helix rate limit
+    constexpr int LIVE_STATUS_BATCH_STAGGER = 2000;
+
+}  // namespace
 
 TwitchIrcServer::TwitchIrcServer()
     : whispersChannel(new Channel("/whispers", Channel::Type::TwitchWhispers))
@@ -33,6 +49,8 @@ TwitchIrcServer::TwitchIrcServer()
     this->initializeIrc();
 
     this->pubsub = new PubSub;
+    this->seventvEventApi =
+        std::make_unique<SeventvWebSocket>(Env::get().seventvEventApiUrl);
 
     // getSettings()->twitchSeperateWriteConnection.connect([this](auto, auto) {
     // this->connect(); },
@@ -40,6 +58,8 @@ TwitchIrcServer::TwitchIrcServer()
     //                                                     false);
 }
 
+TwitchIrcServer::~TwitchIrcServer() = default;
+
 void TwitchIrcServer::initialize(Settings &settings, Paths &paths)
 {
     getApp()->accounts->twitch.currentUserChanged.connect([this]() {
@@ -49,9 +69,109 @@ void TwitchIrcServer::initialize(Settings &settings, Paths &paths)
     });
 
     this->seventv.loadEmotes();
+    // Each event only goes to the channel whose emote set changed
+    this->signalHolder_.managedConnect(
+        this->seventvEventApi->emoteEvent, [this](const auto &event) {
+            auto chan = this->getChannelOrEmpty(event.channel);
+            if (auto *twitchChannel = dynamic_cast<TwitchChannel *>(chan.get()))
+            {
+                twitchChannel->applySeventvEmoteEvent(event);
+            }
+        });
+    this->seventvEventApi->start();
     this->bttv.loadEmotes();
     this->ffz.loadEmotes();
     this->homies.loadEmotes();
+
+    QObject::connect(&this->bulkLiveStatusTimer_, &QTimer::timeout, [this] {
+        this->bulkRefreshLiveStatus();
+    });
+    this->bulkLiveStatusTimer_.start(LIVE_STATUS_REFRESH_INTERVAL);
+}
+
+void TwitchIrcServer::bulkRefreshLiveStatus()
+{
+    // room id -> channel
+    auto twitchChannels =
+        std::make_shared<std::unordered_map<QString, std::weak_ptr<Channel>>>();
+
+    this->forEachChannel([&twitchChannels](ChannelPtr chan) {
+        auto *tc = dynamic_cast<TwitchChannel *>(chan.get());
+        if (tc == nullptr)
+        {
+            return;
+        }
+
+        // Channels without a room id haven't been joined yet
+        auto roomId = tc->roomId();
+        if (!roomId.isEmpty())
+        {
+            twitchChannels->emplace(roomId, chan);
+        }
+    });
+
+    QStringList roomIds;
+    for (const auto &[roomId, weak] : *twitchChannels)
+    {
+        roomIds.append(roomId);
+    }
+
+    auto batches = splitListIntoBatches(roomIds);
+
+    for (size_t i = 0; i < batches.size(); i++)
+    {
+        QTimer::singleShot(
+            int(i) * LIVE_STATUS_BATCH_STAGGER, this,
+            [twitchChannels, batch = batches[i]] {
+                getHelix()->fetchStreams(
+                    batch, {},
+                    [twitchChannels, batch](const auto &streams) {
+                        QSet<QString> liveRoomIds;
+
+                        for (const auto &stream : streams)
+                        {
+                            auto it = twitchChannels->find(stream.userId);
+                            if (it == twitchChannels->end())
+                            {
+                                continue;
+                            }
+
+                            liveRoomIds.insert(stream.userId);
+
+                            if (auto chan = it->second.lock())
+                            {
+                                static_cast<TwitchChannel *>(chan.get())
+                                    ->parseLiveStatus(true, stream);
+                            }
+                        }
+
+                        // Channels that weren't part of the response are
+                        // offline
+                        for (const auto &roomId : batch)
+                        {
+                            if (liveRoomIds.contains(roomId))
+                            {
+                                continue;
+                            }
+
+                            auto it = twitchChannels->find(roomId);
+                            if (it == twitchChannels->end())
+                            {
+                                continue;
+                            }
+
+                            if (auto chan = it->second.lock())
+                            {
+                                static_cast<TwitchChannel *>(chan.get())
+                                    ->parseLiveStatus(false, HelixStream());
+                            }
+                        }
+                    },
+                    [] {
+                        // failure
+                    });
+            });
+    }
 }
 
 void TwitchIrcServer::initializeConnection(IrcConnection *connection,
@@ -105,9 +225,9 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
 std::shared_ptr<Channel> TwitchIrcServer::createChannel(
     const QString &channelName)
 {
+    // the channel initializes itself once it gets activated
     auto channel =
         std::shared_ptr<TwitchChannel>(new TwitchChannel(channelName));
-    channel->initialize();
 
     channel->sendMessageSignal.connect(
         [this, channel = channel.get()](auto &chan, auto &msg, bool &sent) {
@@ -19,13 +19,14 @@ namespace chatterino {
 class Settings;
 class Paths;
 class PubSub;
+class SeventvWebSocket;
 class TwitchChannel;
 
 class TwitchIrcServer final : public AbstractIrcServer, public Singleton
 {
 public:
     TwitchIrcServer();
-    virtual ~TwitchIrcServer() override = default;
+    virtual ~TwitchIrcServer() override;
 
     virtual void initialize(Settings &settings, Paths &paths) override;
 
@@ -41,6 +42,7 @@ public:
     IndirectChannel watchingChannel;
 
     PubSub *pubsub;
+    std::unique_ptr<SeventvWebSocket> seventvEventApi;
 
     const SeventvEmotes &getSeventvEmotes() const;
     const BttvEmotes &getBttvEmotes() const;
@@ -70,6 +72,10 @@ private:
     void onMessageSendRequested(TwitchChannel *channel, const QString &message,
                                 bool &sent);
 
+    // Refreshes the live status of all joined Twitch channels, batching up to
+    // 100 channels per Helix request
+    void bulkRefreshLiveStatus();
+
     std::mutex lastMessageMutex_;
     std::queue<std::chrono::steady_clock::time_point> lastMessagePleb_;
     std::queue<std::chrono::steady_clock::time_point> lastMessageMod_;
@@ -81,6 +87,8 @@ private:
     FfzEmotes ffz;
     HomiesEmotes homies;
 
+    QTimer bulkLiveStatusTimer_;
+
     pajlada::Signals::SignalHolder signalHolder_;
 };
 
@@ -3,22 +3,22 @@
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
+#include "controllers/ignores/IgnoreEngine.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "messages/Message.hpp"
-#include "providers/chatterino/ChatterinoBadges.hpp"
-#include "providers/ffz/FfzBadges.hpp"
-#include "providers/itzalex/itzAlexBadges.hpp"
-#include "providers/seventv/SeventvBadges.hpp"
+#include "providers/BadgeRegistry.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Emotes.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Helpers.hpp"
 #include "util/IrcHelpers.hpp"
+#include "util/Metrics.hpp"
 #include "widgets/Window.hpp"
 
 #include <QApplication>
@@ -137,6 +137,9 @@ void TwitchMessageBuilder::triggerHighlights()
 
 MessagePtr TwitchMessageBuilder::build()
 {
+    static auto &messageBuild = Metrics::histogram("message build");
+    MetricTimer timer(messageBuild);
+
     // PARSE
     this->userId_ = this->ircMessage->tag("user-id").toString();
 
@@ -149,6 +152,12 @@ MessagePtr TwitchMessageBuilder::build()
 
     this->message().channelName = this->channel->getName();
 
+    // Only needed to rebuild the message once it's spilled
+    if (this->ircMessage->command() == "PRIVMSG" && Channel::spillLimit() > 0)
+    {
+        this->message().ircData = this->ircMessage->toData();
+    }
+
     this->parseMessageID();
 
     this->parseRoomID();
@@ -201,10 +210,7 @@ MessagePtr TwitchMessageBuilder::build()
 
     this->appendTwitchBadges();
 
-    this->appendChatterinoBadges();
-    this->appendSeventvBadges();
-    this->appendFfzBadges();
-    this->appenditzAlexBadges();
+    this->appendThirdPartyBadges();
 
     this->appendUsername();
 
@@ -264,7 +270,8 @@ MessagePtr TwitchMessageBuilder::build()
     this->parseHighlights();
 
     // highlighting incoming whispers if requested per setting
-    if (this->args.isReceivedWhisper && getSettings()->highlightInlineWhispers)
+    if (this->args.isReceivedWhisper &&
+        this->renderSettings_->highlightInlineWhispers)
     {
         this->message().flags.set(MessageFlag::HighlightedWhisper, true);
         this->message().highlightColor =
@@ -429,7 +436,8 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
             QString username = match.captured(1);
             auto originalTextColor = textColor;
 
-            if (this->twitchChannel != nullptr && getSettings()->colorUsernames)
+            if (this->twitchChannel != nullptr &&
+                this->renderSettings_->colorUsernames)
             {
                 if (auto userColor =
                         this->twitchChannel->getUserColor(username);
@@ -460,7 +468,8 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
         }
     }
 
-    if (this->twitchChannel != nullptr && getSettings()->findAllUsernames)
+    if (this->twitchChannel != nullptr &&
+        this->renderSettings_->findAllUsernames)
     {
         auto match = allUsernamesMentionRegex.match(string);
         QString username = match.captured(1);
@@ -470,7 +479,7 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
         {
             auto originalTextColor = textColor;
 
-            if (getSettings()->colorUsernames)
+            if (this->renderSettings_->colorUsernames)
             {
                 if (auto userColor =
                         this->twitchChannel->getUserColor(username);
@@ -563,7 +572,8 @@ void TwitchMessageBuilder::parseUsernameColor()
         }
     }
 
-    if (getSettings()->colorizeNicknames && this->tags.contains("user-id"))
+    if (this->renderSettings_->colorizeNicknames &&
+        this->tags.contains("user-id"))
     {
         this->usernameColor_ =
             getRandomColor(this->tags.value("user-id").toString());
@@ -636,7 +646,7 @@ void TwitchMessageBuilder::appendUsername()
     // The full string that will be rendered in the chat widget
     QString usernameText;
 
-    switch (getSettings()->usernameDisplayMode.getValue())
+    switch (this->renderSettings_->usernameDisplayMode)
     {
         case UsernameDisplayMode::Username: {
             usernameText = username;
@@ -725,220 +735,129 @@ void TwitchMessageBuilder::appendUsername()
 void TwitchMessageBuilder::runIgnoreReplaces(
     std::vector<TwitchEmoteOccurence> &twitchEmotes)
 {
-    auto phrases = getCSettings().ignoredMessages.readOnly();
-    auto removeEmotesInRange = [](int pos, int len,
-                                  auto &twitchEmotes) mutable {
-        auto it = std::partition(
-            twitchEmotes.begin(), twitchEmotes.end(),
-            [pos, len](const auto &item) {
-                return !((item.start >= pos) && item.start < (pos + len));
-            });
-        for (auto copy = it; copy != twitchEmotes.end(); ++copy)
-        {
-            if ((*copy).ptr == nullptr)
-            {
-                qCDebug(chatterinoTwitch)
-                    << "remem nullptr" << (*copy).name.string;
-            }
-        }
-        std::vector<TwitchEmoteOccurence> v(it, twitchEmotes.end());
-        twitchEmotes.erase(it, twitchEmotes.end());
-        return v;
-    };
+    auto engine = IgnoreEngine::current();
+    auto result = engine->replace(this->originalMessage_);
+    if (result.replacements.empty())
+    {
+        return;
+    }
 
-    auto shiftIndicesAfter = [&twitchEmotes](int pos, int by) mutable {
-        for (auto &item : twitchEmotes)
+    this->originalMessage_ = std::move(result.text);
+    const auto &message = this->originalMessage_;
+
+    // Emotes and replacements are both ordered by position, so all emotes can
+    // be moved to their new position in one go
+    std::sort(twitchEmotes.begin(), twitchEmotes.end(),
+              [](const auto &a, const auto &b) {
+                  return a.start < b.start;
+              });
+
+    std::vector<TwitchEmoteOccurence> emotes;
+    emotes.reserve(twitchEmotes.size());
+
+    auto emote = twitchEmotes.begin();
+    int shift = 0;
+
+    for (const auto &replacement : result.replacements)
+    {
+        for (; emote != twitchEmotes.end() && emote->start < replacement.from;
+             ++emote)
         {
-            auto &index = item.start;
-            if (index >= pos)
-            {
-                index += by;
-                item.end += by;
-            }
+            emote->start += shift;
+            emote->end += shift;
+            emotes.push_back(std::move(*emote));
         }
-    };
 
-    auto addReplEmotes = [&twitchEmotes](const IgnorePhrase &phrase,
-                                         const QStringRef &midrepl,
-                                         int startIndex) mutable {
-        if (!phrase.containsEmote())
+        // Emotes that were replaced are kept if they are still there, e.g.
+        // because the replacement kept that word
+        std::vector<TwitchEmoteOccurence> replaced;
+        for (; emote != twitchEmotes.end() &&
+               emote->start < replacement.from + replacement.length;
+             ++emote)
         {
-            return;
+            replaced.push_back(std::move(*emote));
         }
 
-        QVector<QStringRef> words = midrepl.split(' ');
-        int pos = 0;
-        for (const auto &word : words)
+        shift += replacement.outputLength - replacement.length;
+
+        const auto &phrase = *replacement.phrase;
+        if (replaced.empty() && !phrase.containsEmote())
         {
-            for (const auto &emote : phrase.getEmotes())
-            {
-                if (word == emote.first.string)
-                {
-                    if (emote.second == nullptr)
-                    {
-                        qCDebug(chatterinoTwitch)
-                            << "emote null" << emote.first.string;
-                    }
-                    twitchEmotes.push_back(TwitchEmoteOccurence{
-                        startIndex + pos,
-                        startIndex + pos + emote.first.string.length(),
-                        emote.second,
-                        emote.first,
-                    });
-                }
-            }
-            pos += word.length() + 1;
+            continue;
         }
-    };
 
-    for (const auto &phrase : *phrases)
-    {
-        if (phrase.isBlock())
+        // The words the replacement ended up in
+        int wordsStart = replacement.outputFrom;
+        while (wordsStart > 0 && message[wordsStart - 1] != ' ')
         {
-            continue;
+            --wordsStart;
         }
-        const auto &pattern = phrase.getPattern();
-        if (pattern.isEmpty())
+        int wordsEnd = replacement.outputFrom + replacement.outputLength;
+        while (wordsEnd < message.length() && message[wordsEnd] != ' ')
         {
-            continue;
+            ++wordsEnd;
         }
-        if (phrase.isRegex())
+        auto words = message.midRef(wordsStart, wordsEnd - wordsStart);
+
+        for (auto &occurence : replaced)
         {
-            const auto &regex = phrase.getRegex();
-            if (!regex.isValid())
+            if (occurence.ptr == nullptr)
             {
+                qCDebug(chatterinoTwitch)
+                    << "v nullptr" << occurence.name.string;
                 continue;
             }
-            QRegularExpressionMatch match;
-            int from = 0;
-            while ((from = this->originalMessage_.indexOf(regex, from,
-                                                          &match)) != -1)
-            {
-                int len = match.capturedLength();
-                auto vret = removeEmotesInRange(from, len, twitchEmotes);
-                auto mid = this->originalMessage_.mid(from, len);
-                mid.replace(regex, phrase.getReplace());
-
-                int midsize = mid.size();
-                this->originalMessage_.replace(from, len, mid);
-                int pos1 = from;
-                while (pos1 > 0)
-                {
-                    if (this->originalMessage_[pos1 - 1] == ' ')
-                    {
-                        break;
-                    }
-                    --pos1;
-                }
-                int pos2 = from + midsize;
-                while (pos2 < this->originalMessage_.length())
-                {
-                    if (this->originalMessage_[pos2] == ' ')
-                    {
-                        break;
-                    }
-                    ++pos2;
-                }
-
-                shiftIndicesAfter(from + len, midsize - len);
-
-                auto midExtendedRef =
-                    this->originalMessage_.midRef(pos1, pos2 - pos1);
-
-                for (auto &tup : vret)
-                {
-                    if (tup.ptr == nullptr)
-                    {
-                        qCDebug(chatterinoTwitch)
-                            << "v nullptr" << tup.name.string;
-                        continue;
-                    }
-                    QRegularExpression emoteregex(
-                        "\\b" + tup.name.string + "\\b",
-                        QRegularExpression::UseUnicodePropertiesOption);
-                    auto _match = emoteregex.match(midExtendedRef);
-                    if (_match.hasMatch())
-                    {
-                        int last = _match.lastCapturedIndex();
-                        for (int i = 0; i <= last; ++i)
-                        {
-                            tup.start = from + _match.capturedStart();
-                            twitchEmotes.push_back(std::move(tup));
-                        }
-                    }
-                }
-
-                addReplEmotes(phrase, midExtendedRef, pos1);
 
-                from += midsize;
+            QRegularExpression emoteregex(
+                "\\b" + occurence.name.string + "\\b",
+                QRegularExpression::UseUnicodePropertiesOption);
+            auto match = emoteregex.match(words);
+            if (match.hasMatch())
+            {
+                auto length = occurence.end - occurence.start;
+                occurence.start = wordsStart + match.capturedStart();
+                occurence.end = occurence.start + length;
+                emotes.push_back(std::move(occurence));
             }
         }
-        else
-        {
-            int from = 0;
-            while ((from = this->originalMessage_.indexOf(
-                        pattern, from, phrase.caseSensitivity())) != -1)
-            {
-                int len = pattern.size();
-                auto vret = removeEmotesInRange(from, len, twitchEmotes);
-                auto replace = phrase.getReplace();
 
-                int replacesize = replace.size();
-                this->originalMessage_.replace(from, len, replace);
-
-                int pos1 = from;
-                while (pos1 > 0)
-                {
-                    if (this->originalMessage_[pos1 - 1] == ' ')
-                    {
-                        break;
-                    }
-                    --pos1;
-                }
-                int pos2 = from + replacesize;
-                while (pos2 < this->originalMessage_.length())
-                {
-                    if (this->originalMessage_[pos2] == ' ')
-                    {
-                        break;
-                    }
-                    ++pos2;
-                }
-
-                shiftIndicesAfter(from + len, replacesize - len);
-
-                auto midExtendedRef =
-                    this->originalMessage_.midRef(pos1, pos2 - pos1);
+        if (!phrase.containsEmote())
+        {
+            continue;
+        }
 
-                for (auto &tup : vret)
+        int pos = 0;
+        for (const auto &word : words.split(' '))
+        {
+            for (const auto &[name, ptr] : phrase.getEmotes())
+            {
+                if (word == name.string)
                 {
-                    if (tup.ptr == nullptr)
+                    if (ptr == nullptr)
                     {
                         qCDebug(chatterinoTwitch)
-                            << "v nullptr" << tup.name.string;
-                        continue;
-                    }
-                    QRegularExpression emoteregex(
-                        "\\b" + tup.name.string + "\\b",
-                        QRegularExpression::UseUnicodePropertiesOption);
-                    auto match = emoteregex.match(midExtendedRef);
-                    if (match.hasMatch())
-                    {
-                        int last = match.lastCapturedIndex();
-                        for (int i = 0; i <= last; ++i)
-                        {
-                            tup.start = from + match.capturedStart();
-                            twitchEmotes.push_back(std::move(tup));
-                        }
+                            << "emote null" << name.string;
                     }
+                    emotes.push_back(TwitchEmoteOccurence{
+                        wordsStart + pos,
+                        wordsStart + pos + name.string.length(),
+                        ptr,
+                        name,
+                    });
                 }
-
-                addReplEmotes(phrase, midExtendedRef, pos1);
-
-                from += replacesize;
             }
+            pos += word.length() + 1;
         }
     }
+
+    for (; emote != twitchEmotes.end(); ++emote)
+    {
+        emote->start += shift;
+        emote->end += shift;
+        emotes.push_back(std::move(*emote));
+    }
+
+    twitchEmotes = std::move(emotes);
 }
 
 void TwitchMessageBuilder::appendTwitchEmote(
@@ -1036,7 +955,7 @@ Outcome TwitchMessageBuilder::tryAppendEmote(const EmoteName &name)
             flags.set(MessageElementFlag::ZeroWidthEmote);
         }
     }
-    else if (getSettings()->enable7TVGlobalEmotes &&
+    else if (this->renderSettings_->enable7TVGlobalEmotes &&
              (emote = globalSeventvEmotes.emote(name)))
     {
         flags = MessageElementFlag::SeventvEmote;
@@ -1045,7 +964,7 @@ Outcome TwitchMessageBuilder::tryAppendEmote(const EmoteName &name)
             flags.set(MessageElementFlag::ZeroWidthEmote);
         }
     }
-    else if (getSettings()->enableHomiesGlobalEmotes &&
+    else if (this->renderSettings_->enableHomiesGlobalEmotes &&
              (emote = globalHomiesEmotes.emote(name)))
     {
         flags = MessageElementFlag::HomiesEmote;
@@ -1054,12 +973,12 @@ Outcome TwitchMessageBuilder::tryAppendEmote(const EmoteName &name)
             flags.set(MessageElementFlag::ZeroWidthEmote);
         }
     }
-    else if (getSettings()->enableFFZGlobalEmotes &&
+    else if (this->renderSettings_->enableFFZGlobalEmotes &&
              (emote = globalFfzEmotes.emote(name)))
     {
         flags = MessageElementFlag::FfzEmote;
     }
-    else if (getSettings()->enableBTTVGlobalEmotes &&
+    else if (this->renderSettings_->enableBTTVGlobalEmotes &&
              (emote = globalBttvEmotes.emote(name)))
     {
         flags = MessageElementFlag::BttvEmote;
@@ -1122,7 +1041,7 @@ void TwitchMessageBuilder::appendTwitchBadges()
             tooltip = QString("Twitch cheer %0").arg(cheerAmount);
         }
         else if (badge.key_ == "moderator" &&
-                 getSettings()->useCustomFfzModeratorBadges)
+                 this->renderSettings_->useCustomFfzModeratorBadges)
         {
             if (auto customModBadge = this->twitchChannel->ffzCustomModBadge())
             {
@@ -1134,7 +1053,8 @@ void TwitchMessageBuilder::appendTwitchBadges()
                 continue;
             }
         }
-        else if (badge.key_ == "vip" && getSettings()->useCustomFfzVipBadges)
+        else if (badge.key_ == "vip" &&
+                 this->renderSettings_->useCustomFfzVipBadges)
         {
             if (auto customVipBadge = this->twitchChannel->ffzCustomVipBadge())
             {
@@ -1186,51 +1106,22 @@ void TwitchMessageBuilder::appendTwitchBadges()
     }
 
     this->message().badges = badges;
-    this->message().badgeInfos = badgeInfos;
+    this->message().badgeInfos.assign(badgeInfos.begin(), badgeInfos.end());
 }
 
-void TwitchMessageBuilder::appendChatterinoBadges()
+void TwitchMessageBuilder::appendThirdPartyBadges()
 {
-    if (auto badge = getApp()->chatterinoBadges->getBadge({this->userId_}))
+    for (auto &&badge : BadgeRegistry::instance().getBadges(this->userId_))
     {
-        this->emplace<BadgeElement>(*badge,
-                                    MessageElementFlag::BadgeChatterino);
-    }
-}
-
-void TwitchMessageBuilder::appendSeventvBadges()
-{
-    if (auto badge = getApp()->seventvBadges->getBadge({this->userId_}))
-    {
-        this->emplace<BadgeElement>(*badge, MessageElementFlag::BadgeSeventv);
-    }
-}
-
-void TwitchMessageBuilder::appendFfzBadges()
-{
-    if (auto badge = getApp()->ffzBadges->getBadge({this->userId_}))
-    {
-        if (auto color = getApp()->ffzBadges->getBadgeColor({this->userId_}))
+        if (badge.color)
         {
-            this->emplace<FfzBadgeElement>(*badge, MessageElementFlag::BadgeFfz,
-                                           color.get());
+            this->emplace<FfzBadgeElement>(badge.emote, badge.flag,
+                                           *badge.color);
+        }
+        else
+        {
+            this->emplace<BadgeElement>(badge.emote, badge.flag);
         }
-    }
-}
-
-void TwitchMessageBuilder::appenditzAlexBadges()
-{
-    if (auto badge = getApp()->itzalexBadges->getBadge({this->userId_}))
-    {
-        this->emplace<BadgeElement>(*badge, MessageElementFlag::BadgeitzAlex);
-    }
-    if (auto badge = getApp()->itzalexBadges->getBadge2({this->userId_}))
-    {
-        this->emplace<BadgeElement>(*badge, MessageElementFlag::BadgeitzAlex);
-    }
-    if (auto badge = getApp()->itzalexBadges->getBadge3({this->userId_}))
-    {
-        this->emplace<BadgeElement>(*badge, MessageElementFlag::BadgeitzAlex);
     }
 }
 
@@ -1258,7 +1149,7 @@ Outcome TwitchMessageBuilder::tryParseCheermote(const QString &string)
 
     int cheerValue = match.captured(1).toInt();
 
-    if (getSettings()->stackBits)
+    if (this->renderSettings_->stackBits)
     {
         if (this->bitsStacked)
         {
@@ -93,10 +93,8 @@ private:
     void addTextOrEmoji(const QString &value) override;
 
     void appendTwitchBadges();
-    void appendChatterinoBadges();
-    void appendSeventvBadges();
-    void appendFfzBadges();
-    void appenditzAlexBadges();
+    // Badges from Chatterino, 7TV, FFZ and Homies
+    void appendThirdPartyBadges();
     Outcome tryParseCheermote(const QString &string);
 
     bool shouldAddModerationElements() const;
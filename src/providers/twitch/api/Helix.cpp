@@ -2,13 +2,48 @@
 
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
+#include "util/Helpers.hpp"
+#include "util/Metrics.hpp"
+#include "util/PostToThread.hpp"
 
 #include <QJsonDocument>
+#include <QRegularExpression>
 
 namespace chatterino {
+namespace {
+
+    using namespace std::chrono_literals;
+
+    // Maximum amount of ids/logins per Get Users request
+    constexpr int USERS_BATCH_SIZE = 100;
+
+    constexpr auto USER_CACHE_TTL = 10min;
+    constexpr auto GAME_CACHE_TTL = 1h;
+    constexpr auto STREAM_CACHE_TTL = 30s;
+
+    // Twitch rejects the whole Get Users request if a single id or login is
+    // malformed, so those never make it into a batch
+    bool isValidUserKey(const QString &key, bool isLogin)
+    {
+        static const QRegularExpression loginRegex("^[a-z0-9_]{1,25}$");
+        static const QRegularExpression idRegex("^[0-9]{1,20}$");
+
+        return (isLogin ? loginRegex : idRegex).match(key).hasMatch();
+    }
+
+}  // namespace
 
 static Helix *instance = nullptr;
 
+Helix::Helix(QString baseUrl)
+    : baseUrl_(std::move(baseUrl))
+    , userByIdCache_("users by id", USER_CACHE_TTL)
+    , userByLoginCache_("users by login", USER_CACHE_TTL)
+    , gameCache_("games", GAME_CACHE_TTL)
+    , streamCache_("streams", STREAM_CACHE_TTL)
+{
+}
+
 void Helix::fetchUsers(QStringList userIds, QStringList userLogins,
                        ResultCallback<std::vector<HelixUser>> successCallback,
                        HelixFailureCallback failureCallback)
@@ -59,41 +94,183 @@ void Helix::getUserByName(QString userName,
                           ResultCallback<HelixUser> successCallback,
                           HelixFailureCallback failureCallback)
 {
-    QStringList userIds;
-    QStringList userLogins{std::move(userName)};
+    auto login = userName.toLower();
 
-    this->fetchUsers(
-        userIds, userLogins,
-        [successCallback,
-         failureCallback](const std::vector<HelixUser> &users) {
-            if (users.empty())
-            {
-                failureCallback();
-                return;
-            }
-            successCallback(users[0]);
-        },
-        failureCallback);
+    if (auto user = this->userByLoginCache_.get(login))
+    {
+        postToThread([successCallback, user = std::move(*user)] {
+            successCallback(user);
+        });
+        return;
+    }
+
+    this->queueUserLookup(
+        login, true,
+        {std::move(successCallback), std::move(failureCallback)});
 }
 
 void Helix::getUserById(QString userId,
                         ResultCallback<HelixUser> successCallback,
                         HelixFailureCallback failureCallback)
 {
-    QStringList userIds{std::move(userId)};
+    if (auto user = this->userByIdCache_.get(userId))
+    {
+        postToThread([successCallback, user = std::move(*user)] {
+            successCallback(user);
+        });
+        return;
+    }
+
+    this->queueUserLookup(
+        userId, false,
+        {std::move(successCallback), std::move(failureCallback)});
+}
+
+void Helix::queueUserLookup(const QString &key, bool isLogin,
+                            UserLookup lookup)
+{
+    if (!isValidUserKey(key, isLogin))
+    {
+        postToThread([failureCallback = std::move(lookup.failureCallback)] {
+            failureCallback();
+        });
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->userLookupMutex_);
+
+        auto &pending =
+            isLogin ? this->pendingUserLogins_ : this->pendingUserIds_;
+
+        auto it = pending.find(key);
+        if (it != pending.end())
+        {
+            // The same user is already queued or in flight
+            it->second.push_back(std::move(lookup));
+            static auto &helixRequestsSaved =
+                Metrics::counter("helix requests saved");
+            helixRequestsSaved.increase();
+            return;
+        }
+
+        pending[key].push_back(std::move(lookup));
+        (isLogin ? this->queuedUserLogins_ : this->queuedUserIds_).append(key);
+
+        if (this->userLookupFlushQueued_)
+        {
+            return;
+        }
+        this->userLookupFlushQueued_ = true;
+    }
+
+    // Give other lookups made in this event loop iteration a chance to join
+    // the same request
+    postToThread([this] {
+        this->flushUserLookups();
+    });
+}
+
+void Helix::flushUserLookups()
+{
+    QStringList userIds;
     QStringList userLogins;
 
+    {
+        std::lock_guard<std::mutex> lock(this->userLookupMutex_);
+
+        userIds.swap(this->queuedUserIds_);
+        userLogins.swap(this->queuedUserLogins_);
+        this->userLookupFlushQueued_ = false;
+    }
+
+    int requests = 0;
+    for (const auto &batch : splitListIntoBatches(userIds, USERS_BATCH_SIZE))
+    {
+        this->sendUserBatch(batch, {});
+        requests++;
+    }
+    for (const auto &batch :
+         splitListIntoBatches(userLogins, USERS_BATCH_SIZE))
+    {
+        this->sendUserBatch({}, batch);
+        requests++;
+    }
+
+    static auto &helixRequestsSaved = Metrics::counter("helix requests saved");
+    helixRequestsSaved.increase(userIds.size() + userLogins.size() - requests);
+}
+
+void Helix::sendUserBatch(const QStringList &userIds,
+                          const QStringList &userLogins)
+{
     this->fetchUsers(
         userIds, userLogins,
-        [successCallback, failureCallback](const auto &users) {
-            if (users.empty())
+        [this, userIds, userLogins](const std::vector<HelixUser> &users) {
+            this->resolveUserLookups(userIds, userLogins, users);
+        },
+        [this, userIds, userLogins] {
+            // Splitting the batch up would only turn e.g. a rate limit or an
+            // expired token into more failing requests
+            this->resolveUserLookups(userIds, userLogins, {});
+        });
+}
+
+void Helix::resolveUserLookups(const QStringList &userIds,
+                               const QStringList &userLogins,
+                               const std::vector<HelixUser> &users)
+{
+    std::unordered_map<QString, const HelixUser *> usersById;
+    std::unordered_map<QString, const HelixUser *> usersByLogin;
+
+    for (const auto &user : users)
+    {
+        this->userByIdCache_.insert(user.id, user);
+        this->userByLoginCache_.insert(user.login, user);
+
+        usersById.emplace(user.id, &user);
+        usersByLogin.emplace(user.login, &user);
+    }
+
+    auto resolve = [this](auto &pending, const auto &found,
+                          const QString &key) {
+        std::vector<UserLookup> lookups;
+        {
+            std::lock_guard<std::mutex> lock(this->userLookupMutex_);
+
+            auto it = pending.find(key);
+            if (it == pending.end())
             {
-                failureCallback();
                 return;
             }
-            successCallback(users[0]);
-        },
-        failureCallback);
+
+            lookups = std::move(it->second);
+            pending.erase(it);
+        }
+
+        auto user = found.find(key);
+        for (const auto &lookup : lookups)
+        {
+            if (user != found.end())
+            {
+                lookup.successCallback(*user->second);
+            }
+            else
+            {
+                lookup.failureCallback();
+            }
+        }
+    };
+
+    for (const auto &id : userIds)
+    {
+        resolve(this->pendingUserIds_, usersById, id);
+    }
+
+    for (const auto &login : userLogins)
+    {
+        resolve(this->pendingUserLogins_, usersByLogin, login);
+    }
 }
 
 void Helix::fetchUsersFollows(
@@ -212,17 +389,28 @@ void Helix::getStreamById(QString userId,
                           ResultCallback<bool, HelixStream> successCallback,
                           HelixFailureCallback failureCallback)
 {
-    QStringList userIds{std::move(userId)};
+    if (auto cached = this->streamCache_.get("id:" + userId))
+    {
+        postToThread([successCallback, cached = std::move(*cached)] {
+            successCallback(cached.first, cached.second);
+        });
+        return;
+    }
+
+    QStringList userIds{userId};
     QStringList userLogins;
 
     this->fetchStreams(
         userIds, userLogins,
-        [successCallback, failureCallback](const auto &streams) {
+        [this, userId, successCallback](const auto &streams) {
             if (streams.empty())
             {
+                this->streamCache_.insert("id:" + userId,
+                                          {false, HelixStream()});
                 successCallback(false, HelixStream());
                 return;
             }
+            this->streamCache_.insert("id:" + userId, {true, streams[0]});
             successCallback(true, streams[0]);
         },
         failureCallback);
@@ -232,17 +420,30 @@ void Helix::getStreamByName(QString userName,
                             ResultCallback<bool, HelixStream> successCallback,
                             HelixFailureCallback failureCallback)
 {
+    auto login = userName.toLower();
+
+    if (auto cached = this->streamCache_.get("login:" + login))
+    {
+        postToThread([successCallback, cached = std::move(*cached)] {
+            successCallback(cached.first, cached.second);
+        });
+        return;
+    }
+
     QStringList userIds;
-    QStringList userLogins{std::move(userName)};
+    QStringList userLogins{login};
 
     this->fetchStreams(
         userIds, userLogins,
-        [successCallback, failureCallback](const auto &streams) {
+        [this, login, successCallback](const auto &streams) {
             if (streams.empty())
             {
+                this->streamCache_.insert("login:" + login,
+                                          {false, HelixStream()});
                 successCallback(false, HelixStream());
                 return;
             }
+            this->streamCache_.insert("login:" + login, {true, streams[0]});
             successCallback(true, streams[0]);
         },
         failureCallback);
@@ -338,20 +539,70 @@ void Helix::getGameById(QString gameId,
                         ResultCallback<HelixGame> successCallback,
                         HelixFailureCallback failureCallback)
 {
-    QStringList gameIds{std::move(gameId)};
+    if (auto game = this->gameCache_.get(gameId))
+    {
+        postToThread([successCallback, game = std::move(*game)] {
+            successCallback(game);
+        });
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->gameLookupMutex_);
+
+        auto &pending = this->pendingGames_[gameId];
+        pending.push_back({std::move(successCallback),
+                           std::move(failureCallback)});
+
+        if (pending.size() > 1)
+        {
+            // The same game is already being looked up
+            static auto &helixRequestsSaved =
+                Metrics::counter("helix requests saved");
+            helixRequestsSaved.increase();
+            return;
+        }
+    }
+
+    auto takeLookups = [this](const QString &id) {
+        std::lock_guard<std::mutex> lock(this->gameLookupMutex_);
+
+        auto lookups = std::move(this->pendingGames_[id]);
+        this->pendingGames_.erase(id);
+
+        return lookups;
+    };
+
+    QStringList gameIds{gameId};
     QStringList gameNames;
 
     this->fetchGames(
         gameIds, gameNames,
-        [successCallback, failureCallback](const auto &games) {
+        [this, gameId, takeLookups](const auto &games) {
+            auto lookups = takeLookups(gameId);
+
             if (games.empty())
             {
-                failureCallback();
+                for (const auto &lookup : lookups)
+                {
+                    lookup.failureCallback();
+                }
                 return;
             }
-            successCallback(games[0]);
+
+            this->gameCache_.insert(gameId, games[0]);
+
+            for (const auto &lookup : lookups)
+            {
+                lookup.successCallback(games[0]);
+            }
         },
-        failureCallback);
+        [gameId, takeLookups] {
+            for (const auto &lookup : takeLookups(gameId))
+            {
+                lookup.failureCallback();
+            }
+        });
 }
 
 void Helix::followUser(QString userId, QString targetId, QString hash,
@@ -871,9 +1122,7 @@ NetworkRequest Helix::makeRequest(QString url, QUrlQuery urlQuery)
         // return boost::none;
     }
 
-    const QString baseUrl("https://api.twitch.tv/helix/");
-
-    QUrl fullUrl(baseUrl + url);
+    QUrl fullUrl(this->baseUrl_ + url);
 
     fullUrl.setQuery(urlQuery);
 
@@ -888,6 +1137,12 @@ void Helix::update(QString clientId, QString oauthToken)
 {
     this->clientId = std::move(clientId);
     this->oauthToken = std::move(oauthToken);
+
+    // Responses may differ between accounts, e.g. for blocked users
+    this->userByIdCache_.clear();
+    this->userByLoginCache_.clear();
+    this->gameCache_.clear();
+    this->streamCache_.clear();
 }
 
 void Helix::initialize()
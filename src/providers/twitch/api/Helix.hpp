@@ -3,6 +3,7 @@
 #include "common/Aliases.hpp"
 #include "common/NetworkRequest.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
+#include "providers/twitch/api/HelixCache.hpp"
 
 #include <QJsonArray>
 #include <QString>
@@ -13,6 +14,8 @@
 #include <boost/optional.hpp>
 
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace chatterino {
@@ -322,10 +325,17 @@ class Helix final : boost::noncopyable
     static constexpr const char *GQLUrl = "https://gql.twitch.tv/gql";
 
 public:
+    // `baseUrl` can point at a local server to test the client
+    explicit Helix(QString baseUrl = "https://api.twitch.tv/helix/");
+
     // https://dev.twitch.tv/docs/api/reference#get-users
     void fetchUsers(QStringList userIds, QStringList userLogins,
                     ResultCallback<std::vector<HelixUser>> successCallback,
                     HelixFailureCallback failureCallback);
+    // getUserByName and getUserById are served from a cache if possible.
+    // Otherwise all lookups made in the same event loop iteration are batched
+    // into as few fetchUsers requests as possible, and concurrent lookups of
+    // the same user share a single request.
     void getUserByName(QString userName,
                        ResultCallback<HelixUser> successCallback,
                        HelixFailureCallback failureCallback);
@@ -454,8 +464,45 @@ private:
     NetworkRequest makeRequestGQL(QString operationName, QString targetID,
                                   QString hash, QString followToken);
 
+    struct UserLookup {
+        ResultCallback<HelixUser> successCallback;
+        HelixFailureCallback failureCallback;
+    };
+
+    struct GameLookup {
+        ResultCallback<HelixGame> successCallback;
+        HelixFailureCallback failureCallback;
+    };
+
+    void queueUserLookup(const QString &key, bool isLogin, UserLookup lookup);
+    void flushUserLookups();
+    // If the batch fails, every lookup in it fails
+    void sendUserBatch(const QStringList &userIds,
+                       const QStringList &userLogins);
+    void resolveUserLookups(const QStringList &userIds,
+                            const QStringList &userLogins,
+                            const std::vector<HelixUser> &users);
+
+    const QString baseUrl_;
     QString clientId;
     QString oauthToken;
+
+    HelixCache<HelixUser> userByIdCache_;
+    HelixCache<HelixUser> userByLoginCache_;
+    HelixCache<HelixGame> gameCache_;
+    HelixCache<std::pair<bool, HelixStream>> streamCache_;
+
+    std::mutex userLookupMutex_;
+    // Lookups that are either queued or in flight, keyed by id/lowercase login
+    std::unordered_map<QString, std::vector<UserLookup>> pendingUserIds_;
+    std::unordered_map<QString, std::vector<UserLookup>> pendingUserLogins_;
+    // Keys that haven't been sent out yet
+    QStringList queuedUserIds_;
+    QStringList queuedUserLogins_;
+    bool userLookupFlushQueued_ = false;
+
+    std::mutex gameLookupMutex_;
+    std::unordered_map<QString, std::vector<GameLookup>> pendingGames_;
 };
 
 Helix *getHelix();
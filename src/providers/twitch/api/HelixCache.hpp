@@ -0,0 +1,105 @@
+#pragma once
+
+#include "util/Metrics.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QString>
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+// Thread-safe cache for Helix responses whose entries expire after a fixed
+// time to live. Hits and misses are counted in Metrics so the hit rate can be
+// read from the debug popup.
+template <typename T>
+class HelixCache
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Expired entries are only removed when they are looked up, so we sweep
+    // the whole cache every this many inserts to keep it from growing forever
+    static constexpr size_t SWEEP_INTERVAL = 256;
+
+    struct Entry {
+        T value;
+        Clock::time_point expiresAt;
+    };
+
+public:
+    HelixCache(const QString &name, std::chrono::seconds ttl)
+        : hits_(Metrics::counter("helix cache hit (" + name + ")"))
+        , misses_(Metrics::counter("helix cache miss (" + name + ")"))
+        , ttl_(ttl)
+    {
+    }
+
+    boost::optional<T> get(const QString &key)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto it = this->entries_.find(key);
+        if (it != this->entries_.end())
+        {
+            if (Clock::now() < it->second.expiresAt)
+            {
+                this->hits_.increase();
+                return it->second.value;
+            }
+
+            this->entries_.erase(it);
+        }
+
+        this->misses_.increase();
+        return boost::none;
+    }
+
+    void insert(const QString &key, T value)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto now = Clock::now();
+
+        this->entries_.insert_or_assign(
+            key, Entry{std::move(value), now + this->ttl_});
+
+        if (++this->insertsSinceSweep_ < SWEEP_INTERVAL)
+        {
+            return;
+        }
+
+        this->insertsSinceSweep_ = 0;
+        for (auto it = this->entries_.begin(); it != this->entries_.end();)
+        {
+            if (it->second.expiresAt <= now)
+            {
+                it = this->entries_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        this->entries_.clear();
+    }
+
+private:
+    Metric &hits_;
+    Metric &misses_;
+    const std::chrono::seconds ttl_;
+
+    std::mutex mutex_;
+    std::unordered_map<QString, Entry> entries_;
+    size_t insertsSinceSweep_ = 0;
+};
+
+}  // namespace chatterino
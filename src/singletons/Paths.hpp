@@ -31,6 +31,9 @@ public:
     // Profile avatars for Twitch <appDataDirectory>/cache/twitch
     QString twitchProfileAvatars;
 
+    // Emote and badge provider snapshots <appDataDirectory>/Snapshots
+    QString snapshotDirectory;
+
     bool createFolder(const QString &folderPath);
     bool isPortable();
 
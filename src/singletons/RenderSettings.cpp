@@ -0,0 +1,118 @@
+#include "singletons/RenderSettings.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+
+namespace chatterino {
+
+namespace {
+
+    // Only used with std::atomic_load/std::atomic_store
+    std::shared_ptr<const RenderSettings> current =
+        std::make_shared<RenderSettings>();
+
+    void rebuild(Settings &settings)
+    {
+        assertInGuiThread();
+
+        auto snapshot = std::make_shared<RenderSettings>();
+        snapshot->version = std::atomic_load(&current)->version + 1;
+
+        snapshot->hideModerated = settings.hideModerated;
+        snapshot->hideModerationActions = settings.hideModerationActions;
+        snapshot->hideSimilar = settings.hideSimilar;
+        snapshot->timestampFormat = settings.timestampFormat.getValue();
+
+        snapshot->showLastMessageIndicator = settings.showLastMessageIndicator;
+        if (!settings.lastMessageColor.getValue().isEmpty())
+        {
+            snapshot->lastMessageColor =
+                QColor(settings.lastMessageColor.getValue());
+        }
+        snapshot->lastMessagePattern = static_cast<Qt::BrushStyle>(
+            settings.lastMessagePattern.getValue());
+        snapshot->separateMessages = settings.separateMessages;
+        snapshot->alternateMessages = settings.alternateMessages;
+        snapshot->grayOutRecents = settings.grayOutRecents;
+        snapshot->enableFirstMessageHighlight =
+            settings.enableFirstMessageHighlight;
+        snapshot->enableSubHighlight = settings.enableSubHighlight;
+        snapshot->enableRedeemedHighlight = settings.enableRedeemedHighlight;
+
+        snapshot->highlightInlineWhispers = settings.highlightInlineWhispers;
+        snapshot->colorUsernames = settings.colorUsernames;
+        snapshot->findAllUsernames = settings.findAllUsernames;
+        snapshot->colorizeNicknames = settings.colorizeNicknames;
+        snapshot->usernameDisplayMode = settings.usernameDisplayMode.getValue();
+        snapshot->enableBTTVGlobalEmotes = settings.enableBTTVGlobalEmotes;
+        snapshot->enableFFZGlobalEmotes = settings.enableFFZGlobalEmotes;
+        snapshot->enable7TVGlobalEmotes = settings.enable7TVGlobalEmotes;
+        snapshot->enableHomiesGlobalEmotes = settings.enableHomiesGlobalEmotes;
+        snapshot->useCustomFfzModeratorBadges =
+            settings.useCustomFfzModeratorBadges;
+        snapshot->useCustomFfzVipBadges = settings.useCustomFfzVipBadges;
+        snapshot->stackBits = settings.stackBits;
+
+        std::atomic_store(&current,
+                          std::shared_ptr<const RenderSettings>(snapshot));
+
+        RenderSettings::changed().invoke();
+    }
+
+    template <typename T>
+    void rebuildOnChange(Settings &settings, T &setting)
+    {
+        setting.connect(
+            [&settings](auto, auto) {
+                rebuild(settings);
+            },
+            false);
+    }
+
+}  // namespace
+
+std::shared_ptr<const RenderSettings> RenderSettings::get()
+{
+    return std::atomic_load(&current);
+}
+
+void RenderSettings::initialize(Settings &settings)
+{
+    rebuildOnChange(settings, settings.hideModerated);
+    rebuildOnChange(settings, settings.hideModerationActions);
+    rebuildOnChange(settings, settings.hideSimilar);
+    rebuildOnChange(settings, settings.timestampFormat);
+
+    rebuildOnChange(settings, settings.showLastMessageIndicator);
+    rebuildOnChange(settings, settings.lastMessageColor);
+    rebuildOnChange(settings, settings.lastMessagePattern);
+    rebuildOnChange(settings, settings.separateMessages);
+    rebuildOnChange(settings, settings.alternateMessages);
+    rebuildOnChange(settings, settings.grayOutRecents);
+    rebuildOnChange(settings, settings.enableFirstMessageHighlight);
+    rebuildOnChange(settings, settings.enableSubHighlight);
+    rebuildOnChange(settings, settings.enableRedeemedHighlight);
+
+    rebuildOnChange(settings, settings.highlightInlineWhispers);
+    rebuildOnChange(settings, settings.colorUsernames);
+    rebuildOnChange(settings, settings.findAllUsernames);
+    rebuildOnChange(settings, settings.colorizeNicknames);
+    rebuildOnChange(settings, settings.usernameDisplayMode);
+    rebuildOnChange(settings, settings.enableBTTVGlobalEmotes);
+    rebuildOnChange(settings, settings.enableFFZGlobalEmotes);
+    rebuildOnChange(settings, settings.enable7TVGlobalEmotes);
+    rebuildOnChange(settings, settings.enableHomiesGlobalEmotes);
+    rebuildOnChange(settings, settings.useCustomFfzModeratorBadges);
+    rebuildOnChange(settings, settings.useCustomFfzVipBadges);
+    rebuildOnChange(settings, settings.stackBits);
+
+    rebuild(settings);
+}
+
+pajlada::Signals::NoArgSignal &RenderSettings::changed()
+{
+    static pajlada::Signals::NoArgSignal signal;
+
+    return signal;
+}
+
+}  // namespace chatterino
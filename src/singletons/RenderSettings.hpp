@@ -0,0 +1,69 @@
+#pragma once
+
+#include "singletons/Settings.hpp"
+
+#include <QColor>
+#include <QString>
+#include <pajlada/signals/signal.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace chatterino {
+
+// Copy of the settings that are read for every message while building, laying
+// out and painting messages.
+//
+// Reading a setting goes through its pajlada setting object every time, which
+// adds up when thousands of messages are laid out. Instead, the snapshot is
+// taken once per build, layout pass or paint and passed down by reference. It
+// is rebuilt on the GUI thread whenever one of the settings changes.
+struct RenderSettings {
+    // Increases with every rebuild. Layouts made with an older version are
+    // redone.
+    uint64_t version = 0;
+
+    // Layout
+    bool hideModerated = false;
+    bool hideModerationActions = false;
+    bool hideSimilar = false;
+    QString timestampFormat = "h:mm";
+
+    // Painting
+    bool showLastMessageIndicator = false;
+    // Invalid if the theme's color should be used
+    QColor lastMessageColor;
+    Qt::BrushStyle lastMessagePattern = Qt::SolidPattern;
+    bool separateMessages = false;
+    bool alternateMessages = false;
+    bool grayOutRecents = true;
+    bool enableFirstMessageHighlight = true;
+    bool enableSubHighlight = true;
+    bool enableRedeemedHighlight = true;
+
+    // Building
+    bool highlightInlineWhispers = false;
+    bool colorUsernames = true;
+    bool findAllUsernames = false;
+    bool colorizeNicknames = true;
+    UsernameDisplayMode usernameDisplayMode =
+        UsernameDisplayMode::UsernameAndLocalizedName;
+    bool enableBTTVGlobalEmotes = true;
+    bool enableFFZGlobalEmotes = true;
+    bool enable7TVGlobalEmotes = true;
+    bool enableHomiesGlobalEmotes = true;
+    bool useCustomFfzModeratorBadges = true;
+    bool useCustomFfzVipBadges = true;
+    bool stackBits = false;
+
+    // Returns the current snapshot. Can be called from any thread.
+    static std::shared_ptr<const RenderSettings> get();
+
+    // Takes the first snapshot and keeps it up to date with `settings`
+    static void initialize(Settings &settings);
+
+    // Invoked on the GUI thread after the snapshot was rebuilt
+    static pajlada::Signals::NoArgSignal &changed();
+};
+
+}  // namespace chatterino
@@ -5,6 +5,7 @@
 #include "controllers/highlights/HighlightPhrase.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "singletons/Paths.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/PersistSignalVector.hpp"
@@ -160,6 +161,8 @@ Settings::Settings(const QString &settingsDirectory)
         },
         false);
 #endif
+
+    RenderSettings::initialize(*this);
 }
 
 Settings &Settings::instance()
@@ -167,6 +167,9 @@ public:
                                           1.0};
     BoolSetting autoCloseUserPopup = {"/behaviour/autoCloseUserPopup", true};
     QStringSetting searchEngine = {"/behaviour/searchEngine", "Google"};
+    // Messages kept per channel, the ones beyond Channel::MESSAGE_LIMIT are
+    // spilled to disk
+    IntSetting scrollbackLimit = {"/behaviour/scrollbackLimit", 1000};
     // BoolSetting twitchSeperateWriteConnection =
     // {"/behaviour/twitchSeperateWriteConnection", false};
 
@@ -402,6 +405,9 @@ public:
         800,
     };
 
+    BoolSetting lazyChannelActivation = {"/misc/lazyChannelActivation",
+                                         false};
+
     IntSetting emotesTooltipPreview = {"/misc/emotesTooltipPreview", 1};
     BoolSetting openLinksIncognito = {"/misc/openLinksIncognito", 0};
 
@@ -258,6 +258,7 @@ void Updates::checkForUpdates()
 
     NetworkRequest(url)
         .timeout(60000)
+        .priority(NetworkRequestPriority::Background)
         .onSuccess([this](auto result) -> Outcome {
             auto object = result.parseJson();
             /// Version available on every platform
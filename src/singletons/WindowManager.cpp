@@ -16,6 +16,7 @@
 #include "common/Args.hpp"
 #include "common/QLogging.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "debug/Benchmark.hpp"
 #include "messages/MessageElement.hpp"
 #include "providers/irc/Irc2.hpp"
 #include "providers/irc/IrcChannel2.hpp"
@@ -23,6 +24,7 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Fonts.hpp"
 #include "singletons/Paths.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 #include "util/Clamp.hpp"
@@ -39,6 +41,9 @@
 namespace chatterino {
 namespace {
 
+    // Time between two deferred channels being activated in the background
+    constexpr int CHANNEL_WARMUP_INTERVAL = 1000;
+
     boost::optional<bool> &shouldMoveOutOfBoundsWindow()
     {
         static boost::optional<bool> x;
@@ -132,6 +137,26 @@ WindowManager::WindowManager()
     QObject::connect(&this->miscUpdateTimer_, &QTimer::timeout, [this] {
         this->miscUpdate.invoke();
     });
+
+    QObject::connect(&this->channelWarmupTimer_, &QTimer::timeout, [this] {
+        while (!this->channelWarmupQueue_.empty())
+        {
+            auto channel = this->channelWarmupQueue_.front().lock();
+            this->channelWarmupQueue_.pop_front();
+
+            // Channels that have been shown in the meantime are already active
+            if (channel && !channel->isActivated())
+            {
+                channel->activate();
+                break;
+            }
+        }
+
+        if (this->channelWarmupQueue_.empty())
+        {
+            this->channelWarmupTimer_.stop();
+        }
+    });
 }
 
 WindowManager::~WindowManager() = default;
@@ -217,6 +242,12 @@ void WindowManager::forceLayoutChannelViews()
     this->layoutChannelViews(nullptr);
 }
 
+void WindowManager::invalidateChannelViewBuffers()
+{
+    this->bufferGeneration_++;
+    this->layoutChannelViews(nullptr);
+}
+
 void WindowManager::repaintVisibleChatWidgets(Channel *channel)
 {
     this->layoutRequested.invoke(channel);
@@ -310,6 +341,8 @@ void WindowManager::initialize(Settings &settings, Paths &paths)
     assert(!this->initialized_);
 
     {
+        BenchmarkGuard benchmark("WindowManager::applyWindowLayout");
+
         WindowLayout windowLayout;
 
         if (getArgs().customChannelLayout)
@@ -326,6 +359,8 @@ void WindowManager::initialize(Settings &settings, Paths &paths)
         this->applyWindowLayout(windowLayout);
     }
 
+    this->startChannelWarmup();
+
     if (getArgs().isFramelessEmbed)
     {
         this->framelessEmbedWindow_.reset(new FramelessEmbedWindow);
@@ -345,7 +380,8 @@ void WindowManager::initialize(Settings &settings, Paths &paths)
         }
     }
 
-    settings.timestampFormat.connect([this](auto, auto) {
+    // Layouts are redone when they see the new RenderSettings version
+    RenderSettings::changed().connect([this] {
         this->layoutChannelViews();
     });
 
@@ -353,21 +389,9 @@ void WindowManager::initialize(Settings &settings, Paths &paths)
         this->forceLayoutChannelViews();
     });
 
-    settings.timestampFormat.connect([this](auto, auto) {
-        this->forceLayoutChannelViews();
-    });
-    settings.alternateMessages.connect([this](auto, auto) {
-        this->forceLayoutChannelViews();
-    });
-    settings.separateMessages.connect([this](auto, auto) {
-        this->forceLayoutChannelViews();
-    });
     settings.collpseMessagesMinLines.connect([this](auto, auto) {
         this->forceLayoutChannelViews();
     });
-    settings.enableRedeemedHighlight.connect([this](auto, auto) {
-        this->forceLayoutChannelViews();
-    });
 
     this->initialized_ = true;
 }
@@ -609,7 +633,10 @@ IndirectChannel WindowManager::decodeChannel(const SplitDescriptor &descriptor)
 
     if (descriptor.type_ == "twitch")
     {
-        return app->twitch.server->getOrAddChannel(descriptor.channelName_);
+        // Channels are only activated once a split showing them becomes
+        // visible, or once the background warm-up reaches them
+        return app->twitch.server->getOrAddChannel(
+            descriptor.channelName_, getSettings()->lazyChannelActivation);
     }
     else if (descriptor.type_ == "mentions")
     {
@@ -656,6 +683,34 @@ void WindowManager::incGeneration()
     this->generation_++;
 }
 
+int WindowManager::getBufferGeneration() const
+{
+    return this->bufferGeneration_;
+}
+
+void WindowManager::startChannelWarmup()
+{
+    for (auto &&weak : getApp()->twitch.server->getChannels())
+    {
+        auto channel = weak.lock();
+        if (channel && !channel->isActivated())
+        {
+            this->channelWarmupQueue_.push_back(weak);
+        }
+    }
+
+    if (this->channelWarmupQueue_.empty())
+    {
+        return;
+    }
+
+    qCDebug(chatterinoWindowmanager)
+        << "Activating" << this->channelWarmupQueue_.size()
+        << "deferred channels in the background";
+
+    this->channelWarmupTimer_.start(CHANNEL_WARMUP_INTERVAL);
+}
+
 WindowLayout WindowManager::loadWindowLayoutFromFile() const
 {
     return WindowLayout::loadFromFile(this->windowLayoutFilePath);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include "common/Channel.hpp"
 #include "common/FlagsEnum.hpp"
@@ -52,6 +53,10 @@ public:
     // This is called, for example, when the emote scale or timestamp format has
     // changed
     void forceLayoutChannelViews();
+    // Force all channel views to repaint their messages without redoing their
+    // layout. This is enough for settings that only change how messages are
+    // painted, e.g. alternating backgrounds
+    void invalidateChannelViewBuffers();
     void repaintVisibleChatWidgets(Channel *channel = nullptr);
     void repaintGifEmotes();
 
@@ -71,6 +76,7 @@ public:
 
     int getGeneration() const;
     void incGeneration();
+    int getBufferGeneration() const;
 
     MessageElementFlags getWordFlags();
     void updateWordTypeMask();
@@ -111,6 +117,10 @@ private:
     // Apply a window layout for this window manager.
     void applyWindowLayout(const WindowLayout &layout);
 
+    // Queue up all channels that were restored without being activated, and
+    // activate them one by one in the background
+    void startChannelWarmup();
+
     // Contains the full path to the window layout file, e.g. /home/pajlada/.local/share/Chatterino/Settings/window-layout.json
     const QString windowLayoutFilePath;
 
@@ -119,6 +129,7 @@ private:
     QPoint emotePopupPos_;
 
     std::atomic<int> generation_{0};
+    std::atomic<int> bufferGeneration_{0};
 
     std::vector<Window *> windows_;
 
@@ -131,6 +142,9 @@ private:
 
     QTimer *saveTimer;
     QTimer miscUpdateTimer_;
+
+    std::deque<std::weak_ptr<Channel>> channelWarmupQueue_;
+    QTimer channelWarmupTimer_;
 };
 
 }  // namespace chatterino
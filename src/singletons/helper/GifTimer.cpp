@@ -4,26 +4,63 @@
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <cmath>
+
 namespace chatterino {
+namespace {
+
+    // Roughly how often animated images are repainted
+    constexpr qreal TARGET_REPAINT_INTERVAL = 30;
+
+    // Rounds the repaint interval to a whole number of display refreshes so
+    // frames are shown for an even amount of time
+    int repaintInterval()
+    {
+        qreal refreshRate = 60;
+        if (auto *screen = QGuiApplication::primaryScreen())
+        {
+            refreshRate = std::max<qreal>(screen->refreshRate(), 1);
+        }
+
+        auto refreshInterval = 1000 / refreshRate;
+        auto refreshes = std::max<qreal>(
+            std::round(TARGET_REPAINT_INTERVAL / refreshInterval), 1);
+
+        return std::max(int(std::round(refreshes * refreshInterval)), 1);
+    }
+
+}  // namespace
 
 void GIFTimer::initialize()
 {
-    this->timer.setInterval(30);
+    this->timer.setTimerType(Qt::PreciseTimer);
+    this->timer.setInterval(repaintInterval());
 
     getSettings()->animateEmotes.connect([this](bool enabled, auto) {
         if (enabled)
+        {
+            this->elapsed_.start();
             this->timer.start();
+        }
         else
+        {
             this->timer.stop();
+        }
     });
 
     QObject::connect(&this->timer, &QTimer::timeout, [this] {
         if (getSettings()->animationsWhenFocused &&
             qApp->activeWindow() == nullptr)
+        {
+            // Pause the clock until a window is focused again
+            this->elapsed_.restart();
             return;
+        }
 
-        this->position_ += gifFrameLength;
-        this->signal.invoke();
+        this->position_ += this->elapsed_.restart();
         getApp()->windows->repaintGifEmotes();
     });
 }
@@ -1,25 +1,28 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QTimer>
-#include <pajlada/signals/signal.hpp>
 
 namespace chatterino {
 
-constexpr long unsigned gifFrameLength = 33;
-
+// Clock that drives all animated images. Images compute the frame to show
+// from position() when they're painted, the timer only asks views that show
+// animated images to repaint.
 class GIFTimer
 {
 public:
     void initialize();
 
-    pajlada::Signals::NoArgSignal signal;
-    long unsigned position()
+    // Milliseconds the animations have been playing for. Doesn't advance
+    // while animations are disabled or paused.
+    long unsigned position() const
     {
         return this->position_;
     }
 
 private:
     QTimer timer;
+    QElapsedTimer elapsed_;
     long unsigned position_{};
 };
 
@@ -81,4 +81,24 @@ QString formatUserMention(const QString &userName, bool isFirstWord,
     return mentionUsersWithAt ? '@' + result : result;
 }
 
+std::vector<QStringList> splitListIntoBatches(const QStringList &list,
+                                              int batchSize)
+{
+    std::vector<QStringList> batches;
+
+    if (batchSize <= 0)
+    {
+        return batches;
+    }
+
+    batches.reserve((list.size() + batchSize - 1) / batchSize);
+
+    for (int i = 0; i < list.size(); i += batchSize)
+    {
+        batches.push_back(list.mid(i, batchSize));
+    }
+
+    return batches;
+}
+
 }  // namespace chatterino
@@ -2,6 +2,9 @@
 
 #include <QColor>
 #include <QString>
+#include <QStringList>
+
+#include <vector>
 
 namespace chatterino {
 
@@ -30,4 +33,12 @@ QColor getRandomColor(const QString &userId);
 QString formatUserMention(const QString &userName, bool isFirstWord,
                           bool mentionUsersWithComma, bool mentionUsersWithAt);
 
+/**
+ * @brief Splits a list into consecutive batches of at most batchSize items
+ *
+ * Used for Helix endpoints that accept a limited amount of ids per request
+ **/
+std::vector<QStringList> splitListIntoBatches(const QStringList &list,
+                                              int batchSize = 100);
+
 }  // namespace chatterino
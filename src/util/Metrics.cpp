@@ -0,0 +1,410 @@
+#include "util/Metrics.hpp"
+
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace chatterino {
+
+namespace {
+
+    struct Registry {
+        std::mutex mutex;
+        std::map<QString, std::unique_ptr<Metric>> metrics;
+        std::map<QString, std::unique_ptr<Histogram>> histograms;
+    };
+
+    Registry &registry()
+    {
+        // Never destroyed, metrics are still changed while static objects
+        // are destroyed on exit
+        static auto *instance = new Registry;
+        return *instance;
+    }
+
+    Metric &getOrCreate(const QString &name, Metric::Type type)
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        auto &metric = reg.metrics[name];
+        if (!metric)
+        {
+            metric = std::make_unique<Metric>(name, type);
+        }
+
+        return *metric;
+    }
+
+    // Threads get consecutive indices, so the first threads never share a
+    // shard
+    size_t threadIndex()
+    {
+        static std::atomic<size_t> nextIndex{0};
+        thread_local const size_t index = nextIndex++;
+
+        return index;
+    }
+
+    // "http request started" -> "chatterino_http_request_started"
+    QByteArray prometheusName(const QString &name)
+    {
+        QByteArray result = "chatterino_";
+        bool lastWasSeparator = true;
+
+        for (auto c : name.toLower().toLatin1())
+        {
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+            {
+                result += c;
+                lastWasSeparator = false;
+            }
+            else if (!lastWasSeparator)
+            {
+                result += '_';
+                lastWasSeparator = true;
+            }
+        }
+
+        if (result.endsWith('_'))
+        {
+            result.chop(1);
+        }
+
+        return result;
+    }
+
+    QString csvField(const QString &value)
+    {
+        if (!value.contains(',') && !value.contains('"'))
+        {
+            return value;
+        }
+
+        return '"' + QString(value).replace('"', "\"\"") + '"';
+    }
+
+    template <typename Func>
+    void forEachMetric(Func &&func)
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        for (const auto &metric : reg.metrics)
+        {
+            func(*metric.second);
+        }
+    }
+
+    template <typename Func>
+    void forEachHistogram(Func &&func)
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        for (const auto &histogram : reg.histograms)
+        {
+            func(*histogram.second);
+        }
+    }
+
+}  // namespace
+
+//
+// Metric
+//
+
+Metric::Metric(const QString &name, Type type)
+    : name_(name)
+    , type_(type)
+{
+}
+
+void Metric::increase(int64_t amount)
+{
+    this->shards_[threadIndex() % shardCount].value.fetch_add(
+        amount, std::memory_order_relaxed);
+}
+
+void Metric::decrease(int64_t amount)
+{
+    this->increase(-amount);
+}
+
+int64_t Metric::value() const
+{
+    int64_t sum = 0;
+
+    for (const auto &shard : this->shards_)
+    {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+
+    return sum;
+}
+
+const QString &Metric::name() const
+{
+    return this->name_;
+}
+
+Metric::Type Metric::type() const
+{
+    return this->type_;
+}
+
+//
+// Histogram
+//
+
+Histogram::Histogram(const QString &name)
+    : name_(name)
+{
+}
+
+void Histogram::record(std::chrono::microseconds duration)
+{
+    auto micros = std::max<int64_t>(0, duration.count());
+
+    size_t bucket = 0;
+    while (bucket < bucketCount - 1 && micros >= bucketBound(bucket))
+    {
+        bucket++;
+    }
+
+    this->buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    this->sumMicroseconds_.fetch_add(uint64_t(micros),
+                                     std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const
+{
+    Snapshot snapshot;
+
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        snapshot.buckets[i] = this->buckets_[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sumMicroseconds =
+        this->sumMicroseconds_.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+const QString &Histogram::name() const
+{
+    return this->name_;
+}
+
+int64_t Histogram::bucketBound(size_t bucket)
+{
+    return int64_t(1) << bucket;
+}
+
+int64_t Histogram::Snapshot::quantileMicroseconds(double q) const
+{
+    auto target = uint64_t(std::ceil(q * double(this->count)));
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        seen += this->buckets[i];
+        if (seen >= target && seen > 0)
+        {
+            return bucketBound(i);
+        }
+    }
+
+    return 0;
+}
+
+//
+// MetricTimer
+//
+
+MetricTimer::MetricTimer(Histogram &histogram)
+    : histogram_(histogram)
+    , start_(std::chrono::steady_clock::now())
+{
+}
+
+MetricTimer::~MetricTimer()
+{
+    this->histogram_.record(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - this->start_));
+}
+
+//
+// Metrics
+//
+
+Metric &Metrics::counter(const QString &name)
+{
+    return getOrCreate(name, Metric::Type::Counter);
+}
+
+Metric &Metrics::gauge(const QString &name)
+{
+    return getOrCreate(name, Metric::Type::Gauge);
+}
+
+Histogram &Metrics::histogram(const QString &name)
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    auto &histogram = reg.histograms[name];
+    if (!histogram)
+    {
+        histogram = std::make_unique<Histogram>(name);
+    }
+
+    return *histogram;
+}
+
+QString Metrics::toText()
+{
+    QString text;
+
+    forEachMetric([&](const Metric &metric) {
+        text += metric.name() + ": " + QString::number(metric.value()) + "\n";
+    });
+
+    forEachHistogram([&](const Histogram &histogram) {
+        auto snapshot = histogram.snapshot();
+        if (snapshot.count == 0)
+        {
+            return;
+        }
+
+        text += QString("%1: %2 times, avg %3µs, p50 < %4µs, p99 < %5µs\n")
+                    .arg(histogram.name())
+                    .arg(snapshot.count)
+                    .arg(snapshot.sumMicroseconds / snapshot.count)
+                    .arg(snapshot.quantileMicroseconds(0.5))
+                    .arg(snapshot.quantileMicroseconds(0.99));
+    });
+
+    return text;
+}
+
+QByteArray Metrics::toJson()
+{
+    QJsonObject metrics;
+    forEachMetric([&](const Metric &metric) {
+        metrics.insert(metric.name(), qint64(metric.value()));
+    });
+
+    QJsonObject histograms;
+    forEachHistogram([&](const Histogram &histogram) {
+        auto snapshot = histogram.snapshot();
+
+        QJsonObject object;
+        object.insert("count", qint64(snapshot.count));
+        object.insert("sum_us", qint64(snapshot.sumMicroseconds));
+        object.insert("p50_us", qint64(snapshot.quantileMicroseconds(0.5)));
+        object.insert("p90_us", qint64(snapshot.quantileMicroseconds(0.9)));
+        object.insert("p99_us", qint64(snapshot.quantileMicroseconds(0.99)));
+
+        histograms.insert(histogram.name(), object);
+    });
+
+    QJsonObject root;
+    root.insert("timestamp", QDateTime::currentMSecsSinceEpoch());
+    root.insert("metrics", metrics);
+    root.insert("histograms", histograms);
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+QByteArray Metrics::toCsv(bool withHeader)
+{
+    auto timestamp = QString::number(QDateTime::currentMSecsSinceEpoch());
+    QString csv;
+
+    if (withHeader)
+    {
+        csv += "timestamp,name,type,value,sum_us,p50_us,p90_us,p99_us\n";
+    }
+
+    forEachMetric([&](const Metric &metric) {
+        csv += QString("%1,%2,%3,%4,,,,\n")
+                   .arg(timestamp, csvField(metric.name()),
+                        metric.type() == Metric::Type::Counter ? "counter"
+                                                               : "gauge")
+                   .arg(metric.value());
+    });
+
+    forEachHistogram([&](const Histogram &histogram) {
+        auto snapshot = histogram.snapshot();
+
+        csv += QString("%1,%2,histogram,%3,%4,%5,%6,%7\n")
+                   .arg(timestamp, csvField(histogram.name()))
+                   .arg(snapshot.count)
+                   .arg(snapshot.sumMicroseconds)
+                   .arg(snapshot.quantileMicroseconds(0.5))
+                   .arg(snapshot.quantileMicroseconds(0.9))
+                   .arg(snapshot.quantileMicroseconds(0.99));
+    });
+
+    return csv.toUtf8();
+}
+
+QByteArray Metrics::toPrometheus()
+{
+    QByteArray text;
+
+    forEachMetric([&](const Metric &metric) {
+        auto name = prometheusName(metric.name());
+        auto isCounter = metric.type() == Metric::Type::Counter;
+        if (isCounter)
+        {
+            name += "_total";
+        }
+
+        text += "# TYPE " + name + (isCounter ? " counter\n" : " gauge\n");
+        text += name + ' ' + QByteArray::number(qint64(metric.value())) + '\n';
+    });
+
+    forEachHistogram([&](const Histogram &histogram) {
+        auto name = prometheusName(histogram.name()) + "_seconds";
+        auto snapshot = histogram.snapshot();
+
+        text += "# TYPE " + name + " histogram\n";
+
+        // Prometheus buckets are cumulative
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < Histogram::bucketCount; i++)
+        {
+            cumulative += snapshot.buckets[i];
+
+            auto bound = i == Histogram::bucketCount - 1
+                             ? QByteArray("+Inf")
+                             : QByteArray::number(
+                                   double(Histogram::bucketBound(i)) / 1e6,
+                                   'g', 6);
+
+            text += name + "_bucket{le=\"" + bound + "\"} " +
+                    QByteArray::number(qulonglong(cumulative)) + '\n';
+        }
+
+        text += name + "_sum " +
+                QByteArray::number(double(snapshot.sumMicroseconds) / 1e6,
+                                   'g', 12) +
+                '\n';
+        text += name + "_count " +
+                QByteArray::number(qulonglong(snapshot.count)) + '\n';
+    });
+
+    return text;
+}
+
+}  // namespace chatterino
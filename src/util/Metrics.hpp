@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace chatterino {
+
+// A counter or gauge that can be changed from any thread without locking.
+//
+// Get metrics from Metrics once and keep the reference around, e.g. in a
+// static local:
+//   static auto &images = Metrics::gauge("images");
+//   images.increase();
+class Metric : boost::noncopyable
+{
+public:
+    enum class Type {
+        // Only ever increases, e.g. the number of requests that were made
+        Counter,
+        // Goes up and down, e.g. the number of images in memory
+        Gauge,
+    };
+
+    Metric(const QString &name, Type type);
+
+    void increase(int64_t amount = 1);
+    void decrease(int64_t amount = 1);
+
+    int64_t value() const;
+    const QString &name() const;
+    Type type() const;
+
+private:
+    // Every thread writes to one of the shards, so threads don't fight over
+    // the same cache line
+    static constexpr size_t shardCount = 16;
+
+    struct alignas(64) Shard {
+        std::atomic<int64_t> value{0};
+    };
+
+    const QString name_;
+    const Type type_;
+    std::array<Shard, shardCount> shards_;
+};
+
+// Distribution of durations in buckets that double in size, from 1µs to ~8s.
+class Histogram : boost::noncopyable
+{
+public:
+    static constexpr size_t bucketCount = 25;
+
+    struct Snapshot {
+        std::array<uint64_t, bucketCount> buckets{};
+        uint64_t count = 0;
+        uint64_t sumMicroseconds = 0;
+
+        // Upper bound of the bucket that contains the quantile `q` (0 to 1)
+        int64_t quantileMicroseconds(double q) const;
+    };
+
+    explicit Histogram(const QString &name);
+
+    void record(std::chrono::microseconds duration);
+    Snapshot snapshot() const;
+    const QString &name() const;
+
+    // Durations in bucket i are below bucketBound(i) microseconds. The last
+    // bucket has everything that's slower.
+    static int64_t bucketBound(size_t bucket);
+
+private:
+    const QString name_;
+    std::array<std::atomic<uint64_t>, bucketCount> buckets_{};
+    std::atomic<uint64_t> sumMicroseconds_{0};
+};
+
+// Records the time between construction and destruction into a histogram
+class MetricTimer : boost::noncopyable
+{
+public:
+    explicit MetricTimer(Histogram &histogram);
+    ~MetricTimer();
+
+private:
+    Histogram &histogram_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+// Registry of all metrics. Looking a metric up takes a lock, changing it
+// doesn't.
+class Metrics
+{
+public:
+    // Registers the metric the first time it's requested. The reference stays
+    // valid until the program exits.
+    static Metric &counter(const QString &name);
+    static Metric &gauge(const QString &name);
+    static Histogram &histogram(const QString &name);
+
+    // Human readable, for the debug popup
+    static QString toText();
+
+    static QByteArray toJson();
+    // One row per metric, histograms get their count, average and quantiles
+    static QByteArray toCsv(bool withHeader);
+    // Prometheus text exposition format
+    static QByteArray toPrometheus();
+};
+
+}  // namespace chatterino
@@ -0,0 +1,155 @@
+#include "util/MetricsExporter.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/Metrics.hpp"
+
+#include <QFile>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+namespace chatterino {
+
+namespace {
+
+    // Requests are tiny, anything bigger isn't meant for us
+    constexpr int maxRequestSize = 8 * 1024;
+
+    QByteArray makeResponse(const QByteArray &status,
+                            const QByteArray &contentType,
+                            const QByteArray &body)
+    {
+        QByteArray response;
+        response += "HTTP/1.1 " + status + "\r\n";
+        response += "Content-Type: " + contentType + "\r\n";
+        response +=
+            "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+        response += "Connection: close\r\n";
+        response += "\r\n";
+        response += body;
+
+        return response;
+    }
+
+}  // namespace
+
+MetricsExporter::MetricsExporter(const QString &dumpPath, uint16_t port,
+                                 std::chrono::milliseconds dumpInterval,
+                                 QObject *parent)
+    : QObject(parent)
+    , dumpPath_(dumpPath)
+{
+    if (!this->dumpPath_.isEmpty())
+    {
+        QObject::connect(&this->dumpTimer_, &QTimer::timeout, this, [this] {
+            this->dump();
+        });
+        this->dumpTimer_.start(dumpInterval);
+
+        qCDebug(chatterinoBenchmark)
+            << "Writing metrics to" << this->dumpPath_;
+    }
+
+    if (port != 0)
+    {
+        this->server_ = new QTcpServer(this);
+
+        QObject::connect(this->server_, &QTcpServer::newConnection, this,
+                         [this] {
+                             while (auto *socket =
+                                        this->server_->nextPendingConnection())
+                             {
+                                 this->handleConnection(socket);
+                             }
+                         });
+
+        // Only reachable from this machine
+        if (this->server_->listen(QHostAddress::LocalHost, port))
+        {
+            qCDebug(chatterinoBenchmark)
+                << "Serving metrics on port" << this->server_->serverPort();
+        }
+        else
+        {
+            qCWarning(chatterinoBenchmark)
+                << "Unable to serve metrics on port" << port << ":"
+                << this->server_->errorString();
+        }
+    }
+}
+
+void MetricsExporter::dump()
+{
+    QFile file(this->dumpPath_);
+    auto isCsv = this->dumpPath_.endsWith(".csv", Qt::CaseInsensitive);
+    auto isNew = !file.exists() || file.size() == 0;
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        qCWarning(chatterinoBenchmark)
+            << "Unable to write metrics to" << this->dumpPath_ << ":"
+            << file.errorString();
+
+        // Don't spam the log every interval
+        this->dumpTimer_.stop();
+        return;
+    }
+
+    if (isCsv)
+    {
+        file.write(Metrics::toCsv(isNew));
+    }
+    else
+    {
+        file.write(Metrics::toJson() + '\n');
+    }
+}
+
+void MetricsExporter::handleConnection(QTcpSocket *socket)
+{
+    QObject::connect(socket, &QTcpSocket::disconnected, socket,
+                     &QObject::deleteLater);
+
+    QObject::connect(socket, &QTcpSocket::readyRead, socket, [socket] {
+        // Wait for the whole request head
+        auto request = socket->peek(maxRequestSize);
+        if (!request.contains("\r\n\r\n"))
+        {
+            if (request.size() >= maxRequestSize)
+            {
+                socket->abort();
+            }
+            return;
+        }
+
+        auto requestLine = request.left(request.indexOf("\r\n")).split(' ');
+        auto path = requestLine.value(1);
+
+        if (requestLine.value(0) != "GET")
+        {
+            socket->write(makeResponse("405 Method Not Allowed", "text/plain",
+                                       "Only GET is supported\n"));
+        }
+        else if (path == "/metrics" || path == "/")
+        {
+            socket->write(makeResponse("200 OK",
+                                       "text/plain; version=0.0.4",
+                                       Metrics::toPrometheus()));
+        }
+        else if (path == "/metrics.json")
+        {
+            socket->write(makeResponse("200 OK", "application/json",
+                                       Metrics::toJson()));
+        }
+        else
+        {
+            socket->write(
+                makeResponse("404 Not Found", "text/plain", "Not found\n"));
+        }
+
+        socket->readAll();
+        socket->disconnectFromHost();
+    });
+}
+
+}  // namespace chatterino
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <cstdint>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace chatterino {
+
+// Makes the metrics available outside of the application, so they can be
+// graphed e.g. during raids.
+//
+// If `dumpPath` isn't empty, a snapshot of all metrics is appended to it
+// every `dumpInterval`. Paths ending in .csv get CSV rows, anything else gets
+// one JSON object per line.
+//
+// If `port` isn't 0, the metrics are served in the Prometheus text format on
+// http://127.0.0.1:<port>/metrics.
+//
+// Both are configured through Env, see Env::metricsDumpPath and
+// Env::metricsPort.
+class MetricsExporter : public QObject
+{
+public:
+    MetricsExporter(const QString &dumpPath, uint16_t port,
+                    std::chrono::milliseconds dumpInterval, QObject *parent);
+
+private:
+    void dump();
+    void handleConnection(QTcpSocket *socket);
+
+    const QString dumpPath_;
+    QTimer dumpTimer_;
+    QTcpServer *server_ = nullptr;
+};
+
+}  // namespace chatterino
@@ -4,7 +4,7 @@
 #include "ForwardDecl.hpp"
 #include "common/QLogging.hpp"
 #include "singletons/Settings.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 #include "widgets/splits/Split.hpp"
 
 #include <QTimer>
@@ -56,7 +56,8 @@ AttachedWindow::AttachedWindow(void *_target, int _yOffset)
     split->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::MinimumExpanding);
     layout->addWidget(split);
 
-    DebugCount::increase("attached window");
+    static auto &attachedWindow = Metrics::gauge("attached window");
+    attachedWindow.increase();
 }
 
 AttachedWindow::~AttachedWindow()
@@ -70,7 +71,8 @@ AttachedWindow::~AttachedWindow()
         }
     }
 
-    DebugCount::decrease("attached window");
+    static auto &attachedWindow = Metrics::gauge("attached window");
+    attachedWindow.decrease();
 }
 
 AttachedWindow *AttachedWindow::get(void *target, const GetArgs &args)
@@ -3,7 +3,7 @@
 #include "BaseSettings.hpp"
 #include "BaseTheme.hpp"
 #include "boost/algorithm/algorithm.hpp"
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 #include "util/PostToThread.hpp"
 #include "util/WindowsHelper.hpp"
 #include "widgets/Label.hpp"
@@ -92,12 +92,14 @@ BaseWindow::BaseWindow(FlagsEnum<Flags> _flags, QWidget *parent)
 #endif
 
     this->themeChangedEvent();
-    DebugCount::increase("BaseWindow");
+    static auto &baseWindow = Metrics::gauge("BaseWindow");
+    baseWindow.increase();
 }
 
 BaseWindow::~BaseWindow()
 {
-    DebugCount::decrease("BaseWindow");
+    static auto &baseWindow = Metrics::gauge("BaseWindow");
+    baseWindow.decrease();
 }
 
 void BaseWindow::setInitialBounds(const QRect &bounds)
@@ -1,6 +1,7 @@
 #include "widgets/Scrollbar.hpp"
 
 #include "Application.hpp"
+#include "common/Channel.hpp"
 #include "common/QLogging.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
@@ -21,6 +22,7 @@ namespace chatterino {
 Scrollbar::Scrollbar(ChannelView *parent)
     : BaseWidget(parent)
     , currentValueAnimation_(this, "currentValue_")
+    , highlights_(Channel::MESSAGE_LIMIT, Channel::MAX_MESSAGE_LIMIT)
 {
     resize(int(16 * this->scale()), 100);
     this->currentValueAnimation_.setDuration(150);
@@ -32,8 +34,7 @@ Scrollbar::Scrollbar(ChannelView *parent)
 
 void Scrollbar::addHighlight(ScrollbarHighlight highlight)
 {
-    ScrollbarHighlight deleted;
-    this->highlights_.pushBack(highlight, deleted);
+    this->highlights_.pushBack(highlight);
 }
 
 void Scrollbar::addHighlightsAtStart(
@@ -44,17 +45,7 @@ void Scrollbar::addHighlightsAtStart(
 
 void Scrollbar::replaceHighlight(size_t index, ScrollbarHighlight replacement)
 {
-    this->highlights_.replaceItem(index, replacement);
-}
-
-void Scrollbar::pauseHighlights()
-{
-    this->highlightsPaused_ = true;
-}
-
-void Scrollbar::unpauseHighlights()
-{
-    this->highlightsPaused_ = false;
+    this->highlights_.replace(index, replacement);
 }
 
 void Scrollbar::clearHighlights()
@@ -62,16 +53,6 @@ void Scrollbar::clearHighlights()
     this->highlights_.clear();
 }
 
-LimitedQueueSnapshot<ScrollbarHighlight> Scrollbar::getHighlightSnapshot()
-{
-    if (!this->highlightsPaused_)
-    {
-        this->highlightSnapshot_ = this->highlights_.getSnapshot();
-    }
-
-    return this->highlightSnapshot_;
-}
-
 void Scrollbar::scrollToBottom(bool animate)
 {
     this->setDesiredValue(this->maximum_ - this->getLargeChange(), animate);
@@ -274,65 +255,67 @@ void Scrollbar::paintEvent(QPaintEvent *)
         painter.fillRect(this->thumbRect_, this->theme->scrollbars.thumb);
     }
 
-    // draw highlights
-    auto snapshot = this->getHighlightSnapshot();
-    size_t snapshotLength = snapshot.size();
+    // draw highlights, one bucket of messages at a time
+    size_t highlightCount = this->highlights_.size();
 
-    if (snapshotLength == 0)
+    if (highlightCount == 0)
     {
         return;
     }
 
     int w = this->width();
-    float y = 0;
-    float dY = float(this->height()) / float(snapshotLength);
-    int highlightHeight =
+    float dY = float(this->height()) / float(highlightCount);
+    int minHighlightHeight =
         int(std::ceil(std::max<float>(this->scale() * 2, dY)));
 
-    for (size_t i = 0; i < snapshotLength; i++, y += dY)
-    {
-        ScrollbarHighlight const &highlight = snapshot[i];
+    this->highlights_.forEachBucket([&](size_t start, size_t /*end*/,
+                                        const auto &bucket) {
+        int y = int(float(start) * dY);
 
-        if (highlight.isNull())
+        for (const auto &entry : bucket)
         {
-            continue;
-        }
+            const auto &highlight = entry.highlight;
+            int highlightHeight = std::max(
+                minHighlightHeight, int(std::ceil(float(entry.count) * dY)));
 
-        if (highlight.isRedeemedHighlight() && !enableRedeemedHighlights)
-        {
-            continue;
-        }
-
-        if (highlight.isFirstMessageHighlight() &&
-            !enableFirstMessageHighlights)
-        {
-            continue;
-        }
-
-        QColor color = highlight.getColor();
-        color.setAlpha(255);
-
-        switch (highlight.getStyle())
-        {
-            case ScrollbarHighlight::Default: {
-                painter.fillRect(w / 8 * 3, int(y), w / 4, highlightHeight,
-                                 color);
+            if (highlight.isRedeemedHighlight() && !enableRedeemedHighlights)
+            {
+                continue;
             }
-            break;
 
-            case ScrollbarHighlight::Line: {
-                painter.fillRect(0, int(y), w, 1, color);
+            if (highlight.isFirstMessageHighlight() &&
+                !enableFirstMessageHighlights)
+            {
+                continue;
             }
-            break;
 
-            case ScrollbarHighlight::None:;
+            QColor color = highlight.getColor();
+            color.setAlpha(255);
+
+            switch (highlight.getStyle())
+            {
+                case ScrollbarHighlight::Default: {
+                    painter.fillRect(w / 8 * 3, y, w / 4, highlightHeight,
+                                     color);
+                }
+                break;
+
+                case ScrollbarHighlight::Line: {
+                    painter.fillRect(0, y, w, 1, color);
+                }
+                break;
+
+                case ScrollbarHighlight::None:;
+            }
         }
-    }
+    });
 }
 
 void Scrollbar::resizeEvent(QResizeEvent *)
 {
     this->resize(int(16 * this->scale()), this->height());
+
+    this->highlights_.setRowCount(this->height());
 }
 
 void Scrollbar::mouseMoveEvent(QMouseEvent *event)
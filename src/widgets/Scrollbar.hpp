@@ -1,8 +1,8 @@
 #pragma once
 
-#include "messages/LimitedQueue.hpp"
 #include "widgets/BaseWidget.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
+#include "widgets/helper/ScrollbarMinimap.hpp"
 
 #include <QMutex>
 #include <QPropertyAnimation>
@@ -25,8 +25,6 @@ public:
         const std::vector<ScrollbarHighlight> &highlights_);
     void replaceHighlight(size_t index, ScrollbarHighlight replacement);
 
-    void pauseHighlights();
-    void unpauseHighlights();
     void clearHighlights();
 
     void scrollToBottom(bool animate = false);
@@ -67,16 +65,13 @@ protected:
 private:
     Q_PROPERTY(qreal currentValue_ READ getCurrentValue WRITE setCurrentValue)
 
-    LimitedQueueSnapshot<ScrollbarHighlight> getHighlightSnapshot();
     void updateScroll();
 
     QMutex mutex_;
 
     QPropertyAnimation currentValueAnimation_;
 
-    LimitedQueue<ScrollbarHighlight> highlights_;
-    bool highlightsPaused_{false};
-    LimitedQueueSnapshot<ScrollbarHighlight> highlightSnapshot_;
+    ScrollbarMinimap highlights_;
 
     bool atBottom_{false};
 
@@ -86,20 +86,18 @@ namespace {
 
     ChannelPtr filterMessages(const QString &userName, ChannelPtr channel)
     {
-        LimitedQueueSnapshot<MessagePtr> snapshot =
-            channel->getMessageSnapshot();
-
         ChannelPtr channelPtr(
             new Channel(channel->getName(), Channel::Type::None));
 
-        for (size_t i = 0; i < snapshot.size(); i++)
+        std::vector<MessagePtr> messages;
+        for (auto &&message : channel->findMessagesByUser(userName))
         {
-            MessagePtr message = snapshot[i];
             if (checkMessageUserName(userName, message))
             {
-                channelPtr->addMessage(message);
+                messages.push_back(message);
             }
         }
+        channelPtr->addMessagesAtEnd(messages);
 
         return channelPtr;
     };
@@ -696,6 +694,33 @@ void UserInfoPopup::updateLatestMessages()
                     this->updateLatestMessages();
                 }
             }));
+
+    this->refreshBatchConnection_ =
+        std::make_unique<pajlada::Signals::ScopedConnection>(
+            this->channel_->messagesAddedAtEnd.connect(
+                [this, hasMessages](auto &messages) {
+                    std::vector<MessagePtr> filtered;
+                    for (auto &&message : messages)
+                    {
+                        if (checkMessageUserName(this->userName_, message))
+                        {
+                            filtered.push_back(message);
+                        }
+                    }
+
+                    if (filtered.empty())
+                        return;
+
+                    if (hasMessages)
+                    {
+                        this->ui_.latestMessages->channel()->addMessagesAtEnd(
+                            filtered);
+                    }
+                    else
+                    {
+                        this->updateLatestMessages();
+                    }
+                }));
 }
 
 void UserInfoPopup::updateUserData()
@@ -44,6 +44,8 @@ private:
     pajlada::Signals::NoArgSignal userStateChanged_;
 
     std::unique_ptr<pajlada::Signals::ScopedConnection> refreshConnection_;
+    std::unique_ptr<pajlada::Signals::ScopedConnection>
+        refreshBatchConnection_;
 
     std::shared_ptr<bool> hack_;
 
@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "Application.hpp"
+#include "common/Channel.hpp"
 #include "common/Common.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
@@ -33,6 +34,8 @@
 #include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/RenderSettings.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
@@ -42,6 +45,7 @@
 #include "util/DistanceBetweenPoints.hpp"
 #include "util/Helpers.hpp"
 #include "util/IncognitoBrowser.hpp"
+#include "util/Metrics.hpp"
 #include "util/StreamerMode.hpp"
 #include "util/Twitch.hpp"
 #include "widgets/Scrollbar.hpp"
@@ -60,6 +64,9 @@
 
 namespace chatterino {
 namespace {
+    // Spilled messages rebuilt at once when scrolling to the top
+    constexpr size_t SPILLED_MESSAGES_PAGE_SIZE = 200;
+
     void addEmoteContextMenuItems(const Emote &emote,
                                   MessageElementFlags creatorFlags, QMenu &menu)
     {
@@ -160,6 +167,7 @@ namespace {
 ChannelView::ChannelView(BaseWidget *parent)
     : BaseWidget(parent)
     , scrollBar_(new Scrollbar(this))
+    , messages_(Channel::MESSAGE_LIMIT, Channel::MAX_MESSAGE_LIMIT)
 {
     this->setMouseTracking(true);
 
@@ -217,6 +225,31 @@ void ChannelView::initializeScrollbar()
     this->scrollBar_->getCurrentValueChanged().connect([this] {
         this->performLayout(true);
         this->queueUpdate();
+        this->loadSpilledMessagesAtTop();
+    });
+}
+
+void ChannelView::loadSpilledMessagesAtTop()
+{
+    if (this->loadSpilledMessagesQueued_ || !this->underlyingChannel_ ||
+        !this->scrollBar_->isVisible() ||
+        this->scrollBar_->getCurrentValue() > 0 ||
+        !this->underlyingChannel_->hasSpilledMessages())
+    {
+        return;
+    }
+
+    // Not while the scrollbar is still being updated
+    this->loadSpilledMessagesQueued_ = true;
+    QTimer::singleShot(0, this, [this] {
+        this->loadSpilledMessagesQueued_ = false;
+
+        if (this->underlyingChannel_ &&
+            this->scrollBar_->getCurrentValue() <= 0)
+        {
+            this->underlyingChannel_->loadSpilledMessages(
+                SPILLED_MESSAGES_PAGE_SIZE);
+        }
     });
 }
 
@@ -228,21 +261,19 @@ void ChannelView::initializeSignals()
                                            this->update();
                                        });
 
-    getSettings()->showLastMessageIndicator.connect(
-        [this](auto, auto) {
-            this->update();
-        },
-        this);
-
     this->signalHolder_.managedConnect(getApp()->windows->gifRepaintRequested,
                                        [&] {
-                                           this->queueUpdate();
+                                           if (this->animatedElementsOnScreen_)
+                                           {
+                                               this->queueUpdate();
+                                           }
                                        });
 
     this->signalHolder_.managedConnect(
         getApp()->windows->layoutRequested, [&](Channel *channel) {
             if (this->isVisible() &&
-                (channel == nullptr || this->channel_.get() == channel))
+                (channel == nullptr || this->channel_.get() == channel ||
+                 this->underlyingChannel_.get() == channel))
             {
                 this->queueLayout();
             }
@@ -386,6 +417,9 @@ void ChannelView::scaleChangedEvent(float scale)
 #endif
         this->goToBottom_->getLabel().setFont(
             getFonts()->getFont(FontStyle::UiMedium, factor));
+
+        // The heights of all messages change with the scale
+        this->queueLayout();
     }
 }
 
@@ -418,6 +452,12 @@ void ChannelView::performLayout(bool causedByScrollbar)
 {
     // BenchmarkGuard benchmark("layout");
 
+    // Nobody can see the layout, it's done once we're shown again
+    if (this->suspension_.isSuspended())
+    {
+        return;
+    }
+
     /// Get messages and check if there are at least 1
     auto messages = this->getMessagesSnapshot();
 
@@ -441,8 +481,11 @@ void ChannelView::layoutVisibleMessages(
     const auto start = size_t(this->scrollBar_->getCurrentValue());
     const auto layoutWidth = this->getLayoutWidth();
     const auto flags = this->getFlags();
+    const auto settings = RenderSettings::get();
     auto redrawRequired = false;
 
+    this->reestimateHeights(layoutWidth);
+
     if (messages.size() > start)
     {
         auto y = int(-(messages[start]->getHeight() *
@@ -453,7 +496,9 @@ void ChannelView::layoutVisibleMessages(
             auto message = messages[i];
 
             redrawRequired |=
-                message->layout(layoutWidth, this->scale(), flags);
+                message->layout(layoutWidth, this->scale(), flags, *settings);
+            this->heights_.set(this->snapshotFirstSequence_ + int64_t(i),
+                               message->getHeight());
 
             y += message->getHeight();
         }
@@ -472,32 +517,44 @@ void ChannelView::updateScrollbar(
         return;
     }
 
-    /// Layout the messages at the bottom
-    auto h = this->height() - 8;
-    auto flags = this->getFlags();
-    auto layoutWidth = this->getLayoutWidth();
-    auto showScrollbar = false;
+    auto viewHeight = std::max(1, this->height() - 8);
+    auto first = this->snapshotFirstSequence_;
+    auto end = first + int64_t(messages.size());
 
-    // convert i to int since it checks >= 0
-    for (auto i = int(messages.size()) - 1; i >= 0; i--)
+    /// Layout the messages at the bottom, they are only visible when showing
+    /// the latest messages. Otherwise the heights we know are good enough.
+    if (this->showingLatestMessages_)
     {
-        auto *message = messages[i].get();
-
-        message->layout(layoutWidth, this->scale(), flags);
+        auto h = viewHeight;
+        auto flags = this->getFlags();
+        auto layoutWidth = this->getLayoutWidth();
+        auto settings = RenderSettings::get();
 
-        h -= message->getHeight();
-
-        if (h < 0)  // break condition
+        // convert i to int since it checks >= 0
+        for (auto i = int(messages.size()) - 1; i >= 0 && h >= 0; i--)
         {
-            this->scrollBar_->setLargeChange(
-                (messages.size() - i) +
-                qreal(h) / std::max<int>(1, message->getHeight()));
+            auto *message = messages[i].get();
 
-            showScrollbar = true;
-            break;
+            message->layout(layoutWidth, this->scale(), flags, *settings);
+            this->heights_.set(first + i, message->getHeight());
+
+            h -= message->getHeight();
         }
     }
 
+    auto totalHeight = this->heights_.heightBetween(first, end);
+    auto showScrollbar = totalHeight > viewHeight;
+
+    if (showScrollbar)
+    {
+        // The view shows the last viewHeight pixels at the bottom
+        auto top = this->heights_.find(first, totalHeight - viewHeight);
+        auto topHeight = std::max(1, this->heights_.get(top.sequence));
+
+        this->scrollBar_->setLargeChange(qreal(end - top.sequence) -
+                                         qreal(top.offset) / topHeight);
+    }
+
     /// Update scrollbar values
     this->scrollBar_->setVisible(showScrollbar);
 
@@ -525,6 +582,10 @@ void ChannelView::clearMessages()
     // Clear all stored messages in this chat widget
     this->messages_.clear();
     this->scrollBar_->clearHighlights();
+    this->suspension_.clearMissed();
+    this->heights_.clear();
+    this->firstSequence_ = 0;
+    this->snapshotFirstSequence_ = 0;
     this->queueLayout();
 
     this->lastMessageHasAlternateBackground_ = false;
@@ -604,6 +665,11 @@ LimitedQueueSnapshot<MessageLayoutPtr> ChannelView::getMessagesSnapshot()
     if (!this->paused() /*|| this->scrollBar_->isVisible()*/)
     {
         this->snapshot_ = this->messages_.getSnapshot();
+        this->snapshotFirstSequence_ = this->firstSequence_;
+
+        // Heights of messages that were removed while we were paused aren't
+        // needed anymore
+        this->heights_.trimFront(this->firstSequence_);
     }
 
     return this->snapshot_;
@@ -680,6 +746,18 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
                 this->channel_->addMessagesAtStart(filtered);
         });
 
+    this->channelConnections_.managedConnect(
+        underlyingChannel->messagesAddedAtEnd,
+        [this](std::vector<MessagePtr> &messages) {
+            std::vector<MessagePtr> filtered;
+            std::copy_if(messages.begin(), messages.end(),
+                         std::back_inserter(filtered), [this](MessagePtr msg) {
+                             return this->shouldIncludeMessage(msg);
+                         });
+
+            this->channel_->addMessagesAtEnd(filtered);
+        });
+
     this->channelConnections_.managedConnect(
         underlyingChannel->messageReplaced,
         [this](size_t index, MessagePtr replacement) {
@@ -705,6 +783,12 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
             this->messageAddedAtStart(messages);
         });
 
+    this->channelConnections_.managedConnect(
+        this->channel_->messagesAddedAtEnd,
+        [this](std::vector<MessagePtr> &messages) {
+            this->messagesAddedAtEnd(messages);
+        });
+
     // on message removed
     this->channelConnections_.managedConnect(
         this->channel_->messageRemovedFromStart, [this](MessagePtr &message) {
@@ -719,6 +803,12 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
         });
 
     auto snapshot = underlyingChannel->getMessageSnapshot();
+    auto estimatedHeight = this->estimateMessageHeight();
+
+    // The channel might be scrolled back into its spilled messages, the
+    // highlights are added at the start so the minimap grows as well
+    this->messages_.grow(snapshot.size());
+    std::vector<ScrollbarHighlight> highlights;
 
     for (size_t i = 0; i < snapshot.size(); i++)
     {
@@ -738,16 +828,31 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
             messageLayout->flags.set(MessageLayoutFlag::IgnoreHighlights);
         }
 
-        this->messages_.pushBack(MessageLayoutPtr(messageLayout), deleted);
+        if (this->messages_.pushBack(MessageLayoutPtr(messageLayout), deleted))
+        {
+            this->firstSequence_++;
+        }
+        this->heights_.pushBack(estimatedHeight);
+
         if (this->showScrollbarHighlights())
         {
-            this->scrollBar_->addHighlight(
-                snapshot[i]->getScrollBarHighlight());
+            highlights.push_back(snapshot[i]->getScrollBarHighlight());
         }
     }
 
+    if (!highlights.empty())
+    {
+        this->scrollBar_->addHighlightsAtStart(highlights);
+    }
+
     this->underlyingChannel_ = underlyingChannel;
 
+    // Channels restored into hidden tabs get activated once they are shown
+    if (this->isVisible())
+    {
+        this->underlyingChannel_->activate();
+    }
+
     this->queueLayout();
     this->queueUpdate();
 
@@ -822,6 +927,13 @@ void ChannelView::messageAppended(MessagePtr &message,
         messageFlags = overridingFlags.get_ptr();
     }
 
+    this->requestTabHighlight(*messageFlags);
+
+    if (this->suspension_.miss(1))
+    {
+        return;
+    }
+
     auto messageRef = new MessageLayout(message);
 
     if (this->lastMessageHasAlternateBackground_)
@@ -847,36 +959,32 @@ void ChannelView::messageAppended(MessagePtr &message,
         loop.exec();
     }
 
+    int removed = 0;
     if (this->messages_.pushBack(MessageLayoutPtr(messageRef), deleted))
     {
+        removed++;
+    }
+    if (this->messages_.shrink(deleted))
+    {
+        removed++;
+    }
+    this->heights_.pushBack(this->estimateMessageHeight());
+
+    if (removed > 0)
+    {
+        this->firstSequence_ += removed;
+
         if (this->paused())
         {
             if (!this->scrollBar_->isAtBottom())
-                this->pauseScrollOffset_--;
+                this->pauseScrollOffset_ -= removed;
         }
         else
         {
             if (this->scrollBar_->isAtBottom())
                 this->scrollBar_->scrollToBottom();
             else
-                this->scrollBar_->offset(-1);
-        }
-    }
-
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
-    {
-        if (messageFlags->has(MessageFlag::Highlighted) &&
-            messageFlags->has(MessageFlag::ShowInMentions) &&
-            !messageFlags->has(MessageFlag::Subscription) &&
-            (getSettings()->highlightMentions ||
-             this->channel_->getType() != Channel::Type::TwitchMentions))
-
-        {
-            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
-        }
-        else
-        {
-            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+                this->scrollBar_->offset(-removed);
         }
     }
 
@@ -910,7 +1018,17 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
     }
 
     /// Add the messages at the start
-    if (this->messages_.pushFront(messageRefs).size() > 0)
+    this->messages_.grow(messageRefs.size());
+    auto accepted = this->messages_.pushFront(messageRefs);
+
+    auto estimatedHeight = this->estimateMessageHeight();
+    for (size_t i = 0; i < accepted.size(); i++)
+    {
+        this->heights_.pushFront(estimatedHeight);
+    }
+    this->firstSequence_ -= int64_t(accepted.size());
+
+    if (accepted.size() > 0)
     {
         if (this->scrollBar_->isAtBottom())
             this->scrollBar_->scrollToBottom();
@@ -934,6 +1052,70 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
     this->queueLayout();
 }
 
+void ChannelView::messagesAddedAtEnd(std::vector<MessagePtr> &messages)
+{
+    if (this->suspension_.miss(messages.size()))
+    {
+        return;
+    }
+
+    bool ignoreHighlights = this->channel_->shouldIgnoreHighlights();
+    bool showHighlights = this->showScrollbarHighlights();
+    auto estimatedHeight = this->estimateMessageHeight();
+    int removed = 0;
+
+    for (const auto &message : messages)
+    {
+        auto layout = new MessageLayout(message);
+
+        // alternate color
+        if (this->lastMessageHasAlternateBackground_)
+            layout->flags.set(MessageLayoutFlag::AlternateBackground);
+        this->lastMessageHasAlternateBackground_ =
+            !this->lastMessageHasAlternateBackground_;
+
+        if (ignoreHighlights)
+            layout->flags.set(MessageLayoutFlag::IgnoreHighlights);
+
+        MessageLayoutPtr deleted;
+        if (this->messages_.pushBack(MessageLayoutPtr(layout), deleted))
+        {
+            removed++;
+        }
+        if (this->messages_.shrink(deleted))
+        {
+            removed++;
+        }
+        this->heights_.pushBack(estimatedHeight);
+
+        if (showHighlights)
+        {
+            this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        }
+    }
+
+    this->firstSequence_ += removed;
+
+    if (removed > 0)
+    {
+        if (this->paused())
+        {
+            if (!this->scrollBar_->isAtBottom())
+                this->pauseScrollOffset_ -= removed;
+        }
+        else
+        {
+            if (this->scrollBar_->isAtBottom())
+                this->scrollBar_->scrollToBottom();
+            else
+                this->scrollBar_->offset(-removed);
+        }
+    }
+
+    this->messageWasAdded_ = true;
+    this->queueLayout();
+}
+
 void ChannelView::messageRemoveFromStart(MessagePtr &message)
 {
     if (this->paused())
@@ -953,6 +1135,23 @@ void ChannelView::messageRemoveFromStart(MessagePtr &message)
 
 void ChannelView::messageReplaced(size_t index, MessagePtr &replacement)
 {
+    if (this->suspension_.missedCount() > 0)
+    {
+        // The channel has messages we don't have layouts for yet
+        auto layoutIndex = this->suspension_.layoutIndex(
+            index, this->messages_.getSnapshot().size(),
+            this->channel_->getMessageSnapshot().size());
+
+        // Missed messages are taken from the channel, which already has the
+        // replacement
+        if (!layoutIndex)
+        {
+            return;
+        }
+
+        index = *layoutIndex;
+    }
+
     if (index >= this->messages_.getSnapshot().size())
     {
         return;
@@ -981,6 +1180,46 @@ void ChannelView::messageReplaced(size_t index, MessagePtr &replacement)
     this->queueLayout();
 }
 
+void ChannelView::requestTabHighlight(const MessageFlags &flags)
+{
+    if (flags.has(MessageFlag::DoNotTriggerNotification))
+    {
+        return;
+    }
+
+    if (flags.has(MessageFlag::Highlighted) &&
+        flags.has(MessageFlag::ShowInMentions) &&
+        !flags.has(MessageFlag::Subscription) &&
+        (getSettings()->highlightMentions ||
+         this->channel_->getType() != Channel::Type::TwitchMentions))
+    {
+        this->tabHighlightRequested.invoke(HighlightState::Highlighted);
+    }
+    else
+    {
+        this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+    }
+}
+
+void ChannelView::resume()
+{
+    if (!this->suspension_.isSuspended())
+    {
+        return;
+    }
+
+    auto missed =
+        this->suspension_.resume(this->channel_->getMessageSnapshot());
+    if (missed.empty())
+    {
+        this->queueLayout();
+        return;
+    }
+
+    // Only the messages in view get laid out
+    this->messagesAddedAtEnd(missed);
+}
+
 void ChannelView::updateLastReadMessage()
 {
     auto _snapshot = this->getMessagesSnapshot();
@@ -1080,7 +1319,8 @@ MessageElementFlags ChannelView::getFlags() const
 
 void ChannelView::paintEvent(QPaintEvent * /*event*/)
 {
-    //    BenchmarkGuard benchmark("paint");
+    static auto &channelViewPaint = Metrics::histogram("channel view paint");
+    MetricTimer timer(channelViewPaint);
 
     QPainter painter(this);
 
@@ -1105,6 +1345,8 @@ void ChannelView::drawMessages(QPainter &painter)
 {
     auto messagesSnapshot = this->getMessagesSnapshot();
 
+    this->animatedElementsOnScreen_ = false;
+
     size_t start = size_t(this->scrollBar_->getCurrentValue());
 
     if (start >= messagesSnapshot.size())
@@ -1121,19 +1363,25 @@ void ChannelView::drawMessages(QPainter &painter)
     auto app = getApp();
     bool isMentions =
         this->underlyingChannel_ == app->twitch.server->mentionsChannel;
+    auto settings = RenderSettings::get();
 
     for (size_t i = start; i < messagesSnapshot.size(); ++i)
     {
         MessageLayout *layout = messagesSnapshot[i].get();
 
         bool isLastMessage = false;
-        if (getSettings()->showLastMessageIndicator)
+        if (settings->showLastMessageIndicator)
         {
             isLastMessage = this->lastReadMessage_.get() == layout;
         }
 
         layout->paint(painter, DRAW_WIDTH, y, i, this->selection_,
-                      isLastMessage, windowFocused, isMentions);
+                      isLastMessage, windowFocused, isMentions, *settings);
+
+        if (!this->animatedElementsOnScreen_ && layout->hasAnimatedElements())
+        {
+            this->animatedElementsOnScreen_ = true;
+        }
 
         y += layout->getHeight();
 
@@ -1203,75 +1451,32 @@ void ChannelView::wheelEvent(QWheelEvent *event)
         qreal delta = event->angleDelta().y() * qreal(1.5) * mouseMultiplier;
 
         auto snapshot = this->getMessagesSnapshot();
-        int snapshotLength = int(snapshot.size());
-        int i = std::min<int>(int(desired), snapshotLength);
+        auto first = this->snapshotFirstSequence_;
+        auto end = first + int64_t(snapshot.size());
 
-        if (delta > 0)
-        {
-            qreal scrollFactor = fmod(desired, 1);
-            qreal currentScrollLeft = std::max<qreal>(
-                0.01, int(scrollFactor * snapshot[i]->getHeight()));
+        // Scroll by pixels, messages that weren't laid out yet use their
+        // estimated height until they become visible
+        auto index = std::min(int64_t(desired), int64_t(snapshot.size()));
+        auto offset = this->heights_.heightBetween(first, first + index) +
+                      int64_t(std::fmod(desired, 1) *
+                              this->heights_.get(first + index));
 
-            for (; i >= 0; i--)
-            {
-                if (delta < currentScrollLeft)
-                {
-                    desired -= scrollFactor * (delta / currentScrollLeft);
-                    break;
-                }
-                else
-                {
-                    delta -= currentScrollLeft;
-                    desired -= scrollFactor;
-                }
+        auto top = this->heights_.find(first, offset - int64_t(delta));
 
-                if (i == 0)
-                {
-                    desired = 0;
-                }
-                else
-                {
-                    snapshot[i - 1]->layout(this->getLayoutWidth(),
-                                            this->scale(), this->getFlags());
-                    scrollFactor = 1;
-                    currentScrollLeft = snapshot[i - 1]->getHeight();
-                }
-            }
+        if (top.sequence >= end)
+        {
+            desired = snapshot.size();
+        }
+        else if (top.sequence < first)
+        {
+            // Messages that were added at the start while we're paused
+            desired = 0;
         }
         else
         {
-            delta = -delta;
-            qreal scrollFactor = 1 - fmod(desired, 1);
-            qreal currentScrollLeft = std::max<qreal>(
-                0.01, int(scrollFactor * snapshot[i]->getHeight()));
-
-            for (; i < snapshotLength; i++)
-            {
-                if (delta < currentScrollLeft)
-                {
-                    desired +=
-                        scrollFactor * (qreal(delta) / currentScrollLeft);
-                    break;
-                }
-                else
-                {
-                    delta -= currentScrollLeft;
-                    desired += scrollFactor;
-                }
-
-                if (i == snapshotLength - 1)
-                {
-                    desired = snapshot.size();
-                }
-                else
-                {
-                    snapshot[i + 1]->layout(this->getLayoutWidth(),
-                                            this->scale(), this->getFlags());
-
-                    scrollFactor = 1;
-                    currentScrollLeft = snapshot[i + 1]->getHeight();
-                }
-            }
+            desired = qreal(top.sequence - first) +
+                      qreal(top.offset) /
+                          std::max(1, this->heights_.get(top.sequence));
         }
 
         this->scrollBar_->setDesiredValue(desired, true);
@@ -2135,14 +2340,29 @@ void ChannelView::mouseDoubleClickEvent(QMouseEvent *event)
     }
 }
 
+void ChannelView::showEvent(QShowEvent *event)
+{
+    BaseWidget::showEvent(event);
+
+    this->resume();
+
+    if (this->underlyingChannel_)
+    {
+        this->underlyingChannel_->activate();
+    }
+}
+
 void ChannelView::hideEvent(QHideEvent *)
 {
+    this->suspension_.suspend();
+
     for (auto &layout : this->messagesOnScreen_)
     {
         layout->deleteBuffer();
     }
 
     this->messagesOnScreen_.clear();
+    this->animatedElementsOnScreen_ = false;
 }
 
 void ChannelView::showUserInfoPopup(const QString &userName)
@@ -2336,6 +2556,35 @@ int ChannelView::getLayoutWidth() const
     return this->width();
 }
 
+int ChannelView::estimateMessageHeight() const
+{
+    auto metrics =
+        getApp()->fonts->getFontMetrics(FontStyle::ChatMedium, this->scale());
+
+    // Same as the top and bottom margins of MessageLayoutContainer
+    return metrics.height() + int(8 * this->scale());
+}
+
+void ChannelView::reestimateHeights(int layoutWidth)
+{
+    if (layoutWidth == this->heightsLayoutWidth_ &&
+        this->scale() == this->heightsScale_)
+    {
+        return;
+    }
+
+    this->heightsLayoutWidth_ = layoutWidth;
+    this->heightsScale_ = this->scale();
+
+    // Messages are laid out again once they become visible
+    auto estimatedHeight = this->estimateMessageHeight();
+    for (auto sequence = this->heights_.firstSequence();
+         sequence < this->heights_.endSequence(); sequence++)
+    {
+        this->heights_.set(sequence, estimatedHeight);
+    }
+}
+
 void ChannelView::selectWholeMessage(MessageLayout *layout, int &messageIndex)
 {
     SelectionItem msgStart(messageIndex,
@@ -16,6 +16,8 @@
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Selection.hpp"
 #include "widgets/BaseWidget.hpp"
+#include "widgets/helper/MessageHeightTree.hpp"
+#include "widgets/helper/ViewSuspension.hpp"
 
 namespace chatterino {
 enum class HighlightState;
@@ -124,6 +126,7 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
     void mouseDoubleClickEvent(QMouseEvent *event) override;
 
+    void showEvent(QShowEvent *) override;
     void hideEvent(QHideEvent *) override;
 
     void handleLinkClick(QMouseEvent *event, const Link &link,
@@ -137,11 +140,20 @@ private:
     void initializeScrollbar();
     void initializeSignals();
 
+    // Loads older messages from the spilled messages of the channel once
+    // we're scrolled to the top
+    void loadSpilledMessagesAtTop();
+
     void messageAppended(MessagePtr &message,
                          boost::optional<MessageFlags> overridingFlags);
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
+    void messagesAddedAtEnd(std::vector<MessagePtr> &messages);
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t index, MessagePtr &replacement);
+    void requestTabHighlight(const MessageFlags &flags);
+
+    // Creates the layouts for the messages we missed while hidden
+    void resume();
 
     void performLayout(bool causedByScollbar = false);
     void layoutVisibleMessages(
@@ -163,6 +175,12 @@ private:
     void addContextMenuItems(const MessageLayoutElement *hoveredElement,
                              MessageLayoutPtr layout);
     int getLayoutWidth() const;
+    // Height of a message with a single line, used for the messages that
+    // weren't laid out yet
+    int estimateMessageHeight() const;
+    // Goes back to estimating the heights of all messages if the layout
+    // width or scale changed since they were laid out
+    void reestimateHeights(int layoutWidth);
     void updatePauses();
     void unpaused();
 
@@ -192,6 +210,10 @@ private:
 
     LimitedQueueSnapshot<MessageLayoutPtr> snapshot_;
 
+    ViewSuspension suspension_;
+
+    bool loadSpilledMessagesQueued_ = false;
+
     ChannelPtr channel_ = nullptr;
     ChannelPtr underlyingChannel_ = nullptr;
     ChannelPtr sourceChannel_ = nullptr;
@@ -240,12 +262,25 @@ private:
 
     LimitedQueue<MessageLayoutPtr> messages_;
 
+    // Heights of the messages in messages_ and the paused snapshot_, the
+    // scroll position is mapped to pixels with them
+    MessageHeightTree heights_;
+    // Layout width and scale the heights were measured at
+    int heightsLayoutWidth_ = 0;
+    float heightsScale_ = 0;
+    // Sequence of the first message in messages_ and in snapshot_
+    int64_t firstSequence_ = 0;
+    int64_t snapshotFirstSequence_ = 0;
+
     pajlada::Signals::SignalHolder signalHolder_;
 
     // channelConnections_ will be cleared when the underlying channel of the channelview changes
     pajlada::Signals::SignalHolder channelConnections_;
 
     std::unordered_set<std::shared_ptr<MessageLayout>> messagesOnScreen_;
+    // Whether the last paint drew animated images, only then the view has to
+    // be repainted when the gif timer ticks
+    bool animatedElementsOnScreen_ = false;
 
     static constexpr int leftPadding = 8;
     static constexpr int scrollbarPadding = 8;
@@ -1,6 +1,6 @@
 #include "DebugPopup.hpp"
 
-#include "util/DebugCount.hpp"
+#include "util/Metrics.hpp"
 
 #include <QFontDatabase>
 #include <QHBoxLayout>
@@ -17,7 +17,7 @@ DebugPopup::DebugPopup()
 
     timer->setInterval(300);
     QObject::connect(timer, &QTimer::timeout, [text] {
-        text->setText(DebugCount::getDebugText());
+        text->setText(Metrics::toText());
     });
     timer->start();
 
@@ -0,0 +1,239 @@
+#include "widgets/helper/MessageHeightTree.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+namespace {
+
+    // Fits the default message limit without growing
+    constexpr size_t initialCapacity = 1024;
+
+}  // namespace
+
+int64_t MessageHeightTree::firstSequence() const
+{
+    return this->first_;
+}
+
+int64_t MessageHeightTree::endSequence() const
+{
+    return this->first_ + int64_t(this->size_);
+}
+
+size_t MessageHeightTree::size() const
+{
+    return this->size_;
+}
+
+bool MessageHeightTree::contains(int64_t sequence) const
+{
+    return sequence >= this->first_ && sequence < this->endSequence();
+}
+
+void MessageHeightTree::pushBack(int height)
+{
+    if (this->size_ == this->capacity())
+    {
+        this->grow();
+    }
+
+    this->size_++;
+    this->set(this->endSequence() - 1, height);
+}
+
+void MessageHeightTree::pushFront(int height)
+{
+    if (this->size_ == this->capacity())
+    {
+        this->grow();
+    }
+
+    this->first_--;
+    this->size_++;
+    this->set(this->first_, height);
+}
+
+void MessageHeightTree::trimFront(int64_t sequence)
+{
+    while (this->size_ > 0 && this->first_ < sequence)
+    {
+        // Unused slots have to be empty, see find
+        this->set(this->first_, 0);
+        this->first_++;
+        this->size_--;
+    }
+}
+
+void MessageHeightTree::clear()
+{
+    std::fill(this->heights_.begin(), this->heights_.end(), 0);
+    std::fill(this->tree_.begin(), this->tree_.end(), 0);
+    this->total_ = 0;
+    this->first_ = 0;
+    this->size_ = 0;
+}
+
+int MessageHeightTree::get(int64_t sequence) const
+{
+    if (!this->contains(sequence))
+    {
+        return 0;
+    }
+
+    return this->heights_[this->slot(sequence)];
+}
+
+void MessageHeightTree::set(int64_t sequence, int height)
+{
+    if (!this->contains(sequence))
+    {
+        return;
+    }
+
+    auto slot = this->slot(sequence);
+    auto delta = height - this->heights_[slot];
+    if (delta == 0)
+    {
+        return;
+    }
+
+    this->heights_[slot] = height;
+    this->add(slot, delta);
+}
+
+int64_t MessageHeightTree::heightBetween(int64_t from, int64_t to) const
+{
+    from = std::max(from, this->first_);
+    to = std::min(to, this->endSequence());
+
+    if (from >= to)
+    {
+        return 0;
+    }
+
+    auto start = this->slot(from);
+    auto end = start + size_t(to - from);
+
+    if (end <= this->capacity())
+    {
+        return this->prefix(end) - this->prefix(start);
+    }
+
+    // The range wraps around the end of the ring
+    return this->total_ - this->prefix(start) +
+           this->prefix(end - this->capacity());
+}
+
+MessageHeightTree::Position MessageHeightTree::find(int64_t from,
+                                                    int64_t offset) const
+{
+    auto absolute = this->heightBetween(this->first_, from) + offset;
+
+    if (this->size_ == 0 || absolute >= this->total_)
+    {
+        return {this->endSequence(), 0};
+    }
+    if (absolute <= 0)
+    {
+        return {this->first_, 0};
+    }
+
+    // Slots that aren't used are empty, so the search can't end in them
+    auto firstSlot = this->slot(this->first_);
+    auto target = this->prefix(firstSlot) + absolute;
+    if (target >= this->total_)
+    {
+        target -= this->total_;
+    }
+
+    auto slot = this->lowerBound(target);
+    auto index = (slot + this->capacity() - firstSlot) % this->capacity();
+
+    return {this->first_ + int64_t(index), int(target - this->prefix(slot))};
+}
+
+size_t MessageHeightTree::capacity() const
+{
+    return this->heights_.size();
+}
+
+size_t MessageHeightTree::slot(int64_t sequence) const
+{
+    // The capacity is a power of two, this works for negative sequences too
+    return size_t(sequence) & (this->capacity() - 1);
+}
+
+int64_t MessageHeightTree::prefix(size_t count) const
+{
+    int64_t sum = 0;
+
+    for (auto i = count; i > 0; i -= i & (~i + 1))
+    {
+        sum += this->tree_[i];
+    }
+
+    return sum;
+}
+
+void MessageHeightTree::add(size_t slot, int delta)
+{
+    for (auto i = slot + 1; i <= this->capacity(); i += i & (~i + 1))
+    {
+        this->tree_[i] += delta;
+    }
+
+    this->total_ += delta;
+}
+
+size_t MessageHeightTree::lowerBound(int64_t target) const
+{
+    size_t count = 0;
+    auto step = this->capacity();
+
+    for (; step > 0; step >>= 1)
+    {
+        if (count + step <= this->capacity() &&
+            this->tree_[count + step] <= target)
+        {
+            count += step;
+            target -= this->tree_[count];
+        }
+    }
+
+    return count;
+}
+
+void MessageHeightTree::grow()
+{
+    std::vector<int> heights;
+    heights.reserve(this->size_);
+    for (auto sequence = this->first_; sequence < this->endSequence();
+         sequence++)
+    {
+        heights.push_back(this->heights_[this->slot(sequence)]);
+    }
+
+    auto capacity = std::max(initialCapacity, this->capacity() * 2);
+    this->heights_.assign(capacity, 0);
+    this->tree_.assign(capacity + 1, 0);
+
+    for (size_t i = 0; i < heights.size(); i++)
+    {
+        auto slot = this->slot(this->first_ + int64_t(i));
+        this->heights_[slot] = heights[i];
+        this->tree_[slot + 1] = heights[i];
+    }
+
+    // Build the tree in O(n) by pushing every node into its parent
+    for (size_t i = 1; i <= capacity; i++)
+    {
+        auto parent = i + (i & (~i + 1));
+        if (parent <= capacity)
+        {
+            this->tree_[parent] += this->tree_[i];
+        }
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+
+// The heights of the messages of a view, in pixels, for converting between
+// scroll positions and messages in O(log n).
+//
+// Messages are identified by a sequence number, which increases by one for
+// every message added at the end and decreases for messages added at the
+// start. Heights are kept in a Fenwick tree on top of a ring buffer, so
+// messages can be added and removed at both ends. Messages that weren't laid
+// out yet use an estimated height until they are.
+class MessageHeightTree
+{
+public:
+    struct Position {
+        int64_t sequence;
+        // Pixels from the top of the message
+        int offset;
+    };
+
+    int64_t firstSequence() const;
+    // Sequence past the last message
+    int64_t endSequence() const;
+    size_t size() const;
+    bool contains(int64_t sequence) const;
+
+    void pushBack(int height);
+    void pushFront(int height);
+    // Removes the messages before `sequence`
+    void trimFront(int64_t sequence);
+    void clear();
+
+    // Returns 0 for messages that aren't in the tree
+    int get(int64_t sequence) const;
+    void set(int64_t sequence, int height);
+
+    // Total height of the messages in [from, to)
+    int64_t heightBetween(int64_t from, int64_t to) const;
+
+    // Finds the message `offset` pixels below the top of message `from`.
+    // Negative offsets are above it. Offsets before the first message return
+    // the top of the first message, offsets past the last message return
+    // endSequence().
+    Position find(int64_t from, int64_t offset) const;
+
+private:
+    size_t capacity() const;
+    size_t slot(int64_t sequence) const;
+    // Sum of the slots [0, count)
+    int64_t prefix(size_t count) const;
+    void add(size_t slot, int delta);
+    // Largest count of slots whose sum is at most `target`
+    size_t lowerBound(int64_t target) const;
+    void grow();
+
+    std::vector<int> heights_;
+    // 1-based Fenwick tree over heights_
+    std::vector<int64_t> tree_;
+    int64_t total_ = 0;
+
+    int64_t first_ = 0;
+    size_t size_ = 0;
+};
+
+}  // namespace chatterino
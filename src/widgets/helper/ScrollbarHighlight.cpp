@@ -9,6 +9,8 @@ namespace chatterino {
 ScrollbarHighlight::ScrollbarHighlight()
     : color_(std::make_shared<QColor>())
     , style_(Style::None)
+    , isRedeemedHighlight_(false)
+    , isFirstMessageHighlight_(false)
 {
 }
 
@@ -47,4 +49,13 @@ bool ScrollbarHighlight::isNull() const
     return this->style_ == None;
 }
 
+bool ScrollbarHighlight::operator==(const ScrollbarHighlight &other) const
+{
+    // Colors are shared with the settings, so comparing the pointers keeps
+    // highlights equal when their color is changed
+    return this->color_ == other.color_ && this->style_ == other.style_ &&
+           this->isRedeemedHighlight_ == other.isRedeemedHighlight_ &&
+           this->isFirstMessageHighlight_ == other.isFirstMessageHighlight_;
+}
+
 }  // namespace chatterino
@@ -30,6 +30,9 @@ public:
     bool isFirstMessageHighlight() const;
     bool isNull() const;
 
+    // Highlights are equal if they are drawn the same way
+    bool operator==(const ScrollbarHighlight &other) const;
+
 private:
     std::shared_ptr<QColor> color_;
     Style style_;
@@ -0,0 +1,199 @@
+#include "widgets/helper/ScrollbarMinimap.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+ScrollbarMinimap::ScrollbarMinimap(size_t limit, size_t maxLimit)
+    : baseLimit_(limit)
+    , maxLimit_(std::max(limit, maxLimit))
+    , limit_(limit)
+{
+}
+
+void ScrollbarMinimap::pushBack(const ScrollbarHighlight &highlight)
+{
+    if (this->limit_ > this->baseLimit_)
+    {
+        this->limit_--;
+    }
+
+    while (!this->highlights_.empty() &&
+           this->highlights_.size() >= this->limit_)
+    {
+        this->remove(this->firstSequence_, this->highlights_.front());
+        this->highlights_.pop_front();
+        this->firstSequence_++;
+
+        // Drop buckets that only contained evicted highlights
+        auto firstKey = this->bucketKey(this->firstSequence_);
+        while (!this->buckets_.empty() && this->firstBucketKey_ < firstKey)
+        {
+            this->buckets_.pop_front();
+            this->firstBucketKey_++;
+        }
+    }
+
+    auto sequence = this->firstSequence_ + int64_t(this->highlights_.size());
+    this->highlights_.push_back(highlight);
+    this->add(sequence, highlight);
+}
+
+void ScrollbarMinimap::pushFront(
+    const std::vector<ScrollbarHighlight> &highlights)
+{
+    this->limit_ = std::min(
+        this->maxLimit_,
+        std::max(this->limit_, this->highlights_.size() + highlights.size()));
+
+    auto space = this->limit_ - this->highlights_.size();
+    auto count = std::min(space, highlights.size());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto &highlight = highlights[highlights.size() - 1 - i];
+
+        this->firstSequence_--;
+        this->highlights_.push_front(highlight);
+        this->add(this->firstSequence_, highlight);
+    }
+}
+
+void ScrollbarMinimap::replace(size_t index,
+                               const ScrollbarHighlight &highlight)
+{
+    if (index >= this->highlights_.size())
+    {
+        return;
+    }
+
+    auto sequence = this->firstSequence_ + int64_t(index);
+
+    this->remove(sequence, this->highlights_[index]);
+    this->highlights_[index] = highlight;
+    this->add(sequence, highlight);
+}
+
+void ScrollbarMinimap::clear()
+{
+    this->limit_ = this->baseLimit_;
+    this->highlights_.clear();
+    this->buckets_.clear();
+    this->firstSequence_ = 0;
+    this->firstBucketKey_ = 0;
+}
+
+size_t ScrollbarMinimap::size() const
+{
+    return this->highlights_.size();
+}
+
+const ScrollbarHighlight &ScrollbarMinimap::at(size_t index) const
+{
+    return this->highlights_.at(index);
+}
+
+void ScrollbarMinimap::setRowCount(int rows)
+{
+    auto rowCount = size_t(std::max(rows, 1));
+    auto bucketSize =
+        std::max<size_t>(1, (this->baseLimit_ + rowCount - 1) / rowCount);
+
+    if (bucketSize != this->bucketSize_)
+    {
+        this->bucketSize_ = bucketSize;
+        this->rebuild();
+    }
+}
+
+size_t ScrollbarMinimap::getBucketSize() const
+{
+    return this->bucketSize_;
+}
+
+int64_t ScrollbarMinimap::bucketKey(int64_t sequence) const
+{
+    auto bucketSize = int64_t(this->bucketSize_);
+
+    // Round towards negative infinity, sequences before the first message we
+    // got are negative
+    return sequence >= 0 ? sequence / bucketSize
+                         : -((-sequence + bucketSize - 1) / bucketSize);
+}
+
+void ScrollbarMinimap::add(int64_t sequence,
+                           const ScrollbarHighlight &highlight)
+{
+    if (highlight.isNull())
+    {
+        return;
+    }
+
+    auto key = this->bucketKey(sequence);
+
+    if (this->buckets_.empty())
+    {
+        this->firstBucketKey_ = key;
+    }
+    while (key < this->firstBucketKey_)
+    {
+        this->buckets_.emplace_front();
+        this->firstBucketKey_--;
+    }
+    while (key >= this->firstBucketKey_ + int64_t(this->buckets_.size()))
+    {
+        this->buckets_.emplace_back();
+    }
+
+    auto &bucket = this->buckets_[size_t(key - this->firstBucketKey_)];
+
+    for (auto &entry : bucket)
+    {
+        if (entry.highlight == highlight)
+        {
+            entry.count++;
+            return;
+        }
+    }
+
+    bucket.push_back({highlight, 1});
+}
+
+void ScrollbarMinimap::remove(int64_t sequence,
+                              const ScrollbarHighlight &highlight)
+{
+    if (highlight.isNull())
+    {
+        return;
+    }
+
+    auto index = this->bucketKey(sequence) - this->firstBucketKey_;
+    if (index < 0 || index >= int64_t(this->buckets_.size()))
+    {
+        return;
+    }
+
+    auto &bucket = this->buckets_[size_t(index)];
+
+    auto it = std::find_if(bucket.begin(), bucket.end(),
+                           [&highlight](const auto &entry) {
+                               return entry.highlight == highlight;
+                           });
+
+    if (it != bucket.end() && --it->count == 0)
+    {
+        bucket.erase(it);
+    }
+}
+
+void ScrollbarMinimap::rebuild()
+{
+    this->buckets_.clear();
+
+    for (size_t i = 0; i < this->highlights_.size(); i++)
+    {
+        this->add(this->firstSequence_ + int64_t(i), this->highlights_[i]);
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "widgets/helper/ScrollbarHighlight.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace chatterino {
+
+// The highlights of a scrollbar, grouped into buckets of consecutive messages.
+//
+// Every bucket counts the highlights of each kind (see
+// ScrollbarHighlight::operator==) in its messages, and buckets are sized so
+// there's about one per pixel row of the scrollbar. Buckets are keyed by the
+// position of a message in the channel rather than by its index, so adding or
+// evicting a message only touches a single bucket. Painting is proportional to
+// the height of the scrollbar instead of the number of messages.
+class ScrollbarMinimap
+{
+public:
+    struct Entry {
+        ScrollbarHighlight highlight;
+        int count;
+    };
+    using Bucket = std::vector<Entry>;
+
+    // Like the messages of a channel, the limit can grow up to `maxLimit` to
+    // fit highlights added at the start
+    explicit ScrollbarMinimap(size_t limit = 1000, size_t maxLimit = 0);
+
+    // Lowers a grown limit by one
+    void pushBack(const ScrollbarHighlight &highlight);
+    // Grows the limit to fit the highlights, then only adds the last
+    // highlights that fit into it
+    void pushFront(const std::vector<ScrollbarHighlight> &highlights);
+    void replace(size_t index, const ScrollbarHighlight &highlight);
+    void clear();
+
+    size_t size() const;
+    const ScrollbarHighlight &at(size_t index) const;
+
+    // Resizes the buckets so there's about one for every row
+    void setRowCount(int rows);
+    size_t getBucketSize() const;
+
+    // Calls func(firstIndex, endIndex, bucket) for every bucket that has
+    // highlights
+    template <typename Func>
+    void forEachBucket(Func &&func) const
+    {
+        auto end = this->firstSequence_ + int64_t(this->highlights_.size());
+
+        for (size_t i = 0; i < this->buckets_.size(); i++)
+        {
+            const auto &bucket = this->buckets_[i];
+            if (bucket.empty())
+            {
+                continue;
+            }
+
+            auto key = this->firstBucketKey_ + int64_t(i);
+            auto bucketStart = std::max(key * int64_t(this->bucketSize_),
+                                        this->firstSequence_);
+            auto bucketEnd =
+                std::min((key + 1) * int64_t(this->bucketSize_), end);
+
+            func(size_t(bucketStart - this->firstSequence_),
+                 size_t(bucketEnd - this->firstSequence_), bucket);
+        }
+    }
+
+private:
+    int64_t bucketKey(int64_t sequence) const;
+    void add(int64_t sequence, const ScrollbarHighlight &highlight);
+    void remove(int64_t sequence, const ScrollbarHighlight &highlight);
+    void rebuild();
+
+    const size_t baseLimit_;
+    const size_t maxLimit_;
+    size_t limit_;
+    size_t bucketSize_ = 1;
+
+    std::deque<ScrollbarHighlight> highlights_;
+    // Position of the first highlight in the channel. Decreases when
+    // highlights are added at the start.
+    int64_t firstSequence_ = 0;
+
+    std::deque<Bucket> buckets_;
+    int64_t firstBucketKey_ = 0;
+};
+
+}  // namespace chatterino
@@ -4,56 +4,84 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QVBoxLayout>
+#include <QtConcurrent>
+
+#include <algorithm>
 
 #include "common/Channel.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
 #include "messages/Message.hpp"
+#include "messages/MessageSpillStore.hpp"
 #include "messages/search/AuthorPredicate.hpp"
 #include "messages/search/ChannelPredicate.hpp"
 #include "messages/search/LinkPredicate.hpp"
 #include "messages/search/MessageFlagsPredicate.hpp"
 #include "messages/search/RegexPredicate.hpp"
 #include "messages/search/SubstringPredicate.hpp"
+#include "util/PostToThread.hpp"
 #include "widgets/helper/ChannelView.hpp"
 
 namespace chatterino {
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot,
-                               FilterSetPtr filterSet)
-{
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
+namespace {
 
-    // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
+    using Predicates = std::vector<std::unique_ptr<MessagePredicate>>;
 
-    // Check for every message whether it fulfills all predicates that have
-    // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
-    {
-        MessagePtr message = snapshot[i];
+    // Amount of messages a single worker checks at once
+    constexpr size_t SEARCH_CHUNK_SIZE = 1000;
 
-        bool accept = true;
+    // Checks whether the message fulfills all predicates that have been
+    // registered. Channel filters and message flags are checked on the GUI
+    // thread later on, since they look at state that's only safe to read
+    // there.
+    bool acceptMessage(const MessagePtr &message, const Predicates &predicates)
+    {
         for (const auto &pred : predicates)
         {
             // Discard the message as soon as one predicate fails
             if (!pred->appliesTo(*message))
             {
-                accept = false;
-                break;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<MessagePtr> filterMessages(
+        const std::vector<MessagePtr> &messages, size_t begin, size_t end,
+        const Predicates &predicates)
+    {
+        std::vector<MessagePtr> matches;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (acceptMessage(messages[i], predicates))
+            {
+                matches.push_back(messages[i]);
             }
         }
 
-        if (accept && filterSet)
-            accept = filterSet->filter(message, channel);
+        return matches;
+    }
 
-        // If all predicates match, add the message to the channel
-        if (accept)
-            channel->addMessage(message);
+    // Spilled messages are checked without their elements, the matches are
+    // rebuilt on the GUI thread
+    std::vector<SpilledMessage> filterSpilledMessages(
+        std::vector<SpilledMessage> messages, const Predicates &predicates)
+    {
+        messages.erase(std::remove_if(messages.begin(), messages.end(),
+                                      [&](const SpilledMessage &message) {
+                                          return !acceptMessage(
+                                              message.toSearchProxy(),
+                                              predicates);
+                                      }),
+                       messages.end());
+
+        return messages;
     }
 
-    return channel;
-}
+}  // namespace
 
 SearchPopup::SearchPopup(QWidget *parent)
     : BasePopup({}, parent)
@@ -63,6 +91,14 @@ SearchPopup::SearchPopup(QWidget *parent)
     this->addShortcuts();
 }
 
+SearchPopup::~SearchPopup()
+{
+    if (this->cancelSearch_)
+    {
+        *this->cancelSearch_ = true;
+    }
+}
+
 void SearchPopup::addShortcuts()
 {
     HotkeyController::HotkeyMap actions{
@@ -91,13 +127,21 @@ void SearchPopup::addShortcuts()
 void SearchPopup::setChannelFilters(FilterSetPtr filters)
 {
     this->channelFilters_ = std::move(filters);
+    this->searchFinished_ = false;
 }
 
 void SearchPopup::setChannel(const ChannelPtr &channel)
 {
     this->channelView_->setSourceChannel(channel);
     this->channelName_ = channel->getName();
-    this->snapshot_ = channel->getMessageSnapshot();
+    this->channel_ = channel;
+    // Messages spilled later on are in the snapshot
+    auto history = channel->getHistorySnapshot();
+    this->snapshot_ = history.messages;
+    this->spillStore_ = history.spillStore;
+    this->spilledBegin_ = history.spilledBegin;
+    this->spilledEnd_ = history.spilledEnd;
+    this->searchFinished_ = false;
     this->search();
 
     this->updateWindowTitle();
@@ -128,9 +172,228 @@ void SearchPopup::updateWindowTitle()
 
 void SearchPopup::search()
 {
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_,
-                                          this->channelFilters_));
+    auto query = this->searchInput_->text();
+
+    // If the new query only narrows down the last one, we only have to look
+    // through the last results. That's only possible if none of them were
+    // dropped.
+    bool narrow = this->searchFinished_ && !this->matchesDropped_ &&
+                  isNarrowing(this->query_, query);
+
+    std::vector<MessagePtr> messages;
+    std::shared_ptr<MessageSpillStore> spillStore;
+    if (narrow)
+    {
+        messages = std::move(this->matches_);
+    }
+    else
+    {
+        messages.reserve(this->snapshot_.size());
+        for (size_t i = 0; i < this->snapshot_.size(); ++i)
+        {
+            messages.push_back(this->snapshot_[i]);
+        }
+        spillStore = this->spillStore_;
+    }
+
+    if (this->cancelSearch_)
+    {
+        *this->cancelSearch_ = true;
+    }
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    this->cancelSearch_ = cancel;
+
+    this->query_ = query;
+    this->matches_.clear();
+    this->matchesDropped_ = false;
+    this->searchFinished_ = false;
+
+    this->results_ =
+        std::make_shared<Channel>(this->channelName_, Channel::Type::None);
+    this->channelView_->setChannel(this->results_);
+
+    // Parse predicates from tags in "query"
+    auto flagPredicates = std::make_shared<Predicates>();
+    auto predicates = std::make_shared<const Predicates>(
+        parsePredicates(query, *flagPredicates));
+
+    QtConcurrent::run([this, cancel, predicates, messages = std::move(messages),
+                       filterSet = this->channelFilters_,
+                       flagPredicates = std::shared_ptr<const Predicates>(
+                           std::move(flagPredicates)),
+                       spillStore, spilledBegin = this->spilledBegin_,
+                       spilledEnd = this->spilledEnd_] {
+        // Split the messages into chunks that are searched in parallel, but
+        // hand out the results in order
+        std::vector<QFuture<std::vector<MessagePtr>>> chunks;
+        for (size_t begin = 0; begin < messages.size();
+             begin += SEARCH_CHUNK_SIZE)
+        {
+            auto end = std::min(begin + SEARCH_CHUNK_SIZE, messages.size());
+
+            chunks.push_back(QtConcurrent::run([&, begin, end] {
+                if (*cancel)
+                {
+                    return std::vector<MessagePtr>();
+                }
+
+                return filterMessages(messages, begin, end, *predicates);
+            }));
+        }
+
+        // Spilled messages are older than the ones in memory, so their
+        // results are handed out first. They're read from disk one chunk at a
+        // time.
+        if (spillStore)
+        {
+            // Records dropped since then are skipped by read
+            for (auto begin = spilledBegin; begin < spilledEnd && !*cancel;
+                 begin += SEARCH_CHUNK_SIZE)
+            {
+                auto end = std::min(begin + SEARCH_CHUNK_SIZE, spilledEnd);
+                auto matches = filterSpilledMessages(
+                    spillStore->read(begin, end), *predicates);
+                if (matches.empty())
+                {
+                    continue;
+                }
+
+                // Building messages uses emotes and settings of the channel,
+                // which may only be touched on the GUI thread
+                postToThread([this, cancel, filterSet, flagPredicates,
+                              matches = std::move(matches)] {
+                    if (*cancel)
+                    {
+                        return;
+                    }
+
+                    std::vector<MessagePtr> rebuilt;
+                    for (const auto &match : matches)
+                    {
+                        auto message = this->channel_->rebuildMessage(match);
+                        if (message)
+                        {
+                            rebuilt.push_back(std::move(message));
+                        }
+                    }
+                    this->addResults(std::move(rebuilt), filterSet,
+                                     *flagPredicates);
+                });
+            }
+        }
+
+        for (auto &chunk : chunks)
+        {
+            auto matches = chunk.result();
+            if (matches.empty() || *cancel)
+            {
+                continue;
+            }
+
+            // The popup can only be destroyed on the GUI thread, which sets
+            // cancel first
+            postToThread([this, cancel, filterSet, flagPredicates,
+                          matches = std::move(matches)]() mutable {
+                if (!*cancel)
+                {
+                    this->addResults(std::move(matches), filterSet,
+                                     *flagPredicates);
+                }
+            });
+        }
+
+        postToThread([this, cancel] {
+            if (!*cancel)
+            {
+                this->searchFinished_ = true;
+            }
+        });
+    });
+}
+
+void SearchPopup::addResults(
+    std::vector<MessagePtr> results, const FilterSetPtr &filterSet,
+    const std::vector<std::unique_ptr<MessagePredicate>> &flagPredicates)
+{
+    if (!flagPredicates.empty())
+    {
+        results.erase(std::remove_if(results.begin(), results.end(),
+                                     [&](const MessagePtr &message) {
+                                         return !acceptMessage(message,
+                                                               flagPredicates);
+                                     }),
+                      results.end());
+    }
+
+    if (filterSet)
+    {
+        results.erase(std::remove_if(results.begin(), results.end(),
+                                     [&](const MessagePtr &message) {
+                                         return !filterSet->filter(
+                                             message, this->results_);
+                                     }),
+                      results.end());
+    }
+
+    this->matches_.insert(this->matches_.end(), results.begin(),
+                          results.end());
+
+    // The results channel only keeps the newest messages, older matches
+    // would never be shown again
+    if (this->matches_.size() > Channel::MESSAGE_LIMIT)
+    {
+        this->matches_.erase(this->matches_.begin(),
+                             this->matches_.end() - Channel::MESSAGE_LIMIT);
+        this->matchesDropped_ = true;
+    }
+
+    this->results_->addMessagesAtEnd(results);
+}
+
+bool SearchPopup::isNarrowing(const QString &previous, const QString &current)
+{
+    // Terms with these names are combined with OR instead of AND, so adding
+    // another one widens the search
+    static QRegularExpression orTermRegex(R"((?:^|\s)(from|in):)");
+    static QRegularExpression whitespaceRegex(R"(\s)");
+
+    if (!current.startsWith(previous) || previous.count('"') % 2 != 0)
+    {
+        return false;
+    }
+
+    auto added = current.mid(previous.length());
+    if (added.isEmpty())
+    {
+        return true;
+    }
+
+    if (!previous.isEmpty() && !previous.back().isSpace() &&
+        !added.front().isSpace())
+    {
+        // The last term was extended, e.g. "kap" -> "kappa". This only
+        // narrows plain substring terms.
+        auto lastTerm = previous.section(whitespaceRegex, -1);
+        auto extension = added.section(whitespaceRegex, 0, 0);
+        if (lastTerm.contains(':') || lastTerm.contains('"') ||
+            extension.contains(':') || extension.contains('"'))
+        {
+            return false;
+        }
+    }
+
+    auto it = orTermRegex.globalMatch(added);
+    while (it.hasNext())
+    {
+        auto name = it.next().captured(1);
+        if (previous.contains(
+                QRegularExpression(QString(R"((?:^|\s)%1:)").arg(name))))
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 void SearchPopup::initLayout()
@@ -184,7 +447,8 @@ void SearchPopup::initLayout()
 }
 
 std::vector<std::unique_ptr<MessagePredicate>> SearchPopup::parsePredicates(
-    const QString &input)
+    const QString &input,
+    std::vector<std::unique_ptr<MessagePredicate>> &flagPredicates)
 {
     // This regex captures all name:value predicate pairs into named capturing
     // groups and matches all other inputs seperated by spaces as normal
@@ -225,7 +489,7 @@ std::vector<std::unique_ptr<MessagePredicate>> SearchPopup::parsePredicates(
         }
         else if (name == "is")
         {
-            predicates.push_back(
+            flagPredicates.push_back(
                 std::make_unique<MessageFlagsPredicate>(value));
         }
         else if (name == "regex")
@@ -6,16 +6,21 @@
 #include "messages/search/MessagePredicate.hpp"
 #include "widgets/BasePopup.hpp"
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 class QLineEdit;
 
 namespace chatterino {
 
+class MessageSpillStore;
+
 class SearchPopup : public BasePopup
 {
 public:
     SearchPopup(QWidget *parent);
+    ~SearchPopup() override;
 
     virtual void setChannel(const ChannelPtr &channel);
     virtual void setChannelFilters(FilterSetPtr filters);
@@ -29,36 +34,57 @@ private:
     void addShortcuts() override;
 
     /**
-     * @brief Only retains those message from a list of messages that satisfy a
-     *        search query.
-     *
-     * @param text          the search query -- will be parsed for MessagePredicates
-     * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
-     *
-     * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     * @brief Checks whether a search for "current" can only match messages
+     *        that a search for "previous" matched too, so only the results
+     *        of "previous" need to be searched again.
      */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot,
-                             FilterSetPtr filterSet);
+    static bool isNarrowing(const QString &previous, const QString &current);
+
+    /**
+     * @brief Called on the GUI thread for every batch of results of the
+     *        running search, in order. Results that don't pass `filterSet`
+     *        or `flagPredicates` are dropped.
+     */
+    void addResults(
+        std::vector<MessagePtr> results, const FilterSetPtr &filterSet,
+        const std::vector<std::unique_ptr<MessagePredicate>> &flagPredicates);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
      *        predicates.
      *
      * @param input the string to check for tags
-     * @return a vector of MessagePredicates requested in the input
+     * @param flagPredicates receives the predicates checking message flags.
+     *        Flags change on the GUI thread, so they're only checked there.
+     * @return a vector of the other MessagePredicates requested in the input
      */
     static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
-        const QString &input);
+        const QString &input,
+        std::vector<std::unique_ptr<MessagePredicate>> &flagPredicates);
 
+    ChannelPtr channel_;
     LimitedQueueSnapshot<MessagePtr> snapshot_;
+    // Messages of the channel that were spilled before the snapshot was taken
+    // are searched too
+    std::shared_ptr<MessageSpillStore> spillStore_;
+    size_t spilledBegin_ = 0;
+    size_t spilledEnd_ = 0;
     QLineEdit *searchInput_{};
     ChannelView *channelView_{};
     QString channelName_{};
     FilterSetPtr channelFilters_;
+
+    // Channel the results of the current search are added to
+    ChannelPtr results_;
+    // Matches of the current search so far, used to narrow down the next one.
+    // Only the newest Channel::MESSAGE_LIMIT are kept.
+    std::vector<MessagePtr> matches_;
+    bool matchesDropped_ = false;
+    // Query of the current search, and whether it went through all messages
+    QString query_;
+    bool searchFinished_ = false;
+    // Set to stop the current search once it's outdated
+    std::shared_ptr<std::atomic<bool>> cancelSearch_;
 };
 
 }  // namespace chatterino
@@ -0,0 +1,79 @@
+#include "widgets/helper/ViewSuspension.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace chatterino {
+
+bool ViewSuspension::isSuspended() const
+{
+    return this->suspended_;
+}
+
+void ViewSuspension::suspend()
+{
+    this->suspended_ = true;
+}
+
+bool ViewSuspension::miss(size_t count)
+{
+    if (!this->suspended_)
+    {
+        return false;
+    }
+
+    this->missed_ += count;
+    return true;
+}
+
+size_t ViewSuspension::missedCount() const
+{
+    return this->missed_;
+}
+
+void ViewSuspension::clearMissed()
+{
+    this->missed_ = 0;
+}
+
+std::vector<MessagePtr> ViewSuspension::resume(
+    const LimitedQueueSnapshot<MessagePtr> &channelMessages)
+{
+    this->suspended_ = false;
+
+    auto count = std::min(this->missed_, channelMessages.size());
+    this->missed_ = 0;
+
+    std::vector<MessagePtr> missed;
+    missed.reserve(count);
+    for (auto i = channelMessages.size() - count; i < channelMessages.size();
+         i++)
+    {
+        missed.push_back(channelMessages[i]);
+    }
+
+    return missed;
+}
+
+boost::optional<size_t> ViewSuspension::layoutIndex(size_t channelIndex,
+                                                    size_t layoutCount,
+                                                    size_t channelSize) const
+{
+    if (this->missed_ == 0)
+    {
+        return channelIndex;
+    }
+
+    // Both the channel and the view end with the newest message, so line
+    // them up from the end
+    auto viewSize = int64_t(layoutCount) + int64_t(this->missed_);
+    auto index = int64_t(channelIndex) + viewSize - int64_t(channelSize);
+    if (index < 0 || index >= int64_t(layoutCount))
+    {
+        return boost::none;
+    }
+
+    return size_t(index);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+// Hidden views don't create layouts or scrollbar highlights for new messages,
+// they only count them. The missed messages are the newest ones of the
+// channel and get added once the view is shown again.
+class ViewSuspension
+{
+public:
+    bool isSuspended() const;
+    void suspend();
+
+    // Counts `count` new messages if the view is suspended. Returns false if
+    // the view isn't suspended and has to add them itself.
+    bool miss(size_t count);
+    size_t missedCount() const;
+    // Forgets the missed messages, e.g. once the view was cleared
+    void clearMissed();
+
+    // Stops counting and returns the missed messages, taken from the end of
+    // `channelMessages`, oldest first
+    std::vector<MessagePtr> resume(
+        const LimitedQueueSnapshot<MessagePtr> &channelMessages);
+
+    // Returns the index of the layout of the channel's message at
+    // `channelIndex`, or boost::none if it was missed. The view has
+    // `layoutCount` layouts and the channel `channelSize` messages.
+    boost::optional<size_t> layoutIndex(size_t channelIndex,
+                                        size_t layoutCount,
+                                        size_t channelSize) const;
+
+private:
+    bool suspended_ = true;
+    size_t missed_ = 0;
+};
+
+}  // namespace chatterino
@@ -261,6 +261,9 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         [](auto args) {
             return fuzzyToInt(args.value, 0);
         });
+    layout.addIntInput(
+        "Messages kept per channel (all but the last 1000 are kept on disk)",
+        s.scrollbackLimit, 1000, 500000, 1000);
     layout.addSeperator();
     layout.addCheckbox("Draw a line below the most recent message before "
                        "switching applications.",
@@ -677,6 +680,11 @@ void GeneralPage::initLayout(GeneralPageView &layout)
     layout.addIntInput("Max number of history messages to load on connect",
                        s.twitchMessageHistoryLimit, 10, 800, 10);
 
+    layout.addCheckbox(
+        "Join channels in hidden tabs when they are first shown (faster "
+        "startup)",
+        s.lazyChannelActivation);
+
     layout.addCheckbox("Enable experimental IRC support (requires restart)",
                        s.enableExperimentalIrc);
     layout.addCheckbox("Show unhandled IRC messages",
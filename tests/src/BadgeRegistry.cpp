@@ -0,0 +1,81 @@
+#include "providers/BadgeRegistry.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+BadgeRegistry::Assignment assign(uint64_t userId, MessageElementFlag flag)
+{
+    return {userId, {nullptr, flag, {}}};
+}
+
+}  // namespace
+
+TEST(BadgeRegistry, ParseUserId)
+{
+    EXPECT_EQ(BadgeRegistry::parseUserId("11148817"), uint64_t(11148817));
+    EXPECT_EQ(BadgeRegistry::parseUserId("18446744073709551615"),
+              uint64_t(18446744073709551615ULL));
+    EXPECT_FALSE(BadgeRegistry::parseUserId(""));
+    EXPECT_FALSE(BadgeRegistry::parseUserId("pajlada"));
+}
+
+TEST(BadgeRegistry, BadgesAreOrderedBySource)
+{
+    BadgeRegistry registry;
+
+    registry.setBadges(BadgeRegistry::Source::Ffz,
+                       {
+                           assign(3, MessageElementFlag::BadgeFfz),
+                           assign(1, MessageElementFlag::BadgeFfz),
+                       });
+    registry.setBadges(BadgeRegistry::Source::Chatterino,
+                       {
+                           assign(1, MessageElementFlag::BadgeChatterino),
+                           assign(2, MessageElementFlag::BadgeChatterino),
+                       });
+
+    auto badges = registry.getBadges("1");
+    ASSERT_EQ(badges.size(), 2);
+    EXPECT_EQ(badges[0].flag, MessageElementFlag::BadgeChatterino);
+    EXPECT_EQ(badges[1].flag, MessageElementFlag::BadgeFfz);
+
+    ASSERT_EQ(registry.getBadges("2").size(), 1);
+    ASSERT_EQ(registry.getBadges("3").size(), 1);
+    EXPECT_TRUE(registry.getBadges("4").empty());
+    EXPECT_TRUE(registry.getBadges("").empty());
+
+    // Publishing a source again replaces all of its badges
+    registry.setBadges(BadgeRegistry::Source::Ffz, {});
+
+    badges = registry.getBadges("1");
+    ASSERT_EQ(badges.size(), 1);
+    EXPECT_EQ(badges[0].flag, MessageElementFlag::BadgeChatterino);
+    EXPECT_TRUE(registry.getBadges("3").empty());
+}
+
+TEST(BadgeRegistry, LastBadgeOfSourceWins)
+{
+    BadgeRegistry registry;
+
+    registry.setBadges(BadgeRegistry::Source::Ffz,
+                       {
+                           assign(1, MessageElementFlag::BadgeFfz),
+                           assign(2, MessageElementFlag::BadgeFfz),
+                           assign(1, MessageElementFlag::BadgeChatterino),
+                       });
+    registry.setBadges(BadgeRegistry::Source::Seventv,
+                       {
+                           assign(1, MessageElementFlag::BadgeSeventv),
+                       });
+
+    // One badge per source, the one assigned last
+    auto badges = registry.getBadges("1");
+    ASSERT_EQ(badges.size(), 2);
+    EXPECT_EQ(badges[0].flag, MessageElementFlag::BadgeSeventv);
+    EXPECT_EQ(badges[1].flag, MessageElementFlag::BadgeChatterino);
+
+    ASSERT_EQ(registry.getBadges("2").size(), 1);
+}
@@ -0,0 +1,254 @@
+#include "providers/twitch/api/Helix.hpp"
+
+#include "util/Metrics.hpp"
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrlQuery>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+using namespace chatterino;
+
+namespace {
+
+// Stand-in for the Get Users endpoint of Helix that knows two users, or
+// rejects every request if `failing` is set
+class StandInHelix
+{
+public:
+    explicit StandInHelix(bool failing)
+        : failing_(failing)
+    {
+        // Sockets are served by the event loop of the GUI thread
+        QMetaObject::invokeMethod(
+            qApp,
+            [this] {
+                this->start();
+            },
+            Qt::BlockingQueuedConnection);
+    }
+
+    ~StandInHelix()
+    {
+        QMetaObject::invokeMethod(
+            qApp,
+            [this] {
+                delete this->server_;
+            },
+            Qt::BlockingQueuedConnection);
+    }
+
+    // Base url to pass to Helix
+    QString url() const
+    {
+        return QString("http://127.0.0.1:%1/helix/").arg(this->port_);
+    }
+
+    int requests() const
+    {
+        return this->requests_;
+    }
+
+private:
+    void start()
+    {
+        this->server_ = new QTcpServer;
+        this->server_->listen(QHostAddress::LocalHost);
+        this->port_ = this->server_->serverPort();
+
+        QObject::connect(this->server_, &QTcpServer::newConnection, [this] {
+            while (auto *socket = this->server_->nextPendingConnection())
+            {
+                this->serve(socket);
+            }
+        });
+    }
+
+    void serve(QTcpSocket *socket)
+    {
+        auto received = std::make_shared<QByteArray>();
+
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [=] {
+            received->append(socket->readAll());
+            if (!received->endsWith("\r\n\r\n"))
+            {
+                return;
+            }
+
+            this->requests_++;
+
+            // GET /helix/users?id=...&login=... HTTP/1.1
+            auto target = received->split(' ').value(1);
+            QUrlQuery query(QUrl(QString::fromUtf8(target)));
+
+            QByteArray status = "200 OK";
+            QJsonArray users;
+            if (this->failing_)
+            {
+                status = "401 Unauthorized";
+            }
+            else
+            {
+                for (const auto &[id, login] : KNOWN_USERS)
+                {
+                    if (query.allQueryItemValues("id").contains(id) ||
+                        query.allQueryItemValues("login").contains(login))
+                    {
+                        users.append(QJsonObject{{"id", id},
+                                                 {"login", login},
+                                                 {"display_name", login}});
+                    }
+                }
+            }
+
+            auto body = QJsonDocument(QJsonObject{{"data", users}}).toJson();
+            socket->write("HTTP/1.1 " + status +
+                          "\r\n"
+                          "Content-Type: application/json\r\n"
+                          "Connection: close\r\n"
+                          "Content-Length: " +
+                          QByteArray::number(body.size()) + "\r\n\r\n" +
+                          body);
+            socket->disconnectFromHost();
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket,
+                         &QObject::deleteLater);
+    }
+
+    static inline const std::vector<std::pair<QString, QString>> KNOWN_USERS{
+        {"11148817", "pajlada"},
+        {"22484632", "forsen"},
+    };
+
+    const bool failing_;
+    QTcpServer *server_ = nullptr;
+    quint16 port_ = 0;
+    std::atomic<int> requests_{0};
+};
+
+// Counts the callbacks of user lookups and waits for all of them
+class LookupWaiter
+{
+public:
+    explicit LookupWaiter(int expected)
+        : expected_(expected)
+    {
+    }
+
+    ResultCallback<HelixUser> onSuccess()
+    {
+        return [this](const HelixUser &) {
+            this->done(this->successes_);
+        };
+    }
+
+    HelixFailureCallback onFailure()
+    {
+        return [this] {
+            this->done(this->failures_);
+        };
+    }
+
+    void wait()
+    {
+        std::unique_lock lock(this->mutex_);
+        this->condition_.wait(lock, [this] {
+            return this->successes_ + this->failures_ >= this->expected_;
+        });
+    }
+
+    int successes() const
+    {
+        return this->successes_;
+    }
+
+    int failures() const
+    {
+        return this->failures_;
+    }
+
+private:
+    void done(int &counter)
+    {
+        {
+            std::unique_lock lock(this->mutex_);
+            counter++;
+        }
+        this->condition_.notify_one();
+    }
+
+    const int expected_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    int successes_ = 0;
+    int failures_ = 0;
+};
+
+}  // namespace
+
+TEST(Helix, BatchesUserLookups)
+{
+    StandInHelix server(false);
+    Helix helix(server.url());
+    LookupWaiter waiter(6);
+
+    auto &saved = Metrics::counter("helix requests saved");
+    auto savedBefore = saved.value();
+
+    helix.getUserByName("pajlada", waiter.onSuccess(), waiter.onFailure());
+    helix.getUserByName("forsen", waiter.onSuccess(), waiter.onFailure());
+    helix.getUserByName("PAJLADA", waiter.onSuccess(), waiter.onFailure());
+    helix.getUserById("11148817", waiter.onSuccess(), waiter.onFailure());
+    // Unknown to the server
+    helix.getUserByName("nobody", waiter.onSuccess(), waiter.onFailure());
+    // Malformed logins fail right away instead of failing the whole batch
+    helix.getUserByName("not a login", waiter.onSuccess(),
+                        waiter.onFailure());
+
+    waiter.wait();
+
+    // Every lookup is resolved exactly once
+    EXPECT_EQ(waiter.successes(), 4);
+    EXPECT_EQ(waiter.failures(), 2);
+
+    // One request for the ids and one for the logins. The duplicate login
+    // shares the request of the first one, and the three distinct logins
+    // were sent in one batch.
+    EXPECT_EQ(server.requests(), 2);
+    EXPECT_EQ(saved.value() - savedBefore, 3);
+
+    // Found users are cached
+    LookupWaiter cached(1);
+    helix.getUserByName("forsen", cached.onSuccess(), cached.onFailure());
+    cached.wait();
+    EXPECT_EQ(cached.successes(), 1);
+    EXPECT_EQ(server.requests(), 2);
+}
+
+TEST(Helix, FailedBatchFailsEveryLookup)
+{
+    StandInHelix server(true);
+    Helix helix(server.url());
+    LookupWaiter waiter(3);
+
+    helix.getUserByName("pajlada", waiter.onSuccess(), waiter.onFailure());
+    helix.getUserByName("forsen", waiter.onSuccess(), waiter.onFailure());
+    helix.getUserByName("nobody", waiter.onSuccess(), waiter.onFailure());
+
+    waiter.wait();
+
+    EXPECT_EQ(waiter.successes(), 0);
+    EXPECT_EQ(waiter.failures(), 3);
+
+    // The rejected batch isn't split into a request per login
+    EXPECT_EQ(server.requests(), 1);
+}
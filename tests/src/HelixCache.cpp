@@ -0,0 +1,54 @@
+#include "providers/twitch/api/HelixCache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+TEST(HelixCache, HitsAndMisses)
+{
+    HelixCache<int> cache("test hits", 1h);
+
+    auto &hits = Metrics::counter("helix cache hit (test hits)");
+    auto &misses = Metrics::counter("helix cache miss (test hits)");
+
+    EXPECT_EQ(cache.get("a"), boost::none);
+    EXPECT_EQ(misses.value(), 1);
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    EXPECT_EQ(cache.get("a"), 1);
+    EXPECT_EQ(cache.get("b"), 2);
+    EXPECT_EQ(hits.value(), 2);
+
+    // Inserting again replaces the value
+    cache.insert("a", 3);
+    EXPECT_EQ(cache.get("a"), 3);
+}
+
+TEST(HelixCache, Clear)
+{
+    HelixCache<int> cache("test clear", 1h);
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    cache.clear();
+
+    EXPECT_EQ(cache.get("a"), boost::none);
+    EXPECT_EQ(cache.get("b"), boost::none);
+
+    cache.insert("a", 3);
+    EXPECT_EQ(cache.get("a"), 3);
+}
+
+TEST(HelixCache, Expires)
+{
+    HelixCache<int> cache("test expiry", 0s);
+
+    cache.insert("a", 1);
+    std::this_thread::sleep_for(1ms);
+
+    EXPECT_EQ(cache.get("a"), boost::none);
+}
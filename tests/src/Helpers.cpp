@@ -20,3 +20,34 @@ TEST(Helpers, formatUserMention)
     // A user mention that is neither the first word, nor has 'mention with comma' enabled should not have a comma appended at the end.
     EXPECT_EQ(formatUserMention(userName, false, false), "pajlada");
 }
+
+TEST(Helpers, splitListIntoBatches)
+{
+    // An empty list results in no batches
+    EXPECT_TRUE(splitListIntoBatches({}).empty());
+
+    QStringList list;
+    for (int i = 0; i < 250; i++)
+    {
+        list.append(QString::number(i));
+    }
+
+    auto batches = splitListIntoBatches(list);
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_EQ(batches[0].size(), 100);
+    EXPECT_EQ(batches[1].size(), 100);
+    EXPECT_EQ(batches[2].size(), 50);
+    EXPECT_EQ(batches[0].front(), "0");
+    EXPECT_EQ(batches[1].front(), "100");
+    EXPECT_EQ(batches[2].back(), "249");
+
+    // A list that fits exactly into one batch is not split
+    batches = splitListIntoBatches(list.mid(0, 100));
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0], list.mid(0, 100));
+
+    // Custom batch sizes
+    batches = splitListIntoBatches(list.mid(0, 5), 2);
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_EQ(batches[2], QStringList{"4"});
+}
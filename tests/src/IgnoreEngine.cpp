@@ -0,0 +1,123 @@
+#include "controllers/ignores/IgnoreEngine.hpp"
+
+#include "controllers/ignores/IgnorePhrase.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+IgnoreEngine makeEngine(std::vector<IgnorePhrase> phrases)
+{
+    return IgnoreEngine(
+        std::make_shared<std::vector<IgnorePhrase>>(std::move(phrases)));
+}
+
+}  // namespace
+
+TEST(IgnoreEngine, ReplacesPlainPhrases)
+{
+    auto engine = makeEngine({
+        {"foo", false, false, "bar", true},
+        {"BAZ", false, false, "x", false},
+    });
+
+    auto result = engine.replace("foo baz Foo baZ");
+    EXPECT_EQ(result.text, "bar x Foo x");
+
+    ASSERT_EQ(result.replacements.size(), 3U);
+    EXPECT_EQ(result.replacements[0].from, 0);
+    EXPECT_EQ(result.replacements[0].length, 3);
+    EXPECT_EQ(result.replacements[0].outputFrom, 0);
+    EXPECT_EQ(result.replacements[0].outputLength, 3);
+    EXPECT_EQ(result.replacements[1].from, 4);
+    EXPECT_EQ(result.replacements[1].outputFrom, 4);
+    EXPECT_EQ(result.replacements[1].outputLength, 1);
+    EXPECT_EQ(result.replacements[2].from, 12);
+    EXPECT_EQ(result.replacements[2].outputFrom, 10);
+}
+
+TEST(IgnoreEngine, EscapesPlainPhrases)
+{
+    auto engine = makeEngine({
+        {"a.c", false, false, "x", true},
+    });
+
+    EXPECT_EQ(engine.replace("abc a.c").text, "abc x");
+}
+
+TEST(IgnoreEngine, KeepsCaptureGroups)
+{
+    auto engine = makeEngine({
+        {"(\\w+)@(\\w+)", true, false, "\\2 at \\1", true},
+        {"(?:no)+", true, false, "yes", true},
+    });
+
+    EXPECT_EQ(engine.replace("a@b nono c@d").text, "b at a yes d at c");
+}
+
+TEST(IgnoreEngine, ReplacesWithContextOfWholeMessage)
+{
+    auto engine = makeEngine({
+        {"(?<=@)\\w+", true, false, "user", true},
+        {"\\w+(?= says)", true, false, "\\0!", true},
+        {"^(\\w)\\w*$", true, false, "\\1", true},
+    });
+
+    // Lookarounds and anchors see the whole message, not only the match
+    EXPECT_EQ(engine.replace("hi @bob").text, "hi @user");
+    EXPECT_EQ(engine.replace("alice says hi").text, "alice! says hi");
+    EXPECT_EQ(engine.replace("hello").text, "h");
+    EXPECT_EQ(engine.replace("hello there").text, "hello there");
+}
+
+TEST(IgnoreEngine, EarliestMatchWins)
+{
+    auto engine = makeEngine({
+        {"bcd", false, false, "1", true},
+        {"abc", false, false, "2", true},
+        {"b", false, false, "3", true},
+    });
+
+    // "abc" starts first, then "bcd" can't match anymore
+    EXPECT_EQ(engine.replace("abcd").text, "2d");
+    // Same start, the phrase that comes first wins
+    EXPECT_EQ(engine.replace("bcd b").text, "1 3");
+}
+
+TEST(IgnoreEngine, SkipsEmptyAndInvalidPhrases)
+{
+    auto engine = makeEngine({
+        {"", false, false, "x", true},
+        {"(", true, false, "x", true},
+        {"a*", true, false, "x", true},
+        {"b", false, false, "y", true},
+    });
+
+    auto result = engine.replace("bcb");
+    EXPECT_EQ(result.text, "ycy");
+    EXPECT_EQ(result.replacements.size(), 2U);
+
+    EXPECT_EQ(engine.replace("").text, "");
+}
+
+TEST(IgnoreEngine, FindsBlockPhrases)
+{
+    auto engine = makeEngine({
+        {"replace", false, false, "x", true},
+        {"spam", false, true, "", false},
+        {"\\d{5}", true, true, "", true},
+    });
+
+    EXPECT_EQ(engine.findBlock("replace me"), nullptr);
+    EXPECT_EQ(engine.findBlock("nothing here"), nullptr);
+
+    const auto *phrase = engine.findBlock("buy SPAM now");
+    ASSERT_NE(phrase, nullptr);
+    EXPECT_EQ(phrase->getPattern(), "spam");
+
+    phrase = engine.findBlock("call 12345");
+    ASSERT_NE(phrase, nullptr);
+    EXPECT_EQ(phrase->getPattern(), "\\d{5}");
+}
@@ -0,0 +1,219 @@
+#include "providers/LinkResolver.hpp"
+
+#include "singletons/Settings.hpp"
+#include "util/Metrics.hpp"
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+// Answers every request like the link resolver would, links containing
+// "unknown" aren't known to it. Answers are delayed, so lookups made right
+// after each other find the first request running.
+class StandInResolver
+{
+public:
+    StandInResolver()
+    {
+        // Sockets are served by the event loop of the GUI thread
+        QMetaObject::invokeMethod(
+            qApp,
+            [this] {
+                this->start();
+            },
+            Qt::BlockingQueuedConnection);
+    }
+
+    ~StandInResolver()
+    {
+        QMetaObject::invokeMethod(
+            qApp,
+            [this] {
+                delete this->server_;
+            },
+            Qt::BlockingQueuedConnection);
+    }
+
+    // For LinkResolver::setResolverUrl
+    QString url() const
+    {
+        return QString("http://127.0.0.1:%1/").arg(this->port_) + "%1";
+    }
+
+    int requests() const
+    {
+        return this->requests_;
+    }
+
+private:
+    void start()
+    {
+        this->server_ = new QTcpServer;
+        this->server_->listen(QHostAddress::LocalHost);
+        this->port_ = this->server_->serverPort();
+
+        QObject::connect(this->server_, &QTcpServer::newConnection, [this] {
+            while (auto *socket = this->server_->nextPendingConnection())
+            {
+                this->serve(socket);
+            }
+        });
+    }
+
+    void serve(QTcpSocket *socket)
+    {
+        auto received = std::make_shared<QByteArray>();
+
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [=] {
+            received->append(socket->readAll());
+            if (!received->endsWith("\r\n\r\n"))
+            {
+                return;
+            }
+
+            this->requests_++;
+            auto known = !received->contains("unknown");
+            QTimer::singleShot(200, socket, [socket, known] {
+                QByteArray body =
+                    known ? R"({"status": 200, "tooltip": "Stand-in",)"
+                            R"( "link": "https://example.com/",)"
+                            R"( "thumbnail": ""})"
+                          : R"({"status": 404, "message": "Unknown"})";
+                socket->write("HTTP/1.1 200 OK\r\n"
+                              "Content-Type: application/json\r\n"
+                              "Connection: close\r\n"
+                              "Content-Length: " +
+                              QByteArray::number(body.size()) +
+                              "\r\n\r\n" + body);
+                socket->disconnectFromHost();
+            });
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket,
+                         &QObject::deleteLater);
+    }
+
+    QTcpServer *server_ = nullptr;
+    quint16 port_ = 0;
+    std::atomic<int> requests_{0};
+};
+
+// Link info is only resolved with the setting enabled
+void initSettings()
+{
+    static QTemporaryDir settingsDirectory;
+
+    // Settings are created on the GUI thread, like the other singletons
+    QMetaObject::invokeMethod(
+        qApp,
+        [] {
+            static auto *settings = new Settings(settingsDirectory.path());
+            settings->linkInfoTooltip = true;
+        },
+        Qt::BlockingQueuedConnection);
+}
+
+// Collects the tooltips of lookups and waits for them
+class LookupWaiter
+{
+public:
+    LinkResolver::Callback callback()
+    {
+        return [this](QString tooltip, Link /*link*/, ImagePtr /*thumbnail*/) {
+            {
+                std::unique_lock lock(this->mutex_);
+                this->tooltips_.push_back(tooltip);
+            }
+            this->condition_.notify_one();
+        };
+    }
+
+    std::vector<QString> wait(size_t count)
+    {
+        std::unique_lock lock(this->mutex_);
+        this->condition_.wait(lock, [this, count] {
+            return this->tooltips_.size() >= count;
+        });
+
+        return this->tooltips_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<QString> tooltips_;
+};
+
+}  // namespace
+
+TEST(LinkResolver, HoverPromotesPrefetch)
+{
+    StandInResolver resolver;
+    LinkResolver::setResolverUrl(resolver.url());
+    initSettings();
+
+    auto &saved = Metrics::counter("link info requests saved");
+    auto &promoted = Metrics::counter("link info requests promoted");
+    auto &merged = Metrics::counter("http request merged");
+    auto savedBefore = saved.value();
+    auto promotedBefore = promoted.value();
+    auto mergedBefore = merged.value();
+
+    LookupWaiter waiter;
+    auto lookup = [&](NetworkRequestPriority priority) {
+        LinkResolver::getLinkInfo("https://example.com/hover", nullptr,
+                                  waiter.callback(), priority);
+    };
+
+    // The prefetch of MessageBuilder::addLink, followed by another one and
+    // a hover
+    lookup(NetworkRequestPriority::Background);
+    lookup(NetworkRequestPriority::Background);
+    lookup(NetworkRequestPriority::Interactive);
+
+    EXPECT_EQ(waiter.wait(3), std::vector<QString>(3, "Stand-in"));
+    EXPECT_EQ(saved.value() - savedBefore, 2);
+    // Only the hover is more urgent than the prefetch
+    EXPECT_EQ(promoted.value() - promotedBefore, 1);
+    // The reissued request joined the running one
+    EXPECT_EQ(merged.value() - mergedBefore, 1);
+    EXPECT_EQ(resolver.requests(), 1);
+
+    // Resolved urls aren't requested again
+    lookup(NetworkRequestPriority::Interactive);
+    EXPECT_EQ(waiter.wait(4).size(), 4U);
+    EXPECT_EQ(resolver.requests(), 1);
+}
+
+TEST(LinkResolver, UnknownLinksAreNotCached)
+{
+    StandInResolver resolver;
+    LinkResolver::setResolverUrl(resolver.url());
+    initSettings();
+
+    LookupWaiter waiter;
+    auto lookup = [&] {
+        LinkResolver::getLinkInfo("https://example.com/unknown", nullptr,
+                                  waiter.callback());
+    };
+
+    lookup();
+    EXPECT_EQ(waiter.wait(1), std::vector<QString>{"Unknown"});
+
+    // The resolver might know the link later on
+    lookup();
+    EXPECT_EQ(waiter.wait(2), std::vector<QString>(2, "Unknown"));
+    EXPECT_EQ(resolver.requests(), 2);
+}
@@ -0,0 +1,122 @@
+#include "messages/MessageAuthorIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(const QString &loginName,
+                       const QString &timeoutUser = {})
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = loginName;
+    message->timeoutUser = timeoutUser;
+    return message;
+}
+
+}  // namespace
+
+TEST(MessageAuthorIndex, FindIsCaseInsensitive)
+{
+    MessageAuthorIndex index;
+
+    auto a = makeMessage("pajlada");
+    auto b = makeMessage("forsen");
+    auto c = makeMessage("", "pajlada");
+
+    index.append(a);
+    index.append(b);
+    index.append(c);
+
+    auto found = index.find("PajLada");
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[0], a);
+    EXPECT_EQ(found[1], c);
+
+    EXPECT_TRUE(index.find("zneix").empty());
+}
+
+TEST(MessageAuthorIndex, KeepsChannelOrder)
+{
+    MessageAuthorIndex index;
+
+    auto a = makeMessage("pajlada");
+    auto b = makeMessage("pajlada");
+    auto c = makeMessage("pajlada");
+    auto d = makeMessage("pajlada");
+
+    index.append(c);
+    index.append(d);
+    index.prepend({a, b});
+
+    auto found = index.find("pajlada");
+    ASSERT_EQ(found.size(), 4);
+    EXPECT_EQ(found[0], a);
+    EXPECT_EQ(found[1], b);
+    EXPECT_EQ(found[2], c);
+    EXPECT_EQ(found[3], d);
+}
+
+TEST(MessageAuthorIndex, RemoveOldest)
+{
+    MessageAuthorIndex index;
+
+    auto a = makeMessage("pajlada");
+    auto b = makeMessage("forsen");
+    auto c = makeMessage("pajlada");
+
+    index.append(a);
+    index.append(b);
+    index.append(c);
+
+    index.removeOldest(a);
+    index.removeOldest(b);
+
+    auto found = index.find("pajlada");
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0], c);
+    EXPECT_TRUE(index.find("forsen").empty());
+}
+
+TEST(MessageAuthorIndex, Replace)
+{
+    MessageAuthorIndex index;
+
+    auto a = makeMessage("pajlada");
+    auto b = makeMessage("", "pajlada");
+    auto c = makeMessage("pajlada");
+    auto replacement = makeMessage("", "pajlada");
+
+    index.append(a);
+    index.append(b);
+    index.append(c);
+
+    index.replace(b, replacement);
+
+    auto found = index.find("pajlada");
+    ASSERT_EQ(found.size(), 3);
+    EXPECT_EQ(found[0], a);
+    EXPECT_EQ(found[1], replacement);
+    EXPECT_EQ(found[2], c);
+}
+
+TEST(MessageAuthorIndex, WithinLast)
+{
+    MessageAuthorIndex index;
+
+    auto a = makeMessage("pajlada");
+    auto b = makeMessage("forsen");
+    auto c = makeMessage("pajlada");
+
+    index.append(a);
+    index.append(b);
+    index.append(c);
+
+    EXPECT_EQ(index.find("pajlada", 1).size(), 1);
+    EXPECT_EQ(index.find("pajlada", 2).size(), 1);
+    EXPECT_EQ(index.find("pajlada", 3).size(), 2);
+    EXPECT_TRUE(index.find("forsen", 1).empty());
+}
@@ -0,0 +1,106 @@
+#include "widgets/helper/MessageHeightTree.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+TEST(MessageHeightTree, HeightBetween)
+{
+    MessageHeightTree tree;
+
+    tree.pushBack(10);
+    tree.pushBack(20);
+    tree.pushBack(30);
+    tree.pushFront(5);
+
+    ASSERT_EQ(tree.size(), 4);
+    EXPECT_EQ(tree.firstSequence(), -1);
+    EXPECT_EQ(tree.endSequence(), 3);
+
+    EXPECT_EQ(tree.heightBetween(-1, 3), 65);
+    EXPECT_EQ(tree.heightBetween(0, 2), 30);
+    EXPECT_EQ(tree.heightBetween(2, 2), 0);
+    // Clamped to the messages in the tree
+    EXPECT_EQ(tree.heightBetween(-100, 100), 65);
+
+    tree.set(1, 25);
+    EXPECT_EQ(tree.get(1), 25);
+    EXPECT_EQ(tree.heightBetween(-1, 3), 70);
+
+    tree.trimFront(1);
+    EXPECT_EQ(tree.firstSequence(), 1);
+    EXPECT_EQ(tree.get(0), 0);
+    EXPECT_EQ(tree.heightBetween(-1, 3), 55);
+
+    tree.clear();
+    EXPECT_EQ(tree.size(), 0);
+    EXPECT_EQ(tree.heightBetween(0, 3), 0);
+}
+
+TEST(MessageHeightTree, Find)
+{
+    MessageHeightTree tree;
+
+    tree.pushBack(10);
+    tree.pushBack(0);
+    tree.pushBack(20);
+    tree.pushBack(30);
+
+    auto expectPosition = [&](int64_t from, int64_t offset, int64_t sequence,
+                              int inside) {
+        auto position = tree.find(from, offset);
+        EXPECT_EQ(position.sequence, sequence) << from << " " << offset;
+        EXPECT_EQ(position.offset, inside) << from << " " << offset;
+    };
+
+    expectPosition(0, 0, 0, 0);
+    expectPosition(0, 9, 0, 9);
+    // Messages without a height are skipped
+    expectPosition(0, 10, 2, 0);
+    expectPosition(0, 35, 3, 5);
+    expectPosition(3, -5, 2, 15);
+    expectPosition(0, -5, 0, 0);
+    expectPosition(0, 60, 4, 0);
+    expectPosition(2, 100, 4, 0);
+}
+
+TEST(MessageHeightTree, WrapsAroundAndGrows)
+{
+    MessageHeightTree tree;
+
+    // Keep a window of 100 messages while moving through the ring
+    for (int i = 0; i < 5000; i++)
+    {
+        tree.pushBack(i % 7 + 1);
+        tree.trimFront(tree.endSequence() - 100);
+    }
+
+    ASSERT_EQ(tree.size(), 100);
+
+    int64_t expected = 0;
+    for (int i = 4900; i < 5000; i++)
+    {
+        expected += i % 7 + 1;
+    }
+    EXPECT_EQ(tree.heightBetween(tree.firstSequence(), tree.endSequence()),
+              expected);
+
+    auto last = tree.find(tree.firstSequence(), expected - 1);
+    EXPECT_EQ(last.sequence, 4999);
+    EXPECT_EQ(last.offset, 4999 % 7);
+
+    // More messages than fit into the initial ring
+    for (int i = 0; i < 3000; i++)
+    {
+        tree.pushFront(2);
+    }
+
+    ASSERT_EQ(tree.size(), 3100);
+    EXPECT_EQ(tree.heightBetween(tree.firstSequence(), 4900), 6000);
+    EXPECT_EQ(tree.heightBetween(tree.firstSequence(), tree.endSequence()),
+              6000 + expected);
+
+    auto position = tree.find(tree.firstSequence(), 5999);
+    EXPECT_EQ(position.sequence, 4899);
+    EXPECT_EQ(position.offset, 1);
+}
@@ -0,0 +1,74 @@
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include "messages/Message.hpp"
+#include "messages/layouts/MessageLayoutContainer.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+MessageLayoutCache::Key makeKey(const Message *message, int width)
+{
+    return {message, width, 1.F, 0, 0, 0, 0};
+}
+
+}  // namespace
+
+TEST(MessageLayoutCache, SharesContainers)
+{
+    MessageLayoutCache cache;
+    auto message = std::make_shared<Message>();
+
+    auto key = makeKey(message.get(), 300);
+    EXPECT_EQ(cache.find(key), nullptr);
+
+    auto container =
+        cache.insert(key, std::make_unique<MessageLayoutContainer>());
+    EXPECT_EQ(cache.find(key), container);
+    EXPECT_EQ(cache.size(), 1U);
+
+    // Different geometry, different layout
+    EXPECT_EQ(cache.find(makeKey(message.get(), 400)), nullptr);
+
+    auto other = std::make_shared<Message>();
+    EXPECT_EQ(cache.find(makeKey(other.get(), 300)), nullptr);
+}
+
+TEST(MessageLayoutCache, RemovesUnusedContainers)
+{
+    MessageLayoutCache cache;
+    auto message = std::make_shared<Message>();
+    auto key = makeKey(message.get(), 300);
+
+    auto first = cache.insert(key, std::make_unique<MessageLayoutContainer>());
+    auto second = cache.find(key);
+
+    first.reset();
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_EQ(cache.find(key), second);
+
+    second.reset();
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ(cache.find(key), nullptr);
+}
+
+TEST(MessageLayoutCache, KeepsReplacedEntries)
+{
+    MessageLayoutCache cache;
+    auto message = std::make_shared<Message>();
+    auto key = makeKey(message.get(), 300);
+
+    auto first = cache.insert(key, std::make_unique<MessageLayoutContainer>());
+    auto second =
+        cache.insert(key, std::make_unique<MessageLayoutContainer>());
+
+    // Dropping the replaced container doesn't remove the newer one
+    first.reset();
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_EQ(cache.find(key), second);
+
+    second.reset();
+    EXPECT_EQ(cache.size(), 0U);
+}
@@ -0,0 +1,202 @@
+#include "messages/MessageSpillStore.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+SpilledMessage makeMessage(size_t index)
+{
+    SpilledMessage message;
+    message.id = QString::number(index);
+    message.messageText = QString("message %1").arg(index);
+    message.searchText = "user: " + message.messageText;
+    message.loginName = "user";
+    message.displayName = "User";
+
+    return message;
+}
+
+std::vector<QString> ids(const std::vector<SpilledMessage> &messages)
+{
+    std::vector<QString> result;
+    for (const auto &message : messages)
+    {
+        result.push_back(message.id);
+    }
+
+    return result;
+}
+
+std::vector<QString> range(size_t from, size_t to)
+{
+    std::vector<QString> result;
+    for (auto i = from; i < to; i++)
+    {
+        result.push_back(QString::number(i));
+    }
+
+    return result;
+}
+
+}  // namespace
+
+TEST(MessageSpillStore, ReadsBackMessages)
+{
+    MessageSpillStore store;
+    store.setLimit(100);
+
+    auto message = makeMessage(0);
+    message.ircData = "@tmi-sent-ts=0 :user!user@user PRIVMSG #channel :hi";
+    message.flags.set(MessageFlag::Highlighted);
+    message.flags.set(MessageFlag::Disabled);
+    message.parseTime = QTime(12, 34, 56);
+    message.highlightColor = QColor(Qt::red);
+    message.badges = {{"subscriber", "12"}, {"premium", "1"}};
+    message.badgeInfos = {{"subscriber", "14"}};
+    store.append(message);
+
+    for (size_t i = 1; i < 10; i++)
+    {
+        store.append(makeMessage(i));
+    }
+
+    EXPECT_EQ(store.begin(), 0U);
+    EXPECT_EQ(store.end(), 10U);
+    EXPECT_EQ(store.size(), 10U);
+
+    EXPECT_EQ(ids(store.read(2, 5)), range(2, 5));
+    EXPECT_EQ(ids(store.read(8, 20)), range(8, 10));
+
+    auto read = store.read(0, 2);
+    ASSERT_EQ(read.size(), 2U);
+    EXPECT_EQ(read[0].ircData, message.ircData);
+    EXPECT_TRUE(read[0].flags.has(MessageFlag::Highlighted));
+    EXPECT_TRUE(read[0].flags.has(MessageFlag::Disabled));
+    EXPECT_FALSE(read[0].flags.has(MessageFlag::System));
+    EXPECT_EQ(read[0].parseTime, message.parseTime);
+    EXPECT_EQ(read[0].searchText, message.searchText);
+    EXPECT_EQ(read[0].highlightColor, QColor(Qt::red));
+    EXPECT_EQ(read[0].badges, message.badges);
+    EXPECT_EQ(read[0].badgeInfos, message.badgeInfos);
+    EXPECT_FALSE(read[1].highlightColor.isValid());
+    EXPECT_TRUE(read[1].badges.empty());
+}
+
+TEST(MessageSpillStore, TakesBackNewestMessages)
+{
+    MessageSpillStore store;
+    store.setLimit(100);
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        store.append(makeMessage(i));
+    }
+
+    EXPECT_EQ(ids(store.takeBack(3)), range(7, 10));
+    EXPECT_EQ(store.end(), 7U);
+
+    // Messages that are spilled again take the same place
+    for (size_t i = 7; i < 12; i++)
+    {
+        store.append(makeMessage(i));
+    }
+    EXPECT_EQ(ids(store.read(0, 100)), range(0, 12));
+
+    EXPECT_EQ(ids(store.takeBack(100)), range(0, 12));
+    EXPECT_EQ(store.size(), 0U);
+    EXPECT_TRUE(store.takeBack(1).empty());
+}
+
+TEST(MessageSpillStore, DropsOldestMessagesOverLimit)
+{
+    MessageSpillStore store;
+    store.setLimit(5);
+
+    for (size_t i = 0; i < 12; i++)
+    {
+        store.append(makeMessage(i));
+    }
+
+    EXPECT_EQ(store.begin(), 7U);
+    EXPECT_EQ(store.size(), 5U);
+    EXPECT_EQ(ids(store.read(0, 12)), range(7, 12));
+
+    store.setLimit(2);
+    EXPECT_EQ(ids(store.read(0, 12)), range(10, 12));
+
+    // A limit of 0 disables spilling
+    store.setLimit(0);
+    store.append(makeMessage(12));
+    EXPECT_EQ(store.size(), 0U);
+    EXPECT_TRUE(store.read(0, 20).empty());
+}
+
+TEST(MessageSpillStore, SpansSegments)
+{
+    constexpr auto count = MessageSpillStore::SEGMENT_SIZE + 10;
+
+    MessageSpillStore store;
+    store.setLimit(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        store.append(makeMessage(i));
+    }
+
+    auto boundary = MessageSpillStore::SEGMENT_SIZE;
+    EXPECT_EQ(ids(store.read(boundary - 5, boundary + 5)),
+              range(boundary - 5, boundary + 5));
+
+    EXPECT_EQ(ids(store.takeBack(20)), range(count - 20, count));
+    EXPECT_EQ(store.end(), count - 20);
+
+    store.append(makeMessage(count - 20));
+    EXPECT_EQ(ids(store.read(count - 25, count)),
+              range(count - 25, count - 19));
+
+    store.setLimit(100);
+    EXPECT_EQ(store.begin(), count - 119);
+    EXPECT_EQ(ids(store.read(0, count)), range(count - 119, count - 19));
+
+    // Fills the first segment and starts a new one
+    for (auto i = count - 19; i < count - 9; i++)
+    {
+        store.append(makeMessage(i));
+    }
+
+    // The first segment is dropped as a whole
+    store.setLimit(1);
+    EXPECT_EQ(ids(store.read(0, count)), range(count - 10, count - 9));
+    EXPECT_EQ(ids(store.takeBack(5)), range(count - 10, count - 9));
+}
+
+TEST(MessageSpillStore, SearchProxy)
+{
+    Message message;
+    message.id = "id";
+    message.messageText = "hello chat";
+    message.searchText = "user user: hello chat";
+    message.loginName = "user";
+    message.displayName = "User";
+    message.channelName = "channel";
+    message.flags.set(MessageFlag::FirstMessage);
+    message.badges.emplace_back("moderator", "1");
+
+    auto proxy = SpilledMessage::fromMessage(message).toSearchProxy();
+
+    EXPECT_EQ(proxy->id, message.id);
+    EXPECT_EQ(proxy->messageText, message.messageText);
+    EXPECT_EQ(proxy->searchText, message.searchText);
+    EXPECT_EQ(proxy->loginName, message.loginName);
+    EXPECT_EQ(proxy->displayName, message.displayName);
+    EXPECT_EQ(proxy->channelName, message.channelName);
+    EXPECT_TRUE(proxy->flags.has(MessageFlag::FirstMessage));
+    ASSERT_EQ(proxy->badges.size(), 1U);
+    EXPECT_EQ(proxy->badges[0].key_, "moderator");
+    EXPECT_EQ(proxy->highlightColor, nullptr);
+    EXPECT_TRUE(proxy->elements.empty());
+}
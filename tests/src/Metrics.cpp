@@ -0,0 +1,88 @@
+#include "util/Metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(Metrics, SameNameSameMetric)
+{
+    auto &a = Metrics::counter("test same name");
+    auto &b = Metrics::counter("test same name");
+
+    EXPECT_EQ(&a, &b);
+}
+
+TEST(Metrics, SumsAcrossThreads)
+{
+    auto &gauge = Metrics::gauge("test threads");
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++)
+    {
+        threads.emplace_back([&gauge] {
+            for (int j = 0; j < 1000; j++)
+            {
+                gauge.increase(2);
+                gauge.decrease();
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(gauge.value(), 8000);
+}
+
+TEST(Metrics, HistogramBuckets)
+{
+    auto &histogram = Metrics::histogram("test histogram");
+
+    // 90 fast ones and 10 slow ones
+    for (int i = 0; i < 90; i++)
+    {
+        histogram.record(std::chrono::microseconds(3));
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        histogram.record(std::chrono::milliseconds(3));
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 100u);
+    EXPECT_EQ(snapshot.sumMicroseconds, 90u * 3 + 10u * 3000);
+    EXPECT_EQ(snapshot.buckets[2], 90u);
+    EXPECT_EQ(snapshot.quantileMicroseconds(0.5), 4);
+    EXPECT_EQ(snapshot.quantileMicroseconds(0.9), 4);
+    EXPECT_EQ(snapshot.quantileMicroseconds(0.99), 4096);
+}
+
+TEST(Metrics, HistogramOverflow)
+{
+    auto &histogram = Metrics::histogram("test histogram overflow");
+
+    histogram.record(std::chrono::hours(1));
+    histogram.record(std::chrono::microseconds(-5));
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.buckets[Histogram::bucketCount - 1], 1u);
+    EXPECT_EQ(snapshot.buckets[0], 1u);
+}
+
+TEST(Metrics, PrometheusNames)
+{
+    Metrics::counter("Test: prometheus (names)").increase(3);
+    Metrics::gauge("test prometheus gauge").increase(5);
+
+    auto text = Metrics::toPrometheus();
+
+    EXPECT_TRUE(text.contains("# TYPE chatterino_test_prometheus_names_total "
+                              "counter\n"
+                              "chatterino_test_prometheus_names_total 3\n"));
+    EXPECT_TRUE(text.contains("# TYPE chatterino_test_prometheus_gauge gauge\n"
+                              "chatterino_test_prometheus_gauge 5\n"));
+}
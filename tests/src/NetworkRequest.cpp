@@ -6,6 +6,7 @@
 
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
+#include "util/Metrics.hpp"
 
 #include <gtest/gtest.h>
 
@@ -334,3 +335,151 @@ TEST(NetworkRequest, FinallyCallbackOnTimeout)
     EXPECT_FALSE(onSuccessCalled);
     EXPECT_TRUE(NetworkManager::workerThread.isRunning());
 }
+
+TEST(NetworkRequest, IdenticalRequestsBothSucceed)
+{
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+
+    auto url = "http://httpbin.org/delay/1";
+
+    std::mutex mut;
+    int requestsDone = 0;
+    std::condition_variable requestDoneCondition;
+
+    auto &merged = Metrics::counter("http request merged");
+    auto mergedBefore = merged.value();
+
+    // The second request gets merged into the first one, but both should
+    // still receive the response
+    for (int i = 0; i < 2; i++)
+    {
+        NetworkRequest(url)
+            .onSuccess([&](NetworkResult result) -> Outcome {
+                EXPECT_EQ(result.status(), 200);
+
+                {
+                    std::unique_lock lck(mut);
+                    requestsDone++;
+                }
+                requestDoneCondition.notify_one();
+                return Success;
+            })
+            .onError([&](NetworkResult result) {
+                EXPECT_TRUE(false);
+
+                {
+                    std::unique_lock lck(mut);
+                    requestsDone++;
+                }
+                requestDoneCondition.notify_one();
+            })
+            .execute();
+    }
+
+    // Wait for both requests to finish
+    std::unique_lock lck(mut);
+    requestDoneCondition.wait(lck, [&requestsDone] {
+        return requestsDone == 2;
+    });
+
+    EXPECT_EQ(merged.value() - mergedBefore, 1);
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+}
+
+TEST(NetworkRequest, DifferentCredentialsAreNotMerged)
+{
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+
+    auto url = "http://httpbin.org/headers";
+
+    std::mutex mut;
+    int requestsDone = 0;
+    std::condition_variable requestDoneCondition;
+
+    auto &merged = Metrics::counter("http request merged");
+    auto mergedBefore = merged.value();
+
+    // Same URL and header names, but each request must get the response to
+    // its own credentials
+    for (const QString token : {"Bearer a", "Bearer b"})
+    {
+        NetworkRequest(url)
+            .header("Authorization", token)
+            .onSuccess([&, token](NetworkResult result) -> Outcome {
+                auto headers = result.parseJson().value("headers").toObject();
+                EXPECT_EQ(headers.value("Authorization").toString(), token);
+
+                {
+                    std::unique_lock lck(mut);
+                    requestsDone++;
+                }
+                requestDoneCondition.notify_one();
+                return Success;
+            })
+            .onError([&](NetworkResult result) {
+                EXPECT_TRUE(false);
+
+                {
+                    std::unique_lock lck(mut);
+                    requestsDone++;
+                }
+                requestDoneCondition.notify_one();
+            })
+            .execute();
+    }
+
+    std::unique_lock lck(mut);
+    requestDoneCondition.wait(lck, [&requestsDone] {
+        return requestsDone == 2;
+    });
+
+    EXPECT_EQ(merged.value() - mergedBefore, 0);
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+}
+
+TEST(NetworkRequest, MergedRequestPromotesQueuedOne)
+{
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+
+    std::mutex mut;
+    int requestsDone = 0;
+    std::condition_variable requestDoneCondition;
+
+    auto &promoted = Metrics::counter("http request promoted");
+    auto promotedBefore = promoted.value();
+
+    auto request = [&](const QString &url, NetworkRequestPriority priority) {
+        NetworkRequest(url)
+            .priority(priority)
+            .finally([&] {
+                {
+                    std::unique_lock lck(mut);
+                    requestsDone++;
+                }
+                requestDoneCondition.notify_one();
+            })
+            .execute();
+    };
+
+    // Occupy every slot of the host, so the next requests are queued
+    for (int i = 0; i < 6; i++)
+    {
+        request(QString("http://httpbin.org/delay/1?slot=%1").arg(i),
+                NetworkRequestPriority::Interactive);
+    }
+
+    // The interactive request is merged into the queued background one,
+    // which should now be started before anything less urgent
+    request("http://httpbin.org/get?promoted",
+            NetworkRequestPriority::Background);
+    request("http://httpbin.org/get?promoted",
+            NetworkRequestPriority::Interactive);
+
+    std::unique_lock lck(mut);
+    requestDoneCondition.wait(lck, [&requestsDone] {
+        return requestsDone == 8;
+    });
+
+    EXPECT_EQ(promoted.value() - promotedBefore, 1);
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+}
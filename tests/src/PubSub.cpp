@@ -0,0 +1,30 @@
+#include "providers/twitch/PubsubClient.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+using detail::pickConnection;
+
+TEST(PubSub, PicksLeastLoadedConnection)
+{
+    EXPECT_EQ(pickConnection({30, 10, 20}, 1), size_t(1));
+    EXPECT_EQ(pickConnection({30, 10, 20}, 5), size_t(1));
+
+    // Connections without room for all topics are skipped
+    EXPECT_EQ(pickConnection({30, 45, 20}, 25), size_t(2));
+    EXPECT_EQ(pickConnection({48, 40}, 5), size_t(1));
+    EXPECT_EQ(pickConnection({48, 40}, 11), boost::none);
+    EXPECT_EQ(pickConnection({10, 20}, MAX_PUBSUB_LISTENS - 10), size_t(0));
+    EXPECT_EQ(pickConnection({10, 20}, MAX_PUBSUB_LISTENS - 9), boost::none);
+}
+
+TEST(PubSub, KeepsIdleConnectionsAsStandby)
+{
+    // Used connections are filled up before an idle one is picked
+    EXPECT_EQ(pickConnection({0, 40}, 10), size_t(1));
+    EXPECT_EQ(pickConnection({0, 45}, 10), size_t(0));
+    EXPECT_EQ(pickConnection({0}, MAX_PUBSUB_LISTENS), size_t(0));
+
+    EXPECT_EQ(pickConnection({}, 1), boost::none);
+    EXPECT_EQ(pickConnection({MAX_PUBSUB_LISTENS}, 1), boost::none);
+}
@@ -0,0 +1,164 @@
+#include "widgets/helper/ScrollbarMinimap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+using namespace chatterino;
+
+namespace {
+
+const auto red = std::make_shared<QColor>(Qt::red);
+const auto blue = std::make_shared<QColor>(Qt::blue);
+
+// Returns the (start, end, number of highlights) of every painted bucket
+std::vector<std::tuple<size_t, size_t, int>> buckets(
+    const ScrollbarMinimap &minimap)
+{
+    std::vector<std::tuple<size_t, size_t, int>> result;
+
+    minimap.forEachBucket([&](size_t start, size_t end, const auto &bucket) {
+        int count = 0;
+        for (const auto &entry : bucket)
+        {
+            count += entry.count;
+        }
+        result.emplace_back(start, end, count);
+    });
+
+    return result;
+}
+
+}  // namespace
+
+TEST(ScrollbarMinimap, GroupsHighlightsIntoBuckets)
+{
+    ScrollbarMinimap minimap(10);
+    minimap.setRowCount(5);
+    EXPECT_EQ(minimap.getBucketSize(), 2);
+
+    minimap.pushBack(ScrollbarHighlight(red));
+    minimap.pushBack(ScrollbarHighlight(red));
+    minimap.pushBack(ScrollbarHighlight());
+    minimap.pushBack(ScrollbarHighlight(blue));
+    minimap.pushBack(ScrollbarHighlight());
+
+    ASSERT_EQ(minimap.size(), 5);
+
+    using Buckets = std::vector<std::tuple<size_t, size_t, int>>;
+    EXPECT_EQ(buckets(minimap), (Buckets{{0, 2, 2}, {2, 4, 1}}));
+
+    // Equal highlights share an entry
+    minimap.forEachBucket([](size_t start, size_t, const auto &bucket) {
+        if (start == 0)
+        {
+            ASSERT_EQ(bucket.size(), 1);
+            EXPECT_EQ(bucket[0].count, 2);
+        }
+    });
+
+    // Changing the size of the buckets keeps every highlight
+    minimap.setRowCount(10);
+    EXPECT_EQ(minimap.getBucketSize(), 1);
+    EXPECT_EQ(buckets(minimap),
+              (Buckets{{0, 1, 1}, {1, 2, 1}, {3, 4, 1}}));
+}
+
+TEST(ScrollbarMinimap, EvictsOldestHighlights)
+{
+    ScrollbarMinimap minimap(4);
+    minimap.setRowCount(2);
+
+    minimap.pushBack(ScrollbarHighlight(red));
+    minimap.pushBack(ScrollbarHighlight());
+    minimap.pushBack(ScrollbarHighlight());
+    minimap.pushBack(ScrollbarHighlight());
+    minimap.pushBack(ScrollbarHighlight(blue));
+
+    ASSERT_EQ(minimap.size(), 4);
+    EXPECT_TRUE(minimap.at(0).isNull());
+    EXPECT_EQ(minimap.at(3).getColor(), QColor(Qt::blue));
+
+    // The first bucket lost its only highlight, the last one is partially
+    // filled
+    using Buckets = std::vector<std::tuple<size_t, size_t, int>>;
+    EXPECT_EQ(buckets(minimap), (Buckets{{3, 4, 1}}));
+}
+
+TEST(ScrollbarMinimap, PushFront)
+{
+    ScrollbarMinimap minimap(3);
+    minimap.setRowCount(3);
+
+    minimap.pushBack(ScrollbarHighlight(red));
+    minimap.pushFront({ScrollbarHighlight(blue), ScrollbarHighlight(),
+                       ScrollbarHighlight(blue)});
+
+    // Only the newest highlights fit
+    ASSERT_EQ(minimap.size(), 3);
+    EXPECT_TRUE(minimap.at(0).isNull());
+    EXPECT_EQ(minimap.at(1).getColor(), QColor(Qt::blue));
+    EXPECT_EQ(minimap.at(2).getColor(), QColor(Qt::red));
+
+    using Buckets = std::vector<std::tuple<size_t, size_t, int>>;
+    EXPECT_EQ(buckets(minimap), (Buckets{{1, 2, 1}, {2, 3, 1}}));
+}
+
+TEST(ScrollbarMinimap, GrowsForHighlightsAtStart)
+{
+    ScrollbarMinimap minimap(2, 4);
+    minimap.setRowCount(4);
+
+    minimap.pushBack(ScrollbarHighlight(red));
+    minimap.pushFront({ScrollbarHighlight(blue), ScrollbarHighlight(),
+                       ScrollbarHighlight(blue), ScrollbarHighlight()});
+
+    // Grows up to the max limit
+    ASSERT_EQ(minimap.size(), 4);
+    EXPECT_TRUE(minimap.at(0).isNull());
+    EXPECT_EQ(minimap.at(1).getColor(), QColor(Qt::blue));
+    EXPECT_EQ(minimap.at(3).getColor(), QColor(Qt::red));
+
+    // Every highlight added at the end shrinks it by one
+    minimap.pushBack(ScrollbarHighlight());
+    ASSERT_EQ(minimap.size(), 3);
+    EXPECT_EQ(minimap.at(1).getColor(), QColor(Qt::red));
+
+    minimap.pushBack(ScrollbarHighlight());
+    minimap.pushBack(ScrollbarHighlight());
+    EXPECT_EQ(minimap.size(), 2);
+
+    minimap.clear();
+    minimap.pushFront({ScrollbarHighlight(), ScrollbarHighlight(),
+                       ScrollbarHighlight()});
+    EXPECT_EQ(minimap.size(), 3);
+}
+
+TEST(ScrollbarMinimap, Replace)
+{
+    ScrollbarMinimap minimap(4);
+    minimap.setRowCount(1);
+
+    minimap.pushBack(ScrollbarHighlight(red));
+    minimap.pushBack(ScrollbarHighlight(red));
+
+    minimap.replace(0, ScrollbarHighlight());
+    EXPECT_TRUE(minimap.at(0).isNull());
+
+    minimap.replace(1, ScrollbarHighlight(blue));
+
+    using Buckets = std::vector<std::tuple<size_t, size_t, int>>;
+    EXPECT_EQ(buckets(minimap), (Buckets{{0, 2, 1}}));
+    minimap.forEachBucket([](size_t, size_t, const auto &bucket) {
+        ASSERT_EQ(bucket.size(), 1);
+        EXPECT_EQ(bucket[0].highlight.getColor(), QColor(Qt::blue));
+    });
+
+    // Out of range indices are ignored
+    minimap.replace(10, ScrollbarHighlight(red));
+    EXPECT_EQ(minimap.size(), 2);
+
+    minimap.clear();
+    EXPECT_EQ(minimap.size(), 0);
+    EXPECT_TRUE(buckets(minimap).empty());
+}
@@ -0,0 +1,260 @@
+#include "providers/seventv/SeventvWebSocket.hpp"
+
+#include "messages/Emote.hpp"
+
+#include <gtest/gtest.h>
+#include <QJsonDocument>
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/server.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+QJsonObject updateMessage(const QString &action, const QString &emoteId,
+                          const QString &name)
+{
+    QJsonObject owner;
+    owner.insert("display_name", "pajlada");
+
+    QJsonObject emote;
+    emote.insert("name", name);
+    emote.insert("visibility", 0);
+    emote.insert("owner", owner);
+
+    QJsonObject payload;
+    payload.insert("channel", "Pajlada");
+    payload.insert("emote_id", emoteId);
+    payload.insert("name", name);
+    payload.insert("action", action);
+    payload.insert("actor", "zneix");
+    payload.insert("emote", emote);
+
+    QJsonObject message;
+    message.insert("action", "update");
+    message.insert(
+        "payload",
+        QString(QJsonDocument(payload).toJson(QJsonDocument::Compact)));
+
+    return message;
+}
+
+SeventvEmoteEvent parse(const QString &action, const QString &emoteId,
+                        const QString &name)
+{
+    auto event =
+        SeventvWebSocket::parseEmoteEvent(updateMessage(action, emoteId, name));
+    EXPECT_TRUE(event);
+
+    return *event;
+}
+
+QJsonObject channelMessage(const QString &action, const QString &channel)
+{
+    QJsonObject message;
+    message.insert("action", action);
+    message.insert("payload", channel);
+
+    return message;
+}
+
+// Stand-in for the 7TV event API that records what the client sends
+class StandInEventApi
+{
+    using Server = websocketpp::server<websocketpp::config::asio>;
+
+public:
+    StandInEventApi()
+    {
+        this->server_.clear_access_channels(websocketpp::log::alevel::all);
+        this->server_.init_asio();
+        this->server_.set_reuse_addr(true);
+
+        this->server_.set_open_handler([this](auto hdl) {
+            std::unique_lock lock(this->mutex_);
+            this->handle_ = hdl;
+        });
+        this->server_.set_message_handler([this](auto, auto message) {
+            {
+                std::unique_lock lock(this->mutex_);
+                this->received_.push_back(
+                    QJsonDocument::fromJson(
+                        QByteArray::fromStdString(message->get_payload()))
+                        .object());
+            }
+            this->condition_.notify_all();
+        });
+
+        // Any free port
+        this->server_.listen(websocketpp::lib::asio::ip::tcp::v4(), 0);
+        this->server_.start_accept();
+
+        websocketpp::lib::asio::error_code ec;
+        this->port_ = this->server_.get_local_endpoint(ec).port();
+
+        this->thread_ = std::thread([this] {
+            this->server_.run();
+        });
+    }
+
+    ~StandInEventApi()
+    {
+        this->server_.stop();
+        this->thread_.join();
+    }
+
+    QString url() const
+    {
+        return QString("ws://127.0.0.1:%1").arg(this->port_);
+    }
+
+    // Waits until the client sent `count` messages and returns all of them
+    std::vector<QJsonObject> waitForMessages(size_t count)
+    {
+        std::unique_lock lock(this->mutex_);
+        this->condition_.wait(lock, [this, count] {
+            return this->received_.size() >= count;
+        });
+
+        return this->received_;
+    }
+
+    void send(const QJsonObject &message)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        websocketpp::lib::error_code ec;
+        this->server_.send(
+            this->handle_,
+            QJsonDocument(message).toJson(QJsonDocument::Compact).toStdString(),
+            websocketpp::frame::opcode::text, ec);
+        EXPECT_FALSE(ec);
+    }
+
+private:
+    Server server_;
+    uint16_t port_ = 0;
+    std::thread thread_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    websocketpp::connection_hdl handle_;
+    std::vector<QJsonObject> received_;
+};
+
+}  // namespace
+
+TEST(SeventvWebSocket, ParseEmoteEvent)
+{
+    auto event = parse("ADD", "60ae958e229664e8667aea38", "forsenE");
+    EXPECT_EQ(event.action, SeventvEmoteEvent::Action::Add);
+    EXPECT_EQ(event.channel, "pajlada");
+    EXPECT_EQ(event.emoteId, "60ae958e229664e8667aea38");
+    EXPECT_EQ(event.name, "forsenE");
+    EXPECT_EQ(event.actor, "zneix");
+    EXPECT_FALSE(event.emote.isEmpty());
+
+    EXPECT_EQ(parse("REMOVE", "1", "a").action,
+              SeventvEmoteEvent::Action::Remove);
+    EXPECT_EQ(parse("UPDATE", "1", "a").action,
+              SeventvEmoteEvent::Action::Update);
+
+    EXPECT_FALSE(SeventvWebSocket::parseEmoteEvent(
+        updateMessage("DELETE_EVERYTHING", "1", "a")));
+    EXPECT_FALSE(
+        SeventvWebSocket::parseEmoteEvent(updateMessage("ADD", "", "a")));
+
+    QJsonObject ping;
+    ping.insert("action", "ping");
+    EXPECT_FALSE(SeventvWebSocket::parseEmoteEvent(ping));
+}
+
+TEST(SeventvWebSocket, ApplyEmoteEvents)
+{
+    EmoteMap emotes;
+
+    auto added = SeventvEmotes::applyEmoteEvent(
+        emotes, parse("ADD", "60ae958e229664e8667aea38", "forsenE"));
+    ASSERT_TRUE(added);
+    ASSERT_EQ(added->size(), 1);
+    ASSERT_EQ(added->count(EmoteName{"forsenE"}), 1);
+    emotes = *added;
+
+    // Adding the same emote again doesn't change anything
+    EXPECT_FALSE(SeventvEmotes::applyEmoteEvent(
+        emotes, parse("ADD", "60ae958e229664e8667aea38", "forsenE")));
+
+    auto renamed = SeventvEmotes::applyEmoteEvent(
+        emotes, parse("UPDATE", "60ae958e229664e8667aea38", "forsenSmile"));
+    ASSERT_TRUE(renamed);
+    ASSERT_EQ(renamed->size(), 1);
+    ASSERT_EQ(renamed->count(EmoteName{"forsenSmile"}), 1);
+    EXPECT_EQ(renamed->at(EmoteName{"forsenSmile"})->name.string,
+              "forsenSmile");
+    emotes = *renamed;
+
+    // Removing an emote that isn't in the set doesn't change anything
+    EXPECT_FALSE(SeventvEmotes::applyEmoteEvent(
+        emotes, parse("REMOVE", "60ae65b29627f9aff4fd8bef", "Clap")));
+
+    auto removed = SeventvEmotes::applyEmoteEvent(
+        emotes, parse("REMOVE", "60ae958e229664e8667aea38", "forsenSmile"));
+    ASSERT_TRUE(removed);
+    EXPECT_TRUE(removed->empty());
+}
+
+TEST(SeventvWebSocket, ReceivesEventsFromLocalServer)
+{
+    StandInEventApi server;
+
+    std::mutex mut;
+    std::vector<SeventvEmoteEvent> events;
+    std::condition_variable eventCondition;
+
+    {
+        SeventvWebSocket client(server.url());
+        client.emoteEvent.connect([&](const auto &event) {
+            {
+                std::unique_lock lck(mut);
+                events.push_back(event);
+            }
+            eventCondition.notify_one();
+        });
+
+        // Joins are counted, and sent once we're connected
+        client.joinChannel("pajlada");
+        client.joinChannel("pajlada");
+        client.start();
+
+        auto received = server.waitForMessages(1);
+        EXPECT_EQ(received[0], channelMessage("join", "pajlada"));
+
+        server.send(
+            updateMessage("ADD", "60ae958e229664e8667aea38", "forsenE"));
+
+        {
+            std::unique_lock lck(mut);
+            eventCondition.wait(lck, [&events] {
+                return !events.empty();
+            });
+        }
+        ASSERT_EQ(events.size(), 1U);
+        EXPECT_EQ(events[0].action, SeventvEmoteEvent::Action::Add);
+        EXPECT_EQ(events[0].channel, "pajlada");
+        EXPECT_EQ(events[0].name, "forsenE");
+
+        client.partChannel("pajlada");
+        client.partChannel("pajlada");
+
+        received = server.waitForMessages(2);
+        ASSERT_EQ(received.size(), 2U);
+        EXPECT_EQ(received[1], channelMessage("part", "pajlada"));
+
+        // Destroying the client stops and joins its thread
+    }
+}
@@ -0,0 +1,169 @@
+#include "widgets/helper/ViewSuspension.hpp"
+
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(int id)
+{
+    auto message = std::make_shared<Message>();
+    message->id = QString::number(id);
+
+    return message;
+}
+
+// A channel and a view showing it, like ChannelView does
+class View
+{
+public:
+    explicit View(size_t limit)
+        : channel(limit)
+    {
+    }
+
+    void append(int id)
+    {
+        auto message = makeMessage(id);
+        MessagePtr deleted;
+        this->channel.pushBack(message, deleted);
+
+        if (!this->suspension.miss(1))
+        {
+            this->layouts.push_back(message);
+        }
+    }
+
+    void resume()
+    {
+        for (auto &message :
+             this->suspension.resume(this->channel.getSnapshot()))
+        {
+            this->layouts.push_back(std::move(message));
+        }
+    }
+
+    std::vector<QString> layoutIds() const
+    {
+        std::vector<QString> ids;
+        for (const auto &layout : this->layouts)
+        {
+            ids.push_back(layout->id);
+        }
+
+        return ids;
+    }
+
+    LimitedQueue<MessagePtr> channel;
+    ViewSuspension suspension;
+    std::vector<MessagePtr> layouts;
+};
+
+std::vector<QString> range(int from, int to)
+{
+    std::vector<QString> ids;
+    for (auto i = from; i < to; i++)
+    {
+        ids.push_back(QString::number(i));
+    }
+
+    return ids;
+}
+
+}  // namespace
+
+TEST(ViewSuspension, CatchesUpOnResume)
+{
+    View view(100);
+
+    // Views start out suspended
+    EXPECT_TRUE(view.suspension.isSuspended());
+    view.resume();
+    EXPECT_FALSE(view.suspension.isSuspended());
+
+    for (int i = 0; i < 5; i++)
+    {
+        view.append(i);
+    }
+    EXPECT_EQ(view.suspension.missedCount(), 0);
+
+    view.suspension.suspend();
+    for (int i = 5; i < 10; i++)
+    {
+        view.append(i);
+    }
+
+    EXPECT_EQ(view.suspension.missedCount(), 5);
+    EXPECT_EQ(view.layoutIds(), range(0, 5));
+
+    view.resume();
+
+    EXPECT_FALSE(view.suspension.isSuspended());
+    EXPECT_EQ(view.suspension.missedCount(), 0);
+    EXPECT_EQ(view.layoutIds(), range(0, 10));
+
+    // New messages are added right away again
+    view.append(10);
+    EXPECT_EQ(view.layoutIds(), range(0, 11));
+}
+
+TEST(ViewSuspension, MissedMoreThanTheChannelKeeps)
+{
+    View view(8);
+    view.resume();
+    view.append(0);
+
+    view.suspension.suspend();
+    for (int i = 1; i < 20; i++)
+    {
+        view.append(i);
+    }
+    EXPECT_EQ(view.suspension.missedCount(), 19);
+
+    // Only the messages that are still in the channel can be added
+    view.resume();
+    EXPECT_EQ(view.layoutIds().size(), 9);
+    EXPECT_EQ(view.layouts.back()->id, "19");
+    EXPECT_EQ(view.layouts[1]->id, "12");
+}
+
+TEST(ViewSuspension, LayoutIndexWhileSuspended)
+{
+    View view(8);
+    view.resume();
+    for (int i = 0; i < 5; i++)
+    {
+        view.append(i);
+    }
+
+    // Without missed messages, channel and view line up
+    EXPECT_EQ(view.suspension.layoutIndex(3, 5, 5), size_t(3));
+
+    view.suspension.suspend();
+    for (int i = 5; i < 10; i++)
+    {
+        view.append(i);
+    }
+
+    // The channel dropped messages 0 and 1 and has 2..9, the view has the
+    // layouts of 0..4
+    auto channelSize = view.channel.getSnapshot().size();
+    ASSERT_EQ(channelSize, 8);
+
+    auto index = view.suspension.layoutIndex(0, view.layouts.size(),
+                                             channelSize);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(view.layouts[*index]->id, "2");
+
+    index = view.suspension.layoutIndex(2, view.layouts.size(), channelSize);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(view.layouts[*index]->id, "4");
+
+    // Missed messages don't have a layout yet
+    EXPECT_FALSE(
+        view.suspension.layoutIndex(3, view.layouts.size(), channelSize));
+}
@@ -0,0 +1,109 @@
+#include "common/WeakRegistry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(WeakRegistry, InternsLiveValues)
+{
+    WeakRegistry<int, int> registry("test registry intern");
+
+    auto a = registry.getOrCreate(1, [] {
+        return std::make_shared<int>(10);
+    });
+    auto b = registry.getOrCreate(1, [] {
+        return std::make_shared<int>(20);
+    });
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(*b, 10);
+    EXPECT_EQ(registry.get(1), a);
+    EXPECT_EQ(registry.get(2), nullptr);
+
+    a.reset();
+    b.reset();
+    EXPECT_EQ(registry.get(1), nullptr);
+
+    auto c = registry.getOrCreate(1, [] {
+        return std::make_shared<int>(30);
+    });
+    EXPECT_EQ(*c, 30);
+}
+
+TEST(WeakRegistry, ReplacesValuesThatCantBeReused)
+{
+    WeakRegistry<int, int> registry("test registry reuse");
+
+    auto a = registry.getOrCreate(1, [] {
+        return std::make_shared<int>(10);
+    });
+    auto b = registry.getOrCreate(
+        1,
+        [] {
+            return std::make_shared<int>(20);
+        },
+        [](int value) {
+            return value == 20;
+        });
+
+    EXPECT_NE(a, b);
+    EXPECT_EQ(registry.get(1), b);
+}
+
+TEST(WeakRegistry, SweepsExpiredEntries)
+{
+    WeakRegistry<int, int> registry("test registry sweep");
+
+    for (int i = 0; i < 10000; i++)
+    {
+        registry.getOrCreate(i, [] {
+            return std::make_shared<int>(0);
+        });
+    }
+
+    // Dead entries are swept while inserting
+    EXPECT_LT(registry.size(), 2000U);
+
+    auto alive = registry.getOrCreate(-1, [] {
+        return std::make_shared<int>(0);
+    });
+    registry.sweep();
+
+    EXPECT_EQ(registry.size(), 1U);
+    EXPECT_EQ(registry.get(-1), alive);
+    EXPECT_EQ(Metrics::gauge("test registry sweep entries").value(), 1);
+}
+
+TEST(WeakRegistry, SharesValuesAcrossThreads)
+{
+    WeakRegistry<int, int> registry("test registry threads");
+    auto first = registry.getOrCreate(0, [] {
+        return std::make_shared<int>(0);
+    });
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++)
+    {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; i++)
+            {
+                auto value = registry.getOrCreate(i % 10, [] {
+                    return std::make_shared<int>(1);
+                });
+                EXPECT_NE(value, nullptr);
+
+                // Alive the whole time, never made again
+                auto zero = registry.get(0);
+                EXPECT_EQ(zero, first);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}